@@ -23,10 +23,10 @@
 #include "KoShapeSavingContext.h"
 
 #include <KoStoreDevice.h>
-#include <QCryptographicHash>
 #include <KoXmlWriter.h>
 
 #include <QMap>
+#include <QHash>
 #include <FlakeDebug.h>
 #include <QMimeDatabase>
 #include <QMimeType>
@@ -42,8 +42,9 @@ public:
     }
 
     QMap<qint64, KoImageDataPrivate*> images;
-    // an extra map to find all dataObjects based on the key of a store.
-    QMap<QByteArray, KoImageDataPrivate*> storeImages;
+    // an extra map to find the image key of all images already read from a store,
+    // so the same href is not read and hashed again during loading.
+    QHash<QByteArray, qint64> storeImageKeys;
 };
 
 KoImageCollection::KoImageCollection(QObject *parent)
@@ -60,7 +61,7 @@ KoImageCollection::~KoImageCollection()
 bool KoImageCollection::completeLoading(KoStore *store)
 {
     Q_UNUSED(store);
-    d->storeImages.clear();
+    d->storeImageKeys.clear();
     return true;
 }
 
@@ -112,6 +113,12 @@ bool KoImageCollection::completeSaving(KoStore *store, KoXmlWriter *manifestWrit
 KoImageData *KoImageCollection::createImageData(const QImage &image)
 {
     Q_ASSERT(!image.isNull());
+    // look up the image before it gets encoded for storage
+    const qint64 key = KoImageDataPrivate::generateKey(image);
+    QMap<qint64, KoImageDataPrivate*>::const_iterator it(d->images.constFind(key));
+    if (it != d->images.constEnd())
+        return new KoImageData(it.value());
+
     KoImageData *data = new KoImageData();
     data->setImage(image);
 
@@ -126,27 +133,32 @@ KoImageData *KoImageCollection::createImageData(const QString &href, KoStore *st
     //
     // The solution we use is to read the data, store it in a QTemporaryFile
     // and read and parse it on demand when the image data is actually needed.
-    // This leads to having two keys, one for the store and one for the
-    // actual image data. We need the latter so if someone else gets the same
-    // image data they can find this data and share (insert warm fuzzy feeling here).
+    // The image data is always identified by the key of its content, which
+    // is hashed while the data is read from the store. So if someone else
+    // gets the same image data, from this store, another document or a paste,
+    // they can find this data and share (insert warm fuzzy feeling here).
+    // To not read the same href twice while loading we remember which
+    // content key it resolved to.
     //
     QByteArray storeKey = (QString::number((qint64) store) + href).toLatin1();
-    if (d->storeImages.contains(storeKey))
-        return new KoImageData(d->storeImages.value(storeKey));
+    QHash<QByteArray, qint64>::const_iterator storeIt(d->storeImageKeys.constFind(storeKey));
+    if (storeIt != d->storeImageKeys.constEnd()) {
+        QMap<qint64, KoImageDataPrivate*>::const_iterator it(d->images.constFind(storeIt.value()));
+        if (it != d->images.constEnd())
+            return new KoImageData(it.value());
+    }
 
     KoImageData *data = new KoImageData();
     data->setImage(href, store);
 
     data = cacheImage(data);
-    d->storeImages.insert(storeKey, data->priv());
+    d->storeImageKeys.insert(storeKey, data->key());
     return data;
 }
 
 KoImageData *KoImageCollection::createImageData(const QByteArray &imageData)
 {
-    QCryptographicHash md5(QCryptographicHash::Md5);
-    md5.addData(imageData);
-    qint64 key = KoImageDataPrivate::generateKey(md5.result());
+    qint64 key = KoImageDataPrivate::generateKey(imageData);
     if (d->images.contains(key))
         return new KoImageData(d->images.value(key));
     KoImageData *data = new KoImageData();
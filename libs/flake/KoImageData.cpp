@@ -32,7 +32,7 @@
 #include <FlakeDebug.h>
 
 #include <QBuffer>
-#include <QCryptographicHash>
+#include <QImageReader>
 #include <QTemporaryFile>
 #include <QPainter>
 
@@ -92,6 +92,15 @@ QPixmap KoImageData::pixmap(const QSize &size)
             return tmp;
         }
         case KoImageDataPrivate::StateNotLoaded:
+            // decode directly at the wanted size, there is no need to
+            // keep the full resolution image around just for the pixmap.
+            if (d->errorCode == Success) {
+                QImage scaled = scaledImage(wantedSize);
+                if (!scaled.isNull()) {
+                    d->pixmap = QPixmap::fromImage(scaled);
+                    break;
+                }
+            }
             image(); // forces load
             // fall through
         case KoImageDataPrivate::StateImageLoaded:
@@ -118,12 +127,85 @@ bool KoImageData::hasCachedPixmap() const
     return d && !d->pixmap.isNull();
 }
 
+QImage KoImageData::scaledImage(const QSize &size) const
+{
+    if (!d || size.isEmpty())
+        return QImage();
+
+    const QImage cached = d->image;
+    if (!cached.isNull())
+        return cached.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    QByteArray format;
+    const QString fileName = imageFileName(&format);
+    return scaledImage(fileName, format, size);
+}
+
+QString KoImageData::imageFileName(QByteArray *format) const
+{
+    if (!d)
+        return QString();
+    if (d->temporaryFile) {
+        if (format)
+            *format = d->suffix.toLatin1();
+        return d->temporaryFile->fileName();
+    }
+    if (d->imageLocation.isLocalFile())
+        return d->imageLocation.toLocalFile();
+    return QString();
+}
+
+QImage KoImageData::scaledImage(const QString &fileName, const QByteArray &format, const QSize &size)
+{
+    if (fileName.isEmpty() || size.isEmpty())
+        return QImage();
+
+    QImageReader reader(fileName, format);
+    // some image formats can not scale while decoding, so check that the
+    // result really has the wanted size.
+    reader.setScaledSize(size);
+    QImage result = reader.read();
+    if (!result.isNull() && result.size() != size)
+        result = result.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    return result;
+}
+
+QSize KoImageData::pixelSize() const
+{
+    if (!d)
+        return QSize();
+    if (!d->image.isNull())
+        return d->image.size();
+    if (d->pixelSize.isValid())
+        return d->pixelSize;
+
+    if (d->dataStoreState == KoImageDataPrivate::StateNotLoaded && d->errorCode == Success) {
+        QImageReader reader;
+        if (d->temporaryFile) {
+            reader.setFileName(d->temporaryFile->fileName());
+            reader.setFormat(d->suffix.toLatin1());
+        } else {
+            reader.setFileName(d->imageLocation.toLocalFile());
+        }
+        d->pixelSize = reader.size();
+        if (d->pixelSize.isValid())
+            return d->pixelSize;
+    }
+    // the image handler can not tell the size without decoding the image
+    return image().size();
+}
+
 QSizeF KoImageData::imageSize()
 {
     if (!d->imageSize.isValid()) {
         // The imagesize have not yet been calculated
+        const bool wasLoaded = hasCachedImage();
         if (image().isNull()) // auto loads the image
             return QSizeF(100, 100);
+        if (!wasLoaded && d->dataStoreState == KoImageDataPrivate::StateImageLoaded) {
+            // we only needed the resolution, don't keep the full image around
+            d->cleanCacheTimer.start();
+        }
 
         if (d->image.dotsPerMeterX())
             d->imageSize.setWidth(DM_TO_POINT(d->image.width() / (qreal) d->image.dotsPerMeterX() * 10.0));
@@ -207,15 +289,10 @@ void KoImageData::setImage(const QImage &image, KoImageCollection *collection)
         } else {
             d->image = image;
             d->dataStoreState = KoImageDataPrivate::StateImageOnly;
-
-            QByteArray ba;
-            QBuffer buffer(&ba);
-            buffer.open(QIODevice::WriteOnly);
-            image.save(&buffer, "PNG"); // use .png for images we get as QImage
-            QCryptographicHash md5(QCryptographicHash::Md5);
-            md5.addData(ba);
-            d->key = KoImageDataPrivate::generateKey(md5.result());
         }
+        // images we get as QImage are identified by their pixels, so the
+        // collection can find them without encoding them first.
+        d->key = KoImageDataPrivate::generateKey(image);
         if (oldKey != 0 && d->collection) {
             d->collection->update(oldKey, d->key);
         }
@@ -254,10 +331,8 @@ void KoImageData::setImage(const QString &url, KoStore *store, KoImageCollection
             if (!lossy && device.size() < MAX_MEMORY_IMAGESIZE) {
                 QByteArray data = device.readAll();
                 if (d->image.loadFromData(data)) {
-                    QCryptographicHash md5(QCryptographicHash::Md5);
-                    md5.addData(data);
                     qint64 oldKey = d->key;
-                    d->key = KoImageDataPrivate::generateKey(md5.result());
+                    d->key = KoImageDataPrivate::generateKey(data);
                     if (oldKey != 0 && d->collection) {
                         d->collection->update(oldKey, d->key);
                     }
@@ -318,10 +393,8 @@ void KoImageData::setImage(const QByteArray &imageData, KoImageCollection *colle
             d->copyToTemporary(buffer);
         }
 
-        QCryptographicHash md5(QCryptographicHash::Md5);
-        md5.addData(imageData);
         qint64 oldKey = d->key;
-        d->key = KoImageDataPrivate::generateKey(md5.result());
+        d->key = KoImageDataPrivate::generateKey(imageData);
         if (oldKey != 0 && d->collection) {
             d->collection->update(oldKey, d->key);
         }
@@ -83,6 +83,38 @@ public:
      */
     QImage image() const;
 
+    /**
+     * Return the image scaled to @p size.
+     *
+     * If the full resolution image is not cached, the image is decoded
+     * directly at the requested size instead of being loaded completely
+     * and scaled afterwards. For formats like JPEG this is done in the DCT
+     * domain and is a lot faster and uses much less memory.
+     * Copies of an image data share their state, so only call this from the
+     * gui thread. Use imageFileName() and the static scaledImage() to decode
+     * on a worker thread.
+     */
+    QImage scaledImage(const QSize &size) const;
+
+    /**
+     * Return the file the encoded image can be read from, or an empty string
+     * if there is none. @p format is set to the format of the file if known.
+     */
+    QString imageFileName(QByteArray *format = 0) const;
+
+    /**
+     * Decode the image file @p fileName of @p format directly at @p size.
+     * This does not access any image data, so it may be called from a worker thread.
+     */
+    static QImage scaledImage(const QString &fileName, const QByteArray &format, const QSize &size);
+
+    /**
+     * The size of the image in pixels.
+     * Unlike image().size() this only reads the image header if the image
+     * is not loaded yet.
+     */
+    QSize pixelSize() const;
+
     /**
      * The size of the image in points
      */
@@ -109,6 +141,9 @@ public:
     /// returns if this is a valid imageData with actual image data present on it.
     bool isValid() const;
 
+    /// returns true only if image() would return immediately with a cached image
+    bool hasCachedImage() const;
+
     /// \internal
     KoImageDataPrivate *priv() { return d; }
 
@@ -122,9 +157,6 @@ private:
     /// returns true only if pixmap() would return immediately with a cached pixmap
     bool hasCachedPixmap() const;
 
-    /// returns true only if image() would return immediately with a cached image
-    bool hasCachedImage() const;
-
     void setImage(const QImage &image, KoImageCollection *collection = 0);
     void setImage(const QByteArray &imageData, KoImageCollection *collection = 0);
 
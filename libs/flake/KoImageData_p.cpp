@@ -26,8 +26,8 @@
 #include <QApplication>
 #include <QTemporaryFile>
 #include <QImageWriter>
-#include <QCryptographicHash>
 #include <QFileInfo>
+#include <QtEndian>
 #include <FlakeDebug.h>
 #include <QBuffer>
 
@@ -116,19 +116,19 @@ void KoImageDataPrivate::copyToTemporary(QIODevice &device)
         errorCode = KoImageData::StorageFailed;
         return;
     }
-    QCryptographicHash md5(QCryptographicHash::Md5);
+    KoImageDataKeyHash hash;
     char buf[8096];
     while (true) {
         device.waitForReadyRead(-1);
         qint64 bytes = device.read(buf, sizeof(buf));
         if (bytes <= 0)
             break; // done!
-        md5.addData(buf, bytes);
+        hash.addData(buf, bytes);
         do {
             bytes -= temporaryFile->write(buf, bytes);
         } while (bytes > 0);
     }
-    key = KoImageDataPrivate::generateKey(md5.result());
+    key = hash.key();
 
     temporaryFile->close();
 
@@ -149,6 +149,7 @@ void KoImageDataPrivate::clear()
     dataStoreState = StateEmpty;
     imageLocation.clear();
     imageSize = QSizeF();
+    pixelSize = QSize();
     key = 0;
     image = QImage();
     pixmap = QPixmap();
@@ -156,9 +157,125 @@ void KoImageDataPrivate::clear()
 
 qint64 KoImageDataPrivate::generateKey(const QByteArray &bytes)
 {
-    qint64 answer = 1;
-    const int max = qMin(8, bytes.count());
-    for (int x = 0; x < max; ++x)
-        answer += bytes[x] << (8 * x);
-    return answer;
+    KoImageDataKeyHash hash;
+    hash.addData(bytes);
+    return hash.key();
+}
+
+qint64 KoImageDataPrivate::generateKey(const QImage &image)
+{
+    KoImageDataKeyHash hash;
+    const qint32 header[3] = { image.width(), image.height(), image.format() };
+    hash.addData(reinterpret_cast<const char*>(header), sizeof(header));
+    // hash line by line, the padding at the end of the scanlines is undefined
+    const int lineLength = (image.width() * image.depth() + 7) / 8;
+    for (int y = 0; y < image.height(); ++y)
+        hash.addData(reinterpret_cast<const char*>(image.constScanLine(y)), lineLength);
+    return hash.key();
+}
+
+namespace {
+const quint64 Prime1 = Q_UINT64_C(11400714785074694791);
+const quint64 Prime2 = Q_UINT64_C(14029467366897019727);
+const quint64 Prime3 = Q_UINT64_C(1609587929392839161);
+const quint64 Prime4 = Q_UINT64_C(9650029242287828579);
+const quint64 Prime5 = Q_UINT64_C(2870177450012600261);
+
+inline quint64 rotateLeft(quint64 value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline quint64 hashRound(quint64 acc, quint64 input)
+{
+    acc += input * Prime2;
+    acc = rotateLeft(acc, 31);
+    return acc * Prime1;
+}
+
+inline quint64 mergeRound(quint64 acc, quint64 value)
+{
+    acc ^= hashRound(0, value);
+    return acc * Prime1 + Prime4;
+}
+}
+
+KoImageDataKeyHash::KoImageDataKeyHash()
+    : m_bufferSize(0),
+    m_totalLength(0)
+{
+    m_acc[0] = Prime1 + Prime2;
+    m_acc[1] = Prime2;
+    m_acc[2] = 0;
+    m_acc[3] = 0 - Prime1;
+}
+
+void KoImageDataKeyHash::processStripe(const uchar *stripe)
+{
+    for (int i = 0; i < 4; ++i)
+        m_acc[i] = hashRound(m_acc[i], qFromLittleEndian<quint64>(stripe + 8 * i));
+}
+
+void KoImageDataKeyHash::addData(const char *data, qint64 length)
+{
+    const uchar *p = reinterpret_cast<const uchar*>(data);
+    m_totalLength += length;
+
+    if (m_bufferSize > 0) {
+        const int fill = qMin<qint64>(32 - m_bufferSize, length);
+        memcpy(m_buffer + m_bufferSize, p, fill);
+        m_bufferSize += fill;
+        p += fill;
+        length -= fill;
+        if (m_bufferSize < 32)
+            return;
+        processStripe(m_buffer);
+        m_bufferSize = 0;
+    }
+    for (; length >= 32; p += 32, length -= 32)
+        processStripe(p);
+    if (length > 0) {
+        memcpy(m_buffer, p, length);
+        m_bufferSize = length;
+    }
+}
+
+qint64 KoImageDataKeyHash::key() const
+{
+    quint64 h;
+    if (m_totalLength >= 32) {
+        h = rotateLeft(m_acc[0], 1) + rotateLeft(m_acc[1], 7)
+            + rotateLeft(m_acc[2], 12) + rotateLeft(m_acc[3], 18);
+        for (int i = 0; i < 4; ++i)
+            h = mergeRound(h, m_acc[i]);
+    } else {
+        h = Prime5;
+    }
+    h += m_totalLength;
+
+    const uchar *p = m_buffer;
+    int remaining = m_bufferSize;
+    for (; remaining >= 8; p += 8, remaining -= 8) {
+        h ^= hashRound(0, qFromLittleEndian<quint64>(p));
+        h = rotateLeft(h, 27) * Prime1 + Prime4;
+    }
+    if (remaining >= 4) {
+        h ^= quint64(qFromLittleEndian<quint32>(p)) * Prime1;
+        h = rotateLeft(h, 23) * Prime2 + Prime3;
+        p += 4;
+        remaining -= 4;
+    }
+    for (; remaining > 0; ++p, --remaining) {
+        h ^= (*p) * Prime5;
+        h = rotateLeft(h, 11) * Prime1;
+    }
+
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    h *= Prime3;
+    h ^= h >> 32;
+
+    // 0 is used as 'no key'
+    return h ? qint64(h) : 1;
 }
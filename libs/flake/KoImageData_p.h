@@ -35,6 +35,33 @@
 class KoImageCollection;
 class QTemporaryFile;
 
+/**
+ * Streaming 64 bit content hash (xxHash64) used to generate the keys of
+ * the image data. The key identifies the image bytes in the
+ * KoImageCollection, so identical images share their KoImageDataPrivate.
+ * It is a lot cheaper than a cryptographic hash and can be fed while the
+ * data is read from a store or device.
+ */
+class KoImageDataKeyHash
+{
+public:
+    KoImageDataKeyHash();
+
+    void addData(const char *data, qint64 length);
+    void addData(const QByteArray &data) { addData(data.constData(), data.size()); }
+
+    /// @return the key for all data added so far, never 0
+    qint64 key() const;
+
+private:
+    void processStripe(const uchar *stripe);
+
+    quint64 m_acc[4];
+    uchar m_buffer[32];
+    int m_bufferSize;
+    quint64 m_totalLength;
+};
+
 class KoImageDataPrivate
 {
 public:
@@ -60,7 +87,10 @@ public:
 
     void clear();
 
+    /// @return the key of the image bytes @p bytes
     static qint64 generateKey(const QByteArray &bytes);
+    /// @return the key of the pixel data of @p image
+    static qint64 generateKey(const QImage &image);
 
     enum DataStoreState {
         StateEmpty,     ///< No image data, either as url or as QImage
@@ -72,6 +102,7 @@ public:
     KoImageCollection *collection;
     KoImageData::ErrorCode errorCode;
     QSizeF imageSize;
+    QSize pixelSize;
     qint64 key;
     QString suffix; // the suffix of the picture e.g. png  TODO use a QByteArray ?
     QTimer cleanCacheTimer;
@@ -92,6 +92,8 @@ KoPathPoint &KoPathPoint::operator=(const KoPathPoint &rhs)
     d->properties = rhs.d->properties;
     d->activeControlPoint1 = rhs.d->activeControlPoint1;
     d->activeControlPoint2 = rhs.d->activeControlPoint2;
+    if (d->shape)
+        d->shape->notifyPointsChanged();
 
     return (*this);
 }
@@ -116,8 +118,10 @@ bool KoPathPoint::operator == (const KoPathPoint &rhs) const
 void KoPathPoint::setPoint(const QPointF &point)
 {
     d->point = point;
-    if (d->shape)
+    if (d->shape) {
+        d->shape->notifyPointsChanged();
         d->shape->notifyChanged();
+    }
 }
 
 void KoPathPoint::setControlPoint1(const QPointF &point)
@@ -126,8 +130,10 @@ void KoPathPoint::setControlPoint1(const QPointF &point)
 
     d->controlPoint1 = point;
     d->activeControlPoint1 = true;
-    if (d->shape)
+    if (d->shape) {
+        d->shape->notifyPointsChanged();
         d->shape->notifyChanged();
+    }
 }
 
 void KoPathPoint::setControlPoint2(const QPointF &point)
@@ -136,8 +142,10 @@ void KoPathPoint::setControlPoint2(const QPointF &point)
 
     d->controlPoint2 = point;
     d->activeControlPoint2 = true;
-    if (d->shape)
+    if (d->shape) {
+        d->shape->notifyPointsChanged();
         d->shape->notifyChanged();
+    }
 }
 
 void KoPathPoint::removeControlPoint1()
@@ -145,8 +153,10 @@ void KoPathPoint::removeControlPoint1()
     d->activeControlPoint1 = false;
     d->properties &= ~IsSmooth;
     d->properties &= ~IsSymmetric;
-    if (d->shape)
+    if (d->shape) {
+        d->shape->notifyPointsChanged();
         d->shape->notifyChanged();
+    }
 }
 
 void KoPathPoint::removeControlPoint2()
@@ -154,8 +164,10 @@ void KoPathPoint::removeControlPoint2()
     d->activeControlPoint2 = false;
     d->properties &= ~IsSmooth;
     d->properties &= ~IsSymmetric;
-    if (d->shape)
+    if (d->shape) {
+        d->shape->notifyPointsChanged();
         d->shape->notifyChanged();
+    }
 }
 
 void KoPathPoint::setProperties(PointProperties properties)
@@ -171,8 +183,10 @@ void KoPathPoint::setProperties(PointProperties properties)
         d->properties &= ~IsSymmetric;
     }
 
-    if (d->shape)
+    if (d->shape) {
+        d->shape->notifyPointsChanged();
         d->shape->notifyChanged();
+    }
 }
 
 void KoPathPoint::setProperty(PointProperty property)
@@ -199,6 +213,8 @@ void KoPathPoint::setProperty(PointProperty property)
         d->properties &= ~IsSymmetric;
         d->properties &= ~IsSmooth;
     }
+    if (d->shape)
+        d->shape->notifyPointsChanged();
 }
 
 void KoPathPoint::unsetProperty(PointProperty property)
@@ -225,6 +241,8 @@ void KoPathPoint::unsetProperty(PointProperty property)
     default: return;
     }
     d->properties &= ~property;
+    if (d->shape)
+        d->shape->notifyPointsChanged();
 }
 
 bool KoPathPoint::activeControlPoint1() const
@@ -251,8 +269,10 @@ void KoPathPoint::map(const QTransform &matrix)
     d->controlPoint1 = matrix.map(d->controlPoint1);
     d->controlPoint2 = matrix.map(d->controlPoint2);
 
-    if (d->shape)
+    if (d->shape) {
+        d->shape->notifyPointsChanged();
         d->shape->notifyChanged();
+    }
 }
 
 void KoPathPoint::paint(QPainter &painter, int handleRadius, PointTypes types, bool active)
@@ -337,6 +357,8 @@ void KoPathPoint::reverse()
     newProps |= d->properties & StopSubpath;
     newProps |= d->properties & CloseSubpath;
     d->properties = newProps;
+    if (d->shape)
+        d->shape->notifyPointsChanged();
 }
 
 bool KoPathPoint::isSmooth(KoPathPoint * prev, KoPathPoint * next) const
@@ -61,7 +61,12 @@ KoPathShapePrivate::KoPathShapePrivate(KoPathShape *q)
     : KoTosContainerPrivate(q),
     fillRule(Qt::OddEvenFill),
     startMarker(KoMarkerData::MarkerStart),
-    endMarker(KoMarkerData::MarkerEnd)
+    endMarker(KoMarkerData::MarkerEnd),
+    pointsVersion(1),
+    outlineVersion(0),
+    strokeVersion(0),
+    strokeBoundsVersion(0),
+    strokeBoundsWidth(0)
 {
 }
 
@@ -367,6 +372,7 @@ void KoPathShape::clear()
         delete subpath;
     }
     m_subpaths.clear();
+    notifyPointsChanged();
 }
 
 void KoPathShape::paint(QPainter &painter, const KoViewConverter &converter, KoShapePaintingContext &paintContext)
@@ -447,8 +453,19 @@ void KoPathShape::paintPoints(QPainter &painter, const KoViewConverter &converte
 
 QPainterPath KoPathShape::outline() const
 {
+    Q_D(const KoPathShape);
+    if (d->outlineVersion != d->pointsVersion) {
+        d->cachedOutline = d->createOutline();
+        d->outlineVersion = d->pointsVersion;
+    }
+    return d->cachedOutline;
+}
+
+QPainterPath KoPathShapePrivate::createOutline() const
+{
+    Q_Q(const KoPathShape);
     QPainterPath path;
-    foreach(KoSubpath * subpath, m_subpaths) {
+    foreach(KoSubpath * subpath, q->m_subpaths) {
         KoPathPoint * lastPoint = subpath->first();
         bool activeCP = false;
         foreach(KoPathPoint * currPoint, *subpath) {
@@ -510,15 +527,22 @@ QPainterPath KoPathShape::outline() const
 
 QRectF KoPathShape::boundingRect() const
 {
+    Q_D(const KoPathShape);
     QTransform transform = absoluteTransformation(0);
     // calculate the bounding rect of the transformed outline
-    QRectF bb;
     KoShapeStroke *lineBorder = dynamic_cast<KoShapeStroke*>(stroke());
     QPen pen;
     if (lineBorder) {
         pen.setWidthF(lineBorder->lineWidth());
     }
-    bb = transform.map(pathStroke(pen)).boundingRect();
+    if (d->strokeBoundsVersion != d->pointsVersion || d->strokeBoundsWidth != pen.widthF()
+            || d->strokeBoundsTransform != transform) {
+        d->strokeBounds = transform.map(pathStroke(pen)).boundingRect();
+        d->strokeBoundsWidth = pen.widthF();
+        d->strokeBoundsTransform = transform;
+        d->strokeBoundsVersion = d->pointsVersion;
+    }
+    QRectF bb = d->strokeBounds;
 
     if (stroke()) {
         KoInsets inset;
@@ -562,6 +586,12 @@ void KoPathShape::setSize(const QSizeF &newSize)
     d->map(matrix);
 }
 
+void KoPathShape::notifyPointsChanged()
+{
+    Q_D(KoPathShape);
+    ++d->pointsVersion;
+}
+
 QTransform KoPathShape::resizeMatrix(const QSizeF & newSize) const
 {
     QSizeF oldSize = size();
@@ -589,6 +619,7 @@ KoPathPoint * KoPathShape::moveTo(const QPointF &p)
     KoSubpath * path = new KoSubpath;
     path->push_back(point);
     m_subpaths.push_back(path);
+    notifyPointsChanged();
     return point;
 }
 
@@ -602,6 +633,7 @@ KoPathPoint * KoPathShape::lineTo(const QPointF &p)
     KoPathPoint * lastPoint = m_subpaths.last()->last();
     d->updateLast(&lastPoint);
     m_subpaths.last()->push_back(point);
+    notifyPointsChanged();
     return point;
 }
 
@@ -617,6 +649,7 @@ KoPathPoint * KoPathShape::curveTo(const QPointF &c1, const QPointF &c2, const Q
     KoPathPoint * point = new KoPathPoint(this, p, KoPathPoint::StopSubpath);
     point->setControlPoint1(c2);
     m_subpaths.last()->push_back(point);
+    notifyPointsChanged();
     return point;
 }
 
@@ -631,6 +664,7 @@ KoPathPoint * KoPathShape::curveTo(const QPointF &c, const QPointF &p)
     lastPoint->setControlPoint2(c);
     KoPathPoint * point = new KoPathPoint(this, p, KoPathPoint::StopSubpath);
     m_subpaths.last()->push_back(point);
+    notifyPointsChanged();
 
     return point;
 }
@@ -956,6 +990,7 @@ bool KoPathShape::insertPoint(KoPathPoint* point, const KoPathPointIndex &pointI
     point->setProperties(properties);
     point->setParent(this);
     subpath->insert(pointIndex.second , point);
+    notifyPointsChanged();
     return true;
 }
 
@@ -968,6 +1003,7 @@ KoPathPoint * KoPathShape::removePoint(const KoPathPointIndex &pointIndex)
         return 0;
 
     KoPathPoint * point = subpath->takeAt(pointIndex.second);
+    notifyPointsChanged();
 
     //don't do anything (not even crash), if there was only one point
     if (pointCount()==0) {
@@ -1019,6 +1055,7 @@ bool KoPathShape::breakAfter(const KoPathPointIndex &pointIndex)
 
     // insert the new subpath after the broken one
     m_subpaths.insert(pointIndex.first + 1, newSubpath);
+    notifyPointsChanged();
 
     return true;
 }
@@ -1047,6 +1084,7 @@ bool KoPathShape::join(int subpathIndex)
 
     // delete it as it is no longer possible to use it
     delete nextSubpath;
+    notifyPointsChanged();
 
     return true;
 }
@@ -1064,6 +1102,7 @@ bool KoPathShape::moveSubpath(int oldSubpathIndex, int newSubpathIndex)
 
     m_subpaths.removeAt(oldSubpathIndex);
     m_subpaths.insert(newSubpathIndex, subpath);
+    notifyPointsChanged();
 
     return true;
 }
@@ -1091,6 +1130,7 @@ KoPathPointIndex KoPathShape::openSubpath(const KoPathPointIndex &pointIndex)
     subpath->first()->setProperty(KoPathPoint::StartSubpath);
     // make the last point an end node
     subpath->last()->setProperty(KoPathPoint::StopSubpath);
+    notifyPointsChanged();
 
     return pathPointIndex(oldStartPoint);
 }
@@ -1118,6 +1158,7 @@ KoPathPointIndex KoPathShape::closeSubpath(const KoPathPointIndex &pointIndex)
     subpath->last()->setProperty(KoPathPoint::StopSubpath);
 
     d->closeSubpath(subpath);
+    notifyPointsChanged();
     return pathPointIndex(oldStartPoint);
 }
 
@@ -1153,6 +1194,7 @@ bool KoPathShape::reverseSubpath(int subpathIndex)
     }
     first->setProperties(firstProps);
     last->setProperties(lastProps);
+    notifyPointsChanged();
 
     return true;
 }
@@ -1162,8 +1204,10 @@ KoSubpath * KoPathShape::removeSubpath(int subpathIndex)
     Q_D(KoPathShape);
     KoSubpath *subpath = d->subPath(subpathIndex);
 
-    if (subpath != 0)
+    if (subpath != 0) {
         m_subpaths.removeAt(subpathIndex);
+        notifyPointsChanged();
+    }
 
     return subpath;
 }
@@ -1174,6 +1218,7 @@ bool KoPathShape::addSubpath(KoSubpath * subpath, int subpathIndex)
         return false;
 
     m_subpaths.insert(subpathIndex, subpath);
+    notifyPointsChanged();
 
     return true;
 }
@@ -1198,6 +1243,7 @@ bool KoPathShape::combine(KoPathShape *path)
         }
         m_subpaths.append(newSubpath);
     }
+    notifyPointsChanged();
     normalize();
     return true;
 }
@@ -1224,6 +1270,7 @@ bool KoPathShape::separate(QList<KoPathShape*> & separatedPaths)
             newSubpath->append(newPoint);
         }
         shape->m_subpaths.append(newSubpath);
+        shape->notifyPointsChanged();
         shape->normalize();
         separatedPaths.append(shape);
     }
@@ -1232,15 +1279,18 @@ bool KoPathShape::separate(QList<KoPathShape*> & separatedPaths)
 
 void KoPathShapePrivate::closeSubpath(KoSubpath *subpath)
 {
+    Q_Q(KoPathShape);
     if (! subpath)
         return;
 
     subpath->last()->setProperty(KoPathPoint::CloseSubpath);
     subpath->first()->setProperty(KoPathPoint::CloseSubpath);
+    q->notifyPointsChanged();
 }
 
 void KoPathShapePrivate::closeMergeSubpath(KoSubpath *subpath)
 {
+    Q_Q(KoPathShape);
     if (! subpath || subpath->size() < 2)
         return;
 
@@ -1261,6 +1311,7 @@ void KoPathShapePrivate::closeMergeSubpath(KoSubpath *subpath)
         lastPoint = subpath->last();
         lastPoint->setProperty(KoPathPoint::StopSubpath);
         lastPoint->setProperty(KoPathPoint::CloseSubpath);
+        q->notifyPointsChanged();
     } else {
         closeSubpath(subpath);
     }
@@ -1511,6 +1562,7 @@ void KoPathShape::setMarker(const KoMarkerData &markerData)
     else {
         d->endMarker = markerData;
     }
+    notifyPointsChanged();
 }
 
 void KoPathShape::setMarker(KoMarker *marker, KoMarkerData::MarkerPosition position)
@@ -1529,6 +1581,7 @@ void KoPathShape::setMarker(KoMarker *marker, KoMarkerData::MarkerPosition posit
         }
         d->endMarker.setMarker(marker);
     }
+    notifyPointsChanged();
 }
 
 KoMarker *KoPathShape::marker(KoMarkerData::MarkerPosition position) const
@@ -1557,9 +1610,15 @@ KoMarkerData KoPathShape::markerData(KoMarkerData::MarkerPosition position) cons
 
 QPainterPath KoPathShape::pathStroke(const QPen &pen) const
 {
+    Q_D(const KoPathShape);
     if (m_subpaths.isEmpty()) {
         return QPainterPath();
     }
+    if (d->strokeVersion == d->pointsVersion && d->strokePen == pen) {
+        return d->cachedStroke;
+    }
+    const uint version = d->pointsVersion;
+
     QPainterPath pathOutline;
 
     QPainterPathStroker stroker;
@@ -1718,7 +1777,8 @@ QPainterPath KoPathShape::pathStroke(const QPen &pen) const
         firstSubpath->last() = lastSegments.first.second();
     }
 
-    QPainterPath path = stroker.createStroke(outline());
+    // the cached outline does not know about the replaced points
+    QPainterPath path = stroker.createStroke(firstPoint || lastPoint ? d->createOutline() : outline());
 
     if (firstPoint) {
         firstSubpath->first() = firstPoint;
@@ -1736,5 +1796,12 @@ QPainterPath KoPathShape::pathStroke(const QPen &pen) const
     pathOutline.addPath(path);
     pathOutline.setFillRule(Qt::WindingFill);
 
+    // the split points of the markers have no parent shape, so adjusting them
+    // and swapping them in does not invalidate the cached outline and bounds
+    Q_ASSERT(d->pointsVersion == version);
+    d->cachedStroke = pathOutline;
+    d->strokePen = pen;
+    d->strokeVersion = version;
+
     return pathOutline;
 }
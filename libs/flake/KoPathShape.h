@@ -108,6 +108,15 @@ public:
      * @see resizeMatrix()
      */
     virtual void setSize(const QSizeF &size);
+
+    /**
+     * @brief Invalidates the cached outline and stroke of the path
+     *
+     * The outline is only rebuilt after the points changed. KoPathPoint and the
+     * editing methods of this class call this automatically, derived classes
+     * that modify m_subpaths directly have to call it themselves.
+     */
+    void notifyPointsChanged();
     /// reimplemented
     virtual bool hitTest(const QPointF &position) const;
 
@@ -22,6 +22,9 @@
 #include "KoTosContainer_p.h"
 #include "KoMarkerData.h"
 
+#include <QPainterPath>
+#include <QPen>
+
 class KoPathShapePrivate : public KoTosContainerPrivate
 {
 public:
@@ -76,6 +79,9 @@ public:
      * @return subPath on success, or 0 when subpathIndex is out of bounds
      */
     KoSubpath *subPath(int subpathIndex) const;
+
+    /// Builds the outline from the subpaths, bypassing the cache
+    QPainterPath createOutline() const;
 #ifndef NDEBUG
     /// \internal
     void paintDebug(QPainter &painter);
@@ -87,6 +93,19 @@ public:
 
     Qt::FillRule fillRule;
 
+    /// incremented on every change of the points, the caches below are valid
+    /// as long as their version matches
+    uint pointsVersion;
+    mutable uint outlineVersion;
+    mutable QPainterPath cachedOutline;
+    mutable uint strokeVersion;
+    mutable QPen strokePen;
+    mutable QPainterPath cachedStroke;
+    mutable uint strokeBoundsVersion;
+    mutable qreal strokeBoundsWidth;
+    mutable QTransform strokeBoundsTransform;
+    mutable QRectF strokeBounds;
+
     Q_DECLARE_PUBLIC(KoPathShape)
 
     KoMarkerData startMarker;
@@ -45,8 +45,54 @@
 
 #include <QPainter>
 #include <QTimer>
+#include <QCache>
 #include <FlakeDebug.h>
 
+/// the maximum amount of bytes used for caching the filtered images of shapes
+#define MAX_FILTER_EFFECT_CACHE_SIZE (64 * 1024 * 1024)
+
+namespace {
+
+/**
+ * The result of applying the filter effects of a shape, together with the
+ * parameters it was rendered with. As long as the shape does not change and
+ * is painted with the same zoom, the filter effects do not need to be run again.
+ */
+struct FilterEffectCacheEntry
+{
+    QImage image;
+    QRectF boundingRect; ///< document bounding rect of the shape when it was rendered
+    QRectF clipRegion;   ///< clip region in view coordinates relative to the shape
+    qreal zoomX;
+    qreal zoomY;
+    bool antialiasing;
+};
+
+struct FilterEffectCacheKey
+{
+    FilterEffectCacheKey(const KoShapeManager *manager, const KoShape *shape)
+        : manager(manager), shape(shape) {}
+
+    bool operator==(const FilterEffectCacheKey &other) const
+    {
+        return manager == other.manager && shape == other.shape;
+    }
+
+    const KoShapeManager *manager;
+    const KoShape *shape;
+};
+
+inline uint qHash(const FilterEffectCacheKey &key)
+{
+    return ::qHash(key.shape) ^ ::qHash(key.manager);
+}
+
+// the filtered images of all shape managers share one budget
+typedef QCache<FilterEffectCacheKey, FilterEffectCacheEntry> FilterEffectCache;
+Q_GLOBAL_STATIC_WITH_ARGS(FilterEffectCache, s_filterEffectCache, (MAX_FILTER_EFFECT_CACHE_SIZE))
+
+}
+
 
 void KoShapeManager::Private::updateTree()
 {
@@ -84,6 +130,39 @@ void KoShapeManager::Private::updateTree()
     }
 }
 
+void KoShapeManager::Private::invalidateFilterEffectCache(const QRectF &rect)
+{
+    if (s_filterEffectCache.isDestroyed() || s_filterEffectCache->isEmpty())
+        return;
+    // the tree may still have the old position of the shapes waiting in aggregate4update,
+    // their entries were already removed in notifyShapeChanged
+    foreach (KoShape *shape, tree.intersects(rect)) {
+        invalidateFilterEffectCache(shape);
+    }
+}
+
+void KoShapeManager::Private::invalidateFilterEffectCache(const KoShape *shape)
+{
+    // shapes may be deleted after the cache at exit
+    if (s_filterEffectCache.isDestroyed())
+        return;
+    while (shape && !s_filterEffectCache->isEmpty()) {
+        s_filterEffectCache->remove(FilterEffectCacheKey(q, shape));
+        shape = shape->parent();
+    }
+}
+
+void KoShapeManager::Private::clearFilterEffectCache()
+{
+    if (s_filterEffectCache.isDestroyed())
+        return;
+
+    foreach (const FilterEffectCacheKey &key, s_filterEffectCache->keys()) {
+        if (key.manager == q)
+            s_filterEffectCache->remove(key);
+    }
+}
+
 void KoShapeManager::Private::paintGroup(KoShapeGroup *group, QPainter &painter, const KoViewConverter &converter, KoShapePaintingContext &paintContext)
 {
     QList<KoShape*> shapes = group->shapes();
@@ -126,6 +205,7 @@ KoShapeManager::~KoShapeManager()
     foreach(KoShape *shape, d->additionalShapes) {
         shape->priv()->removeShapeManager(this);
     }
+    d->clearFilterEffectCache();
     delete d;
 }
 
@@ -140,6 +220,7 @@ void KoShapeManager::setShapes(const QList<KoShape *> &shapes, Repaint repaint)
     d->aggregate4update.clear();
     d->tree.clear();
     d->shapes.clear();
+    d->clearFilterEffectCache();
     foreach(KoShape *shape, shapes) {
         addShape(shape, repaint);
     }
@@ -196,6 +277,7 @@ void KoShapeManager::remove(KoShape *shape)
     d->aggregate4update.remove(shape);
     d->tree.remove(shape);
     d->shapes.removeAll(shape);
+    d->invalidateFilterEffectCache(shape);
 
     // remove the children of a KoShapeContainer
     KoShapeContainer *container = dynamic_cast<KoShapeContainer*>(shape);
@@ -325,6 +407,21 @@ void KoShapeManager::paintShape(KoShape *shape, QPainter &painter, const KoViewC
         // determine the offset of the clipping rect from the shapes origin
         QPointF clippingOffset = zoomedClipRegion.topLeft();
 
+        // Reuse the filtered image of the last paint if neither the shape nor the zoom changed
+        qreal zoomX, zoomY;
+        converter.zoom(&zoomX, &zoomY);
+        const bool antialiasing = painter.testRenderHint(QPainter::Antialiasing);
+        FilterEffectCacheEntry *cacheEntry = s_filterEffectCache->object(FilterEffectCacheKey(this, shape));
+        if (cacheEntry && cacheEntry->zoomX == zoomX && cacheEntry->zoomY == zoomY
+                && cacheEntry->antialiasing == antialiasing
+                && cacheEntry->clipRegion == zoomedClipRegion
+                && cacheEntry->boundingRect == shape->boundingRect()) {
+            painter.save();
+            painter.drawImage(clippingOffset, cacheEntry->image);
+            painter.restore();
+            return;
+        }
+
         // Initialize the buffer image
         QImage sourceGraphic(zoomedClipRegion.size().toSize(), QImage::Format_ARGB32_Premultiplied);
         sourceGraphic.fill(qRgba(0,0,0,0));
@@ -419,10 +516,20 @@ void KoShapeManager::paintShape(KoShape *shape, QPainter &painter, const KoViewC
         }
 
         KoFilterEffect *lastEffect = filterEffects.last();
+        const QImage filteredImage = imageBuffers.value(lastEffect->output());
+
+        cacheEntry = new FilterEffectCacheEntry;
+        cacheEntry->image = filteredImage;
+        cacheEntry->boundingRect = shape->boundingRect();
+        cacheEntry->clipRegion = zoomedClipRegion;
+        cacheEntry->zoomX = zoomX;
+        cacheEntry->zoomY = zoomY;
+        cacheEntry->antialiasing = antialiasing;
+        s_filterEffectCache->insert(FilterEffectCacheKey(this, shape), cacheEntry, filteredImage.byteCount());
 
         // Paint the result
         painter.save();
-        painter.drawImage(clippingOffset, imageBuffers.value(lastEffect->output()));
+        painter.drawImage(clippingOffset, filteredImage);
         painter.restore();
     }
 }
@@ -499,6 +606,10 @@ QList<KoShape *> KoShapeManager::shapesAt(const QRectF &rect, bool omitHiddenSha
 
 void KoShapeManager::update(QRectF &rect, const KoShape *shape, bool selectionHandles)
 {
+    // anything that asks for a repaint might have changed the look of the filtered shapes there
+    if (shape)
+        d->invalidateFilterEffectCache(shape);
+    d->invalidateFilterEffectCache(rect);
     d->canvas->updateCanvas(rect);
     if (selectionHandles && d->selection->isSelected(shape)) {
         if (d->canvas->toolProxy())
@@ -513,6 +624,7 @@ void KoShapeManager::notifyShapeChanged(KoShape *shape)
         return;
     }
     const bool wasEmpty = d->aggregate4update.isEmpty();
+    d->invalidateFilterEffectCache(shape);
     d->aggregate4update.insert(shape);
     d->shapeIndexesBeforeUpdate.insert(shape, shape->zIndex());
 
@@ -77,6 +77,18 @@ public:
      */
     void paintGroup(KoShapeGroup *group, QPainter &painter, const KoViewConverter &converter, KoShapePaintingContext &paintContext);
 
+    /**
+     * Removes the cached filter effect results of all shapes in the tree that
+     * intersect with @p rect, which is in document coordinates, and of their ancestors.
+     */
+    void invalidateFilterEffectCache(const QRectF &rect);
+
+    /// Removes the cached filter effect result of @p shape and all its ancestors.
+    void invalidateFilterEffectCache(const KoShape *shape);
+
+    /// Removes all the cached filter effect results of this shape manager.
+    void clearFilterEffectCache();
+
     class DetectCollision
     {
     public:
@@ -0,0 +1,227 @@
+/*
+ *  This file is part of Calligra tests
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "TestFilterEffectCache.h"
+
+#include "KoShapeManager.h"
+#include "KoShapePaintingContext.h"
+#include "KoFilterEffect.h"
+#include "KoFilterEffectStack.h"
+
+#include <MockShapes.h>
+
+#include <QPainter>
+#include <QTest>
+
+class MockFilterEffect : public KoFilterEffect
+{
+public:
+    MockFilterEffect() : KoFilterEffect("mock", "Mock"), processedCount(0) {}
+    QImage processImage(const QImage &image, const KoFilterEffectRenderContext &) const {
+        processedCount++;
+        return image;
+    }
+    mutable int processedCount;
+};
+
+/// Creates a shape with a filter effect at @p position, the effect is owned by the shape
+static MockShape *createFilteredShape(const QPointF &position, const QSizeF &size, MockFilterEffect **effect)
+{
+    MockShape *shape = new MockShape();
+    shape->setPosition(position);
+    shape->setSize(size);
+    *effect = new MockFilterEffect();
+    KoFilterEffectStack *stack = new KoFilterEffectStack();
+    stack->appendFilterEffect(*effect);
+    shape->setFilterEffectStack(stack);
+    return shape;
+}
+
+static void paint(KoShapeManager &manager, const KoViewConverter &converter)
+{
+    QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    manager.paint(painter, converter, false);
+}
+
+static void paintShape(KoShapeManager &manager, KoShape *shape, const KoViewConverter &converter)
+{
+    QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    KoShapePaintingContext paintContext;
+    manager.paintShape(shape, painter, converter, paintContext);
+}
+
+void TestFilterEffectCache::testCacheHit()
+{
+    MockFilterEffect *effect;
+    MockShape *shape = createFilteredShape(QPointF(), QSizeF(50, 50), &effect);
+
+    MockCanvas canvas;
+    KoShapeManager manager(&canvas);
+    manager.addShape(shape);
+    KoViewConverter converter;
+
+    paint(manager, converter);
+    QCOMPARE(effect->processedCount, 1);
+    QCOMPARE(shape->paintedCount, 1);
+
+    // nothing changed, the filtered image is reused
+    paint(manager, converter);
+    QCOMPARE(effect->processedCount, 1);
+    QCOMPARE(shape->paintedCount, 1);
+
+    // another zoom needs another image
+    converter.setZoom(2.0);
+    paint(manager, converter);
+    QCOMPARE(effect->processedCount, 2);
+
+    // every manager has its own entries
+    MockCanvas otherCanvas;
+    KoShapeManager otherManager(&otherCanvas);
+    otherManager.addShape(shape, KoShapeManager::AddWithoutRepaint);
+    paint(otherManager, converter);
+    QCOMPARE(effect->processedCount, 3);
+    paint(manager, converter);
+    QCOMPARE(effect->processedCount, 3);
+
+    delete shape;
+}
+
+void TestFilterEffectCache::testInvalidateShape()
+{
+    MockFilterEffect *effect;
+    MockShape *shape = createFilteredShape(QPointF(), QSizeF(50, 50), &effect);
+    MockFilterEffect *otherEffect;
+    MockShape *otherShape = createFilteredShape(QPointF(500, 500), QSizeF(50, 50), &otherEffect);
+    MockContainer *container = new MockContainer();
+    container->addShape(shape);
+    container->setClipped(shape, false);
+
+    MockCanvas canvas;
+    KoShapeManager manager(&canvas);
+    manager.addShape(container);
+    manager.addShape(otherShape);
+    KoViewConverter converter;
+
+    paint(manager, converter);
+    QCOMPARE(effect->processedCount, 1);
+    QCOMPARE(otherEffect->processedCount, 1);
+
+    // a repaint request of a shape drops its entry only
+    shape->update();
+    paint(manager, converter);
+    QCOMPARE(effect->processedCount, 2);
+    QCOMPARE(otherEffect->processedCount, 1);
+
+    // so does a change of the shape that keeps its bounding rect
+    shape->notifyChanged();
+    paint(manager, converter);
+    QCOMPARE(effect->processedCount, 3);
+    QCOMPARE(otherEffect->processedCount, 1);
+
+    // a change of the container changes its children
+    container->notifyChanged();
+    paint(manager, converter);
+    QCOMPARE(effect->processedCount, 4);
+    QCOMPARE(otherEffect->processedCount, 1);
+
+    // a removed shape can still be painted by the manager, but its old entry is gone
+    manager.remove(otherShape);
+    paintShape(manager, otherShape, converter);
+    QCOMPARE(otherEffect->processedCount, 2);
+
+    delete otherShape;
+    delete container;
+}
+
+void TestFilterEffectCache::testInvalidateRect()
+{
+    MockFilterEffect *effect;
+    MockShape *shape = createFilteredShape(QPointF(), QSizeF(50, 50), &effect);
+    MockFilterEffect *otherEffect;
+    MockShape *otherShape = createFilteredShape(QPointF(500, 500), QSizeF(50, 50), &otherEffect);
+
+    MockCanvas canvas;
+    KoShapeManager manager(&canvas);
+    manager.addShape(shape);
+    manager.addShape(otherShape);
+    KoViewConverter converter;
+
+    paint(manager, converter);
+
+    // an area overlapping the first shape, e.g. another shape painted on top of it
+    QRectF rect(40, 40, 20, 20);
+    manager.update(rect);
+    paint(manager, converter);
+    QCOMPARE(effect->processedCount, 2);
+    QCOMPARE(otherEffect->processedCount, 1);
+
+    // an area no shape intersects with
+    QRectF emptyRect(200, 200, 20, 20);
+    manager.update(emptyRect);
+    paint(manager, converter);
+    QCOMPARE(effect->processedCount, 2);
+    QCOMPARE(otherEffect->processedCount, 1);
+
+    delete shape;
+    delete otherShape;
+}
+
+void TestFilterEffectCache::testEvictionAcrossManagers()
+{
+    // the filtered image of each of these shapes needs about 25 MiB,
+    // the three of them do not fit into the cache of 64 MiB together
+    const QSizeF size(2100, 2100);
+    MockFilterEffect *effect1;
+    MockShape *shape1 = createFilteredShape(QPointF(), size, &effect1);
+    MockFilterEffect *effect2;
+    MockShape *shape2 = createFilteredShape(QPointF(), size, &effect2);
+    MockFilterEffect *effect3;
+    MockShape *shape3 = createFilteredShape(QPointF(), size, &effect3);
+
+    MockCanvas canvas1;
+    KoShapeManager manager1(&canvas1);
+    manager1.addShape(shape1);
+    MockCanvas canvas2;
+    KoShapeManager manager2(&canvas2);
+    manager2.addShape(shape2);
+    manager2.addShape(shape3);
+    KoViewConverter converter;
+
+    paintShape(manager1, shape1, converter);
+    paintShape(manager2, shape2, converter);
+    paintShape(manager2, shape3, converter);
+    QCOMPARE(effect1->processedCount, 1);
+    QCOMPARE(effect2->processedCount, 1);
+    QCOMPARE(effect3->processedCount, 1);
+
+    // the most recently used image is still cached
+    paintShape(manager2, shape3, converter);
+    QCOMPARE(effect3->processedCount, 1);
+
+    // the least recently used one was dropped for it, although it belongs to another manager
+    paintShape(manager1, shape1, converter);
+    QCOMPARE(effect1->processedCount, 2);
+
+    delete shape1;
+    delete shape2;
+    delete shape3;
+}
+
+QTEST_MAIN(TestFilterEffectCache)
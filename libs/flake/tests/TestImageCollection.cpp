@@ -26,6 +26,7 @@
 #include <QImage>
 #include <QPixmap>
 #include <QBuffer>
+#include <QFile>
 #include <QUrl>
 #include <FlakeDebug.h>
 
@@ -89,6 +90,43 @@ void TestImageCollection::testGetImageStore()
     delete store;
 }
 
+void TestImageCollection::testSharedAcrossSources()
+{
+    KoImageCollection collection;
+    KoStore *store = KoStore::createStore(QFINDTESTDATA("store.zip"), KoStore::Read);
+    KoImageData *id1 = collection.createImageData(QString("logo-calligra.png"), store);
+    delete store;
+
+    // the same image from a different store is shared
+    store = KoStore::createStore(QFINDTESTDATA("store.zip"), KoStore::Read);
+    KoImageData *id2 = collection.createImageData(QString("logo-calligra.png"), store);
+    QCOMPARE(id1->priv(), id2->priv());
+    delete store;
+
+    // and so are the same bytes pasted from somewhere else
+    QFile file(QFINDTESTDATA("logo-calligra.png"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    KoImageData *id3 = collection.createImageData(file.readAll());
+    QCOMPARE(id1->priv(), id3->priv());
+    QCOMPARE(collection.count(), 1);
+
+    // big images are found again before they are encoded for storage
+    QImage hugeImage(500, 500, QImage::Format_RGB32);
+    hugeImage.fill(Qt::red);
+    KoImageData *id4 = collection.createImageData(hugeImage);
+    KoImageData *id5 = collection.createImageData(hugeImage.copy());
+    QCOMPARE(id4->priv(), id5->priv());
+    QCOMPARE(id4->key(), id5->key());
+    QCOMPARE(collection.count(), 2);
+
+    delete id1;
+    delete id2;
+    delete id3;
+    delete id4;
+    delete id5;
+    QCOMPARE(collection.count(), 0);
+}
+
 void TestImageCollection::testInvalidImageData()
 {
     KoImageCollection collection;
@@ -232,6 +270,19 @@ void TestImageCollection::testSameKey()
     QCOMPARE(data2.key(), data7.key());
 }
 
+void TestImageCollection::testKeyHash()
+{
+    // the key is the xxHash64 of the data, compare with the reference implementation
+    KoImageData data;
+    data.setImage(QByteArray("abc"));
+    QCOMPARE(data.key(), qint64(Q_UINT64_C(0x44bc2cf5ad770999)));
+
+    // longer than one 32 byte stripe
+    KoImageData data2;
+    data2.setImage(QByteArray("Nobody inspects the spammish repetition"));
+    QCOMPARE(data2.key(), qint64(Q_UINT64_C(0xfbcea83c8a378bf1)));
+}
+
 void TestImageCollection::testIsValid()
 {
     KoImageData data;
@@ -30,12 +30,14 @@ private Q_SLOTS:
     void testGetImageImage();
     void testGetImageStore();
     void testInvalidImageData();
+    void testSharedAcrossSources();
 
     // imageData tests
     void testImageDataAsSharedData();
     void testPreload1();
     void testPreload3();
     void testSameKey();
+    void testKeyHash();
     void testIsValid();
 };
 
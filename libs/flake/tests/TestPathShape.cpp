@@ -782,4 +782,38 @@ void TestPathShape::closeMerge()
     QVERIFY(path.outline() == ppath);
 }
 
+void TestPathShape::cachedOutline()
+{
+    KoPathShape path;
+    path.moveTo(QPointF(10, 10));
+    KoPathPoint *p2 = path.lineTo(QPointF(20, 10));
+    path.lineTo(QPointF(20, 20));
+
+    QPainterPath ppath(QPointF(10, 10));
+    ppath.lineTo(20, 10);
+    ppath.lineTo(20, 20);
+    QVERIFY(path.outline() == ppath);
+
+    // changing a point invalidates the cached outline
+    p2->setPoint(QPointF(30, 10));
+    ppath = QPainterPath(QPointF(10, 10));
+    ppath.lineTo(30, 10);
+    ppath.lineTo(20, 20);
+    QVERIFY(path.outline() == ppath);
+
+    // as do changes of the structure
+    path.close();
+    ppath.closeSubpath();
+    QVERIFY(path.outline() == ppath);
+
+    delete path.removePoint(KoPathPointIndex(0, 1));
+    ppath = QPainterPath(QPointF(10, 10));
+    ppath.lineTo(20, 20);
+    ppath.closeSubpath();
+    QVERIFY(path.outline() == ppath);
+
+    path.clear();
+    QVERIFY(path.outline().isEmpty());
+}
+
 QTEST_MAIN(TestPathShape)
@@ -48,6 +48,7 @@ private Q_SLOTS:
     void removeSubpath();
     void addSubpath();
     void closeMerge();
+    void cachedOutline();
 
     void koPathPointDataLess();
 };
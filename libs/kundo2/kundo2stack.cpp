@@ -405,6 +405,27 @@ bool KUndo2Command::isMerged()
     return !m_mergeCommandsVector.isEmpty();
 }
 
+/*!
+    Returns an estimate of the number of bytes held by this command.
+
+    The default implementation returns the size of the command object itself
+    plus the memory used by its child commands and by the commands merged
+    into it. Commands that store snapshots of document data should reimplement
+    this function and add the size of that data.
+
+    \sa KUndo2QStack::setUndoMemoryLimit()
+*/
+
+qint64 KUndo2Command::memoryUsage() const
+{
+    qint64 usage = sizeof(*this) + sizeof(*d);
+    for (int i = 0; i < d->child_list.size(); ++i)
+        usage += d->child_list.at(i)->memoryUsage();
+    for (int i = 0; i < m_mergeCommandsVector.size(); ++i)
+        usage += m_mergeCommandsVector.at(i)->memoryUsage();
+    return usage;
+}
+
 KUndo2CommandExtraData* KUndo2Command::extraData() const
 {
     return d->extraData.data();
@@ -562,7 +583,9 @@ void KUndo2QStack::purgeRedoState()
     bool cleanStateChanged = false;
 
     while (m_index < m_command_list.size()) {
-        delete m_command_list.takeLast();
+        KUndo2Command *cmd = m_command_list.takeLast();
+        removeMemoryUsage(cmd);
+        delete cmd;
         redoStateChanged = true;
     }
 
@@ -582,7 +605,8 @@ void KUndo2QStack::purgeRedoState()
 }
 
 /*! \internal
-    If the number of commands on the stack exceedes the undo limit, deletes commands from
+    If the number of commands on the stack exceedes the undo limit, or the
+    commands use more memory than the undo memory limit, deletes commands from
     the bottom of the stack.
 
     Returns true if commands were deleted.
@@ -590,13 +614,22 @@ void KUndo2QStack::purgeRedoState()
 
 bool KUndo2QStack::checkUndoLimit()
 {
-    if (m_undo_limit <= 0 || !m_macro_stack.isEmpty() || m_undo_limit >= m_command_list.count())
+    if (!m_macro_stack.isEmpty())
         return false;
 
-    int del_count = m_command_list.count() - m_undo_limit;
+    int del_count = 0;
+    if (m_undo_limit > 0 && m_undo_limit < m_command_list.count())
+        del_count = m_command_list.count() - m_undo_limit;
+    del_count = qMax(del_count, undoMemoryLimitDeleteCount());
+
+    if (del_count <= 0)
+        return false;
 
-    for (int i = 0; i < del_count; ++i)
-        delete m_command_list.takeFirst();
+    for (int i = 0; i < del_count; ++i) {
+        KUndo2Command *cmd = m_command_list.takeFirst();
+        removeMemoryUsage(cmd);
+        delete cmd;
+    }
 
     m_index -= del_count;
     if (m_clean_index != -1) {
@@ -608,6 +641,52 @@ bool KUndo2QStack::checkUndoLimit()
     return true;
 }
 
+/*! \internal
+    Returns the number of commands that have to be deleted from the bottom of
+    the stack for the remaining commands to fit into the undo memory limit.
+
+    Only the commands below the most recently executed one are counted and
+    deleted, so that command and the redo history are always kept.
+*/
+
+int KUndo2QStack::undoMemoryLimitDeleteCount() const
+{
+    if (m_undo_memory_limit <= 0 || m_index <= 1 || m_memory_usage <= m_undo_memory_limit)
+        return 0;
+
+    qint64 usage = 0;
+    int first_kept = m_index - 1;
+    while (first_kept > 0) {
+        usage += m_command_memory.value(m_command_list.at(first_kept - 1));
+        if (usage > m_undo_memory_limit)
+            break;
+        --first_kept;
+    }
+    return first_kept;
+}
+
+/*! \internal
+    Recalculates the memory used by \a cmd, which is on the stack, and
+    updates the running total returned by memoryUsage().
+*/
+
+void KUndo2QStack::updateMemoryUsage(const KUndo2Command *cmd)
+{
+    const qint64 usage = cmd->memoryUsage();
+    m_memory_usage += usage - m_command_memory.value(cmd);
+    m_command_memory.insert(cmd, usage);
+}
+
+/*! \internal
+    Removes the memory used by \a cmd, which is being taken off the stack,
+    from the running total returned by memoryUsage().
+*/
+
+void KUndo2QStack::removeMemoryUsage(const KUndo2Command *cmd)
+{
+    m_memory_usage -= m_command_memory.take(cmd);
+}
+
 /*!
     Constructs an empty undo stack with the parent \a parent. The
     stack will initially be in the clean state. If \a parent is a
@@ -617,7 +696,7 @@ bool KUndo2QStack::checkUndoLimit()
 */
 
 KUndo2QStack::KUndo2QStack(QObject *parent)
-    : QObject(parent), m_index(0), m_clean_index(0), m_group(0), m_undo_limit(0), m_useCumulativeUndoRedo(false), m_lastMergedSetCount(0), m_lastMergedIndex(0)
+    : QObject(parent), m_index(0), m_clean_index(0), m_group(0), m_undo_limit(0), m_undo_memory_limit(0), m_memory_usage(0), m_useCumulativeUndoRedo(false), m_lastMergedSetCount(0), m_lastMergedIndex(0)
 {
     setTimeT1(5);
     setTimeT2(1);
@@ -669,6 +748,8 @@ void KUndo2QStack::clear()
     m_macro_stack.clear();
     qDeleteAll(m_command_list);
     m_command_list.clear();
+    m_command_memory.clear();
+    m_memory_usage = 0;
 
     m_index = 0;
     m_clean_index = 0;
@@ -722,8 +803,11 @@ bool KUndo2QStack::push(KUndo2Command *cmd)
     } else {
         if (m_index > 0)
             cur = m_command_list.at(m_index - 1);
-        while (m_index < m_command_list.size())
-            delete m_command_list.takeLast();
+        while (m_index < m_command_list.size()) {
+            KUndo2Command *redoCmd = m_command_list.takeLast();
+            removeMemoryUsage(redoCmd);
+            delete redoCmd;
+        }
         if (m_clean_index > m_index)
             m_clean_index = -1; // we've deleted the clean state
     }
@@ -759,7 +843,8 @@ bool KUndo2QStack::push(KUndo2Command *cmd)
             KUndo2Command* toMerge = m_command_list.at(m_lastMergedIndex);
             if (toMerge && m_command_list.size() >= m_lastMergedIndex + 1 && m_command_list.at(m_lastMergedIndex + 1)) {
                 if(toMerge->timedMergeWith(m_command_list.at(m_lastMergedIndex + 1))){
-                    m_command_list.removeAt(m_lastMergedIndex + 1);
+                    removeMemoryUsage(m_command_list.takeAt(m_lastMergedIndex + 1));
+                    updateMemoryUsage(toMerge);
                 }
                 m_lastMergedSetCount--;
                 m_lastMergedIndex = m_command_list.indexOf(toMerge);       
@@ -782,6 +867,8 @@ bool KUndo2QStack::push(KUndo2Command *cmd)
                             if(lastcmd->timedMergeWith(curr)){
                                 if (m_command_list.contains(curr)) {
                                     m_command_list.removeOne(curr);
+                                    removeMemoryUsage(curr);
+                                    updateMemoryUsage(lastcmd);
                                 }
                              }
                         } else {
@@ -792,6 +879,8 @@ bool KUndo2QStack::push(KUndo2Command *cmd)
                             if(lastcmd->timedMergeWith(curr)){
                                 if (m_command_list.contains(curr)){
                                     m_command_list.removeOne(curr);
+                                    removeMemoryUsage(curr);
+                                    updateMemoryUsage(lastcmd);
                                 }
                             }
                         } else {
@@ -808,6 +897,7 @@ bool KUndo2QStack::push(KUndo2Command *cmd)
         delete cmd;
         cmd = 0;
         if (!macro) {
+            updateMemoryUsage(cur);
             emit indexChanged(m_index);
             emit canUndoChanged(canUndo());
             emit undoTextChanged(undoText());
@@ -819,6 +909,7 @@ bool KUndo2QStack::push(KUndo2Command *cmd)
             m_macro_stack.last()->d->child_list.append(cmd);
         } else {
             m_command_list.append(cmd);
+            updateMemoryUsage(cmd);
             if(checkUndoLimit())
             {
                 m_lastMergedIndex = m_index - m_strokesN;
@@ -1154,11 +1245,15 @@ void KUndo2QStack::beginMacro(const KUndo2MagicString &text)
     cmd->setText(text);
 
     if (m_macro_stack.isEmpty()) {
-        while (m_index < m_command_list.size())
-            delete m_command_list.takeLast();
+        while (m_index < m_command_list.size()) {
+            KUndo2Command *redoCmd = m_command_list.takeLast();
+            removeMemoryUsage(redoCmd);
+            delete redoCmd;
+        }
         if (m_clean_index > m_index)
             m_clean_index = -1; // we've deleted the clean state
         m_command_list.append(cmd);
+        updateMemoryUsage(cmd);
     } else {
         m_macro_stack.last()->d->child_list.append(cmd);
     }
@@ -1191,6 +1286,8 @@ void KUndo2QStack::endMacro()
     m_macro_stack.removeLast();
 
     if (m_macro_stack.isEmpty()) {
+        // the macro has grown since beginMacro() put it on the stack
+        updateMemoryUsage(m_command_list.at(m_index));
         checkUndoLimit();
         setIndex(m_index + 1, false);
     }
@@ -1261,6 +1358,54 @@ int KUndo2QStack::undoLimit() const
     return m_undo_limit;
 }
 
+/*!
+    \property KUndo2QStack::undoMemoryLimit
+    \brief the maximum number of bytes the commands on this stack may use.
+
+    When the commands on the stack report more memory through
+    KUndo2Command::memoryUsage() than the limit allows, the oldest commands
+    are deleted from the bottom of the stack. The most recently executed
+    command and the commands that can be redone are never deleted. The
+    default value is 0, which means that there is no limit.
+
+    Unlike undoLimit, this property may be changed at any time.
+
+    \sa memoryUsage()
+*/
+
+void KUndo2QStack::setUndoMemoryLimit(qint64 bytes)
+{
+    if (bytes == m_undo_memory_limit)
+        return;
+    m_undo_memory_limit = bytes;
+
+    const bool was_clean = isClean();
+    if (checkUndoLimit()) {
+        m_lastMergedIndex = qMax(0, m_index - m_strokesN);
+        emit indexChanged(m_index);
+        emit canUndoChanged(canUndo());
+        emit undoTextChanged(undoText());
+        if (isClean() != was_clean)
+            emit cleanChanged(isClean());
+    }
+}
+
+qint64 KUndo2QStack::undoMemoryLimit() const
+{
+    return m_undo_memory_limit;
+}
+
+/*!
+    Returns the estimated number of bytes used by all commands on the stack.
+
+    \sa undoMemoryLimit, KUndo2Command::memoryUsage()
+*/
+
+qint64 KUndo2QStack::memoryUsage() const
+{
+    return m_memory_usage;
+}
+
 /*!
     \property KUndo2QStack::active
     \brief the active status of this stack.
@@ -63,6 +63,7 @@
 #include <QObject>
 #include <QString>
 #include <QList>
+#include <QHash>
 #include <QAction>
 #include <QTime>
 #include <QVector>
@@ -118,6 +119,19 @@ public:
     virtual void undoMergedCommands();
     virtual void redoMergedCommands();
 
+    /**
+     * \return an estimate of the memory held by this command in bytes,
+     * including its child and merged commands
+     *
+     * Commands that keep large snapshots of document data should
+     * reimplement this and add the size of their own data to the
+     * base implementation. It is used by KUndo2QStack to enforce
+     * its undo memory limit.
+     *
+     * \see KUndo2QStack::setUndoMemoryLimit()
+     */
+    virtual qint64 memoryUsage() const;
+
     /**
      * \return user-defined object associated with the command
      *
@@ -155,6 +169,7 @@ class KUNDO2_EXPORT KUndo2QStack : public QObject
 //    Q_DECLARE_PRIVATE(KUndo2QStack)
     Q_PROPERTY(bool active READ isActive WRITE setActive)
     Q_PROPERTY(int undoLimit READ undoLimit WRITE setUndoLimit)
+    Q_PROPERTY(qint64 undoMemoryLimit READ undoMemoryLimit WRITE setUndoMemoryLimit)
 
 public:
     explicit KUndo2QStack(QObject *parent = 0);
@@ -188,6 +203,10 @@ public:
     void setUndoLimit(int limit);
     int undoLimit() const;
 
+    void setUndoMemoryLimit(qint64 bytes);
+    qint64 undoMemoryLimit() const;
+    qint64 memoryUsage() const;
+
     const KUndo2Command *command(int index) const;
 
     void setUseCumulativeUndoRedo(bool value);
@@ -228,6 +247,9 @@ private:
     int m_clean_index;
     KUndo2Group *m_group;
     int m_undo_limit;
+    qint64 m_undo_memory_limit;
+    QHash<const KUndo2Command*, qint64> m_command_memory;
+    qint64 m_memory_usage;
     bool m_useCumulativeUndoRedo;
     double m_timeT1;
     double m_timeT2;
@@ -238,6 +260,9 @@ private:
     // also from QUndoStackPrivate
     void setIndex(int idx, bool clean);
     bool checkUndoLimit();
+    int undoMemoryLimitDeleteCount() const;
+    void updateMemoryUsage(const KUndo2Command *cmd);
+    void removeMemoryUsage(const KUndo2Command *cmd);
 
     Q_DISABLE_COPY(KUndo2QStack)
     friend class KUndo2Group;
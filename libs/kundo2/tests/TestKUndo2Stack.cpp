@@ -0,0 +1,137 @@
+/* This file is part of the KDE project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "TestKUndo2Stack.h"
+
+#include <kundo2stack.h>
+
+#include <QTest>
+
+class MemoryCommand : public KUndo2Command
+{
+public:
+    explicit MemoryCommand(qint64 bytes, KUndo2Command *parent = 0)
+        : KUndo2Command(kundo2_noi18n("memory"), parent)
+        , m_bytes(bytes)
+    {
+    }
+
+    qint64 memoryUsage() const Q_DECL_OVERRIDE
+    {
+        return m_bytes + KUndo2Command::memoryUsage();
+    }
+
+private:
+    qint64 m_bytes;
+};
+
+static qint64 commandSize(qint64 bytes)
+{
+    return MemoryCommand(bytes).memoryUsage();
+}
+
+void TestKUndo2Stack::testMemoryUsage()
+{
+    KUndo2QStack stack;
+    QCOMPARE(stack.memoryUsage(), qint64(0));
+
+    stack.push(new MemoryCommand(100));
+    stack.push(new MemoryCommand(100));
+    stack.push(new MemoryCommand(100));
+    QCOMPARE(stack.memoryUsage(), 3 * commandSize(100));
+
+    // pushing after an undo deletes the redo history
+    stack.undo();
+    stack.push(new MemoryCommand(1000));
+    QCOMPARE(stack.count(), 3);
+    QCOMPARE(stack.memoryUsage(), 2 * commandSize(100) + commandSize(1000));
+
+    stack.clear();
+    QCOMPARE(stack.memoryUsage(), qint64(0));
+}
+
+void TestKUndo2Stack::testMemoryLimitKeepsLastCommand()
+{
+    KUndo2QStack stack;
+    stack.setUndoMemoryLimit(100);
+
+    stack.push(new MemoryCommand(1000));
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.index(), 1);
+    QVERIFY(stack.canUndo());
+
+    stack.push(new MemoryCommand(1000));
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.index(), 2);
+
+    stack.push(new MemoryCommand(1000));
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.index(), 2);
+    QVERIFY(stack.canUndo());
+    QCOMPARE(stack.memoryUsage(), 2 * commandSize(1000));
+}
+
+void TestKUndo2Stack::testSetUndoMemoryLimit()
+{
+    KUndo2QStack stack;
+    for (int i = 0; i < 5; ++i)
+        stack.push(new MemoryCommand(100));
+    stack.undo();
+    stack.undo();
+    QCOMPARE(stack.index(), 3);
+
+    // only fits the command below the most recent one
+    stack.setUndoMemoryLimit(commandSize(100) + commandSize(100) / 2);
+    QCOMPARE(stack.count(), 4);
+    QCOMPARE(stack.index(), 2);
+    QVERIFY(stack.canRedo());
+    QCOMPARE(stack.memoryUsage(), 4 * commandSize(100));
+
+    // the most recent command is kept whatever the limit
+    stack.setUndoMemoryLimit(1);
+    QCOMPARE(stack.count(), 3);
+    QCOMPARE(stack.index(), 1);
+    QVERIFY(stack.canUndo());
+    QVERIFY(stack.canRedo());
+}
+
+void TestKUndo2Stack::testMemoryLimitMacro()
+{
+    KUndo2QStack stack;
+    stack.setUndoMemoryLimit(1);
+
+    stack.beginMacro(kundo2_noi18n("macro"));
+    stack.push(new MemoryCommand(100));
+    stack.push(new MemoryCommand(100));
+    stack.push(new MemoryCommand(100));
+    stack.endMacro();
+
+    QCOMPARE(stack.count(), 1);
+    QVERIFY(stack.canUndo());
+    QVERIFY(stack.memoryUsage() > 3 * commandSize(100));
+
+    stack.push(new MemoryCommand(100));
+    QCOMPARE(stack.count(), 2);
+
+    stack.push(new MemoryCommand(100));
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.memoryUsage(), 2 * commandSize(100));
+}
+
+QTEST_GUILESS_MAIN(TestKUndo2Stack)
@@ -70,16 +70,10 @@ KoFindText::~KoFindText()
 void KoFindText::findImplementation(const QString &pattern, QList<KoFindMatch> & matchList)
 {
     KoFindOptionSet *opts = options();
-    QTextDocument::FindFlags flags = 0;
+    const Qt::CaseSensitivity caseSensitivity =
+        opts->option("caseSensitive")->value().toBool() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    const bool wholeWords = opts->option("wholeWords")->value().toBool();
 
-    if(opts->option("caseSensitive")->value().toBool()) {
-        flags |= QTextDocument::FindCaseSensitively;
-    }
-    if(opts->option("wholeWords")->value().toBool()) {
-        flags |= QTextDocument::FindWholeWords;
-    }
-
-    int start = 0;
     bool findInSelection = false;
 
     if(d->documents.size() == 0) {
@@ -90,15 +84,30 @@ void KoFindText::findImplementation(const QString &pattern, QList<KoFindMatch> &
     bool before = opts->option("fromCursor")->value().toBool() && !d->currentCursor.isNull();
     QList<KoFindMatch> matchBefore;
     foreach(QTextDocument* document, d->documents) {
-        QTextCursor cursor = document->find(pattern, start, flags);
-        cursor.setKeepPositionOnInsert(true);
+        const Private::DocumentIndex &index = d->search(document, pattern, caseSensitivity);
 
         QVector<QAbstractTextDocumentLayout::Selection> selections;
-        while(!cursor.isNull()) {
-            if(findInSelection && d->selectionEnd <= cursor.position()) {
+        selections.reserve(index.candidates.size());
+        int end = 0;
+        foreach(int position, index.candidates) {
+            // like QTextDocument::find() continue after the previous match
+            if (position < end) {
+                continue;
+            }
+            if (wholeWords && !Private::isWholeWord(index.text, position, pattern.length())) {
+                continue;
+            }
+            end = position + pattern.length();
+
+            if(findInSelection && d->selectionEnd <= end) {
                 break;
             }
 
+            QTextCursor cursor(document);
+            cursor.setPosition(position);
+            cursor.setPosition(end, QTextCursor::KeepAnchor);
+            cursor.setKeepPositionOnInsert(true);
+
             if (before && document == d->currentCursor.document() && d->currentCursor < cursor) {
                 before = false;
             }
@@ -117,9 +126,6 @@ void KoFindText::findImplementation(const QString &pattern, QList<KoFindMatch> &
             else {
                 matchList.append(match);
             }
-
-            cursor = document->find(pattern, cursor, flags);
-            cursor.setKeepPositionOnInsert(true);
         }
         if (before && document == d->currentCursor.document()) {
             before = false;
@@ -240,6 +246,56 @@ void KoFindText::findTextInShapes(const QList<KoShape*> &shapes, QList<QTextDocu
     }
 }
 
+const KoFindText::Private::DocumentIndex &KoFindText::Private::search(QTextDocument *document, const QString &pattern, Qt::CaseSensitivity caseSensitivity)
+{
+    DocumentIndex &index = indexes[document];
+    if (!index.valid) {
+        index.text = document->toPlainText();
+        index.pattern.clear();
+        index.candidates.clear();
+        index.valid = true;
+    }
+
+    // blocks are separated by newlines in the text, a match never spans blocks
+    if (pattern.isEmpty() || pattern.contains(QLatin1Char('\n'))) {
+        index.pattern.clear();
+        index.candidates.clear();
+        return index;
+    }
+
+    QVector<int> candidates;
+    if (!index.pattern.isEmpty() && index.caseSensitivity == caseSensitivity
+            && pattern.startsWith(index.pattern, caseSensitivity)) {
+        // every occurrence of the pattern starts with an occurrence of the previous one
+        const int length = index.text.length();
+        foreach(int position, index.candidates) {
+            if (position + pattern.length() <= length
+                    && QStringRef(&index.text, position, pattern.length()).compare(pattern, caseSensitivity) == 0) {
+                candidates.append(position);
+            }
+        }
+    }
+    else {
+        int position = index.text.indexOf(pattern, 0, caseSensitivity);
+        while (position >= 0) {
+            candidates.append(position);
+            position = index.text.indexOf(pattern, position + 1, caseSensitivity);
+        }
+    }
+
+    index.pattern = pattern;
+    index.caseSensitivity = caseSensitivity;
+    index.candidates = candidates;
+    return index;
+}
+
+bool KoFindText::Private::isWholeWord(const QString &text, int position, int length)
+{
+    const int end = position + length;
+    return (position == 0 || !text.at(position - 1).isLetterOrNumber())
+        && (end == text.length() || !text.at(end).isLetterOrNumber());
+}
+
 void KoFindText::Private::updateSelections()
 {
     QHash< QTextDocument*, QVector<QAbstractTextDocumentLayout::Selection> >::ConstIterator itr;
@@ -253,6 +309,19 @@ void KoFindText::Private::updateDocumentList()
 {
     foreach(QTextDocument *document, documents) {
         connect(document, SIGNAL(destroyed(QObject*)), q, SLOT(documentDestroyed(QObject*)), Qt::UniqueConnection);
+        connect(document, SIGNAL(contentsChange(int,int,int)), q, SLOT(documentChanged()), Qt::UniqueConnection);
+    }
+
+    // drop the snapshots of documents that are not searched anymore
+    QHash<QTextDocument*, DocumentIndex>::Iterator it = indexes.begin();
+    while (it != indexes.end()) {
+        if (documents.contains(it.key())) {
+            ++it;
+        }
+        else {
+            disconnect(it.key(), SIGNAL(contentsChange(int,int,int)), q, SLOT(documentChanged()));
+            it = indexes.erase(it);
+        }
     }
 }
 
@@ -261,10 +330,20 @@ void KoFindText::Private::documentDestroyed(QObject *document)
     QTextDocument* doc = qobject_cast<QTextDocument*>(document);
     if(doc) {
         selections.remove(doc);
+        indexes.remove(doc);
         documents.removeOne(doc);
     }
 }
 
+void KoFindText::Private::documentChanged()
+{
+    QTextDocument *document = qobject_cast<QTextDocument*>(q->sender());
+    if (document) {
+        // the snapshot is taken again with the next search
+        indexes.remove(document);
+    }
+}
+
 void KoFindText::Private::updateCurrentMatch(int position)
 {
     Q_UNUSED(position);
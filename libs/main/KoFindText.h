@@ -36,8 +36,9 @@ class KoShape;
  * \brief KoFindBase implementation for searching within text shapes.
  *
  * This class provides a link between KoFindBase and QTextDocument for searching.
- * It uses a list of QTextDocument instances and searches through them using
- * QTextDocument::find().
+ * It uses a list of QTextDocument instances and searches through a plain text
+ * snapshot of them, which is kept until the document changes. When the pattern is
+ * extended, only the matches of the previous pattern are checked again.
  *
  * The following options are defined:
  * <ul>
@@ -142,6 +143,7 @@ private:
     Private * const d;
 
     Q_PRIVATE_SLOT(d, void documentDestroyed(QObject* object))
+    Q_PRIVATE_SLOT(d, void documentChanged())
 };
 
 Q_DECLARE_METATYPE(QTextDocument *)
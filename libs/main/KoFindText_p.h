@@ -48,9 +48,30 @@ class Q_DECL_HIDDEN KoFindText::Private
 public:
     Private(KoFindText* qq) : q(qq), selectionStart(-1), selectionEnd(-1) { }
 
+    /**
+     * Plain text snapshot of a document searches are run on.
+     *
+     * Positions in the text are document positions. The start positions of the last
+     * pattern are kept so typing a longer pattern only needs to check those.
+     */
+    struct DocumentIndex {
+        DocumentIndex() : valid(false), caseSensitivity(Qt::CaseInsensitive) { }
+
+        bool valid;
+        QString text;
+        QString pattern;
+        Qt::CaseSensitivity caseSensitivity;
+        /// all start positions of pattern, including overlapping ones and parts of words
+        QVector<int> candidates;
+    };
+
+    const DocumentIndex &search(QTextDocument *document, const QString &pattern, Qt::CaseSensitivity caseSensitivity);
+    static bool isWholeWord(const QString &text, int position, int length);
+
     void updateSelections();
     void updateDocumentList();
     void documentDestroyed(QObject *document);
+    void documentChanged();
     void updateCurrentMatch(int position);
     static void initializeFormats();
 
@@ -61,6 +82,7 @@ public:
     QTextCursor currentCursor;
     QTextCursor selection;
     QHash<QTextDocument*, QVector<QAbstractTextDocumentLayout::Selection> > selections;
+    QHash<QTextDocument*, DocumentIndex> indexes;
 
     int selectionStart;
     int selectionEnd;
@@ -0,0 +1,137 @@
+/* This file is part of the KDE project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "testfindtext.h"
+
+#include <QTextDocument>
+#include <QTextCursor>
+#include <QTest>
+
+#include "KoFindText.h"
+#include "KoFindMatch.h"
+#include "KoFindOptionSet.h"
+#include "KoFindOption.h"
+
+static const char *testText = "Find the word find, findings and Finding.\n"
+                              "A second find paragraph with aaaa\nfind";
+
+static QList<QPair<int, int> > matchRanges(const QList<KoFindMatch> &matches)
+{
+    QList<QPair<int, int> > ranges;
+    foreach (const KoFindMatch &match, matches) {
+        const QTextCursor cursor = match.location().value<QTextCursor>();
+        ranges.append(qMakePair(cursor.selectionStart(), cursor.selectionEnd()));
+    }
+    return ranges;
+}
+
+static QList<QPair<int, int> > expectedRanges(QTextDocument *document, const QString &pattern, QTextDocument::FindFlags flags)
+{
+    QList<QPair<int, int> > ranges;
+    QTextCursor cursor = document->find(pattern, 0, flags);
+    while (!cursor.isNull()) {
+        ranges.append(qMakePair(cursor.selectionStart(), cursor.selectionEnd()));
+        cursor = document->find(pattern, cursor, flags);
+    }
+    return ranges;
+}
+
+static void setOptions(KoFindText *finder, bool caseSensitive, bool wholeWords)
+{
+    finder->options()->setOptionValue("caseSensitive", caseSensitive);
+    finder->options()->setOptionValue("wholeWords", wholeWords);
+    finder->options()->setOptionValue("fromCursor", false);
+}
+
+void TestFindText::testFind_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<bool>("caseSensitive");
+    QTest::addColumn<bool>("wholeWords");
+
+    QTest::newRow("plain") << "find" << false << false;
+    QTest::newRow("case sensitive") << "Find" << true << false;
+    QTest::newRow("whole words") << "find" << false << true;
+    QTest::newRow("whole words, case sensitive") << "find" << true << true;
+    QTest::newRow("overlapping") << "aa" << false << false;
+    QTest::newRow("across blocks") << "aaaa\nfind" << false << false;
+    QTest::newRow("no match") << "xyz" << false << false;
+}
+
+void TestFindText::testFind()
+{
+    QFETCH(QString, pattern);
+    QFETCH(bool, caseSensitive);
+    QFETCH(bool, wholeWords);
+
+    QTextDocument document(QString::fromLatin1(testText));
+    KoFindText finder;
+    finder.setDocuments(QList<QTextDocument*>() << &document);
+    setOptions(&finder, caseSensitive, wholeWords);
+
+    QTextDocument::FindFlags flags = 0;
+    if (caseSensitive) {
+        flags |= QTextDocument::FindCaseSensitively;
+    }
+    if (wholeWords) {
+        flags |= QTextDocument::FindWholeWords;
+    }
+
+    finder.find(pattern);
+    QCOMPARE(matchRanges(finder.matches()), expectedRanges(&document, pattern, flags));
+}
+
+void TestFindText::testExtendPattern()
+{
+    QTextDocument document(QString::fromLatin1(testText));
+    KoFindText finder;
+    finder.setDocuments(QList<QTextDocument*>() << &document);
+    setOptions(&finder, false, false);
+
+    // typing a pattern character by character only checks the previous matches
+    const QString pattern = QLatin1String("findings");
+    for (int i = 1; i <= pattern.length(); ++i) {
+        finder.find(pattern.left(i));
+        QCOMPARE(matchRanges(finder.matches()), expectedRanges(&document, pattern.left(i), 0));
+    }
+
+    finder.find(QLatin1String("finding"));
+    QCOMPARE(finder.matches().count(), 2);
+    setOptions(&finder, true, false);
+    finder.find(QLatin1String("Finding"));
+    QCOMPARE(matchRanges(finder.matches()), expectedRanges(&document, QLatin1String("Finding"), QTextDocument::FindCaseSensitively));
+}
+
+void TestFindText::testDocumentChanged()
+{
+    QTextDocument document(QString::fromLatin1(testText));
+    KoFindText finder;
+    finder.setDocuments(QList<QTextDocument*>() << &document);
+    setOptions(&finder, false, false);
+
+    finder.find(QLatin1String("find"));
+    QCOMPARE(finder.matches().count(), 6);
+
+    QTextCursor cursor(&document);
+    cursor.insertText(QLatin1String("find "));
+    finder.find(QLatin1String("find"));
+    QCOMPARE(matchRanges(finder.matches()), expectedRanges(&document, QLatin1String("find"), 0));
+    QCOMPARE(finder.matches().count(), 7);
+}
+
+QTEST_MAIN(TestFindText)
@@ -26,6 +26,7 @@
 #include "KoPASavingContext.h"
 #include "KoPALoadingContext.h"
 #include "KoPAPageProvider.h"
+#include "KoPAThumbnailService.h"
 #include "commands/KoPAPageDeleteCommand.h"
 
 #include <KoStore.h>
@@ -71,6 +72,7 @@ public:
     QPointer<KoUpdater> odfMasterPageProgressUpdater;
     QPointer<KoUpdater> odfPageProgressUpdater;
     QString defaultStylesResourcePath;
+    KoPAThumbnailService *thumbnailService;
 };
 
 KoPADocument::KoPADocument(KoPart *part)
@@ -80,6 +82,7 @@ KoPADocument::KoPADocument(KoPart *part)
     d->inlineTextObjectManager = resourceManager()->resource(KoText::InlineTextObjectManager).value<KoInlineTextObjectManager*>();
     Q_ASSERT(d->inlineTextObjectManager);
     d->rulersVisible = false;
+    d->thumbnailService = 0;
     connect(documentInfo(), SIGNAL(infoUpdated(QString,QString)),
             d->inlineTextObjectManager, SLOT(documentInformationUpdated(QString,QString)));
 
@@ -639,6 +642,14 @@ QImage KoPADocument::pageThumbImage(KoPAPageBase* page, const QSize& size)
     return page->thumbImage(size);
 }
 
+KoPAThumbnailService *KoPADocument::thumbnailService()
+{
+    if (!d->thumbnailService) {
+        d->thumbnailService = new KoPAThumbnailService(this);
+    }
+    return d->thumbnailService;
+}
+
 void KoPADocument::initEmpty()
 {
     d->masterPages.clear();
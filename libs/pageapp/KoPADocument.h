@@ -31,6 +31,7 @@ class KoPAPageBase;
 class KoPAMasterPage;
 class KoPALoadingContext;
 class KoPASavingContext;
+class KoPAThumbnailService;
 
 class KoInlineTextObjectManager;
 
@@ -220,6 +221,11 @@ public:
 
     QImage pageThumbImage(KoPAPageBase* page, const QSize& size);
 
+    /**
+     * Get the service creating the page thumbnails without blocking the user interface
+     */
+    KoPAThumbnailService *thumbnailService();
+
     void emitUpdate(KoPAPageBase *page) {emit update(page);}
 
     /**
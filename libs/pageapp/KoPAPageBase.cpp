@@ -333,6 +333,27 @@ QImage KoPAPageBase::thumbImage(const QSize &size)
     return image;
 }
 
+QPixmap KoPAPageBase::cachedThumbnail(const QSize &size) const
+{
+    QPixmap pm;
+#ifdef CACHE_PAGE_THUMBNAILS
+    KoPAPixmapCache::instance()->find(thumbnailKey(), size, pm);
+#else
+    Q_UNUSED(size);
+#endif
+    return pm;
+}
+
+void KoPAPageBase::insertThumbnail(const QPixmap &pixmap, const QSize &size)
+{
+#ifdef CACHE_PAGE_THUMBNAILS
+    KoPAPixmapCache::instance()->insert(thumbnailKey(), pixmap, size);
+#else
+    Q_UNUSED(pixmap);
+    Q_UNUSED(size);
+#endif
+}
+
 void KoPAPageBase::pageUpdated()
 {
     KoPAPixmapCache::instance()->remove( thumbnailKey() );
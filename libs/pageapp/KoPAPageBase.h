@@ -120,6 +120,18 @@ public:
 
     virtual QImage thumbImage(const QSize &size = QSize(512, 512));
 
+    /**
+     * Get the thumbnail of the given size from the thumbnail cache
+     *
+     * @return the thumbnail or a null pixmap if it is not in the cache
+     */
+    QPixmap cachedThumbnail(const QSize &size) const;
+
+    /**
+     * Put a thumbnail created somewhere else, e.g. loaded from disk, into the thumbnail cache
+     */
+    void insertThumbnail(const QPixmap &pixmap, const QSize &size);
+
     /**
      * This function is called when the content of the page changes
      *
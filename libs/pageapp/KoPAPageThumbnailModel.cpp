@@ -24,11 +24,13 @@
 #include <klocalizedstring.h>
 
 #include "KoPAPageBase.h"
+#include "KoPAThumbnailService.h"
 
 KoPAPageThumbnailModel::KoPAPageThumbnailModel(const QList<KoPAPageBase *> &pages, QObject *parent)
     : QAbstractListModel(parent),
     m_pages(pages),
-    m_iconSize(512, 512)
+    m_iconSize(512, 512),
+    m_thumbnailService(0)
 {
 }
 
@@ -72,6 +74,10 @@ QVariant KoPAPageThumbnailModel::data(const QModelIndex &index, int role) const
         return name;
     }
     else if (role == Qt::DecorationRole) {
+        if (m_thumbnailService) {
+            QPixmap thumbnail = m_thumbnailService->thumbnail(m_pages.at(index.row()), m_iconSize);
+            return thumbnail.isNull() ? QVariant() : QIcon(thumbnail);
+        }
         return QIcon( m_pages.at(index.row())->thumbnail( m_iconSize ) );
     }
 
@@ -82,3 +88,23 @@ void KoPAPageThumbnailModel::setIconSize(const QSize &size)
 {
     m_iconSize = size;
 }
+
+void KoPAPageThumbnailModel::setThumbnailService(KoPAThumbnailService *service)
+{
+    if (m_thumbnailService) {
+        disconnect(m_thumbnailService, 0, this, 0);
+    }
+    m_thumbnailService = service;
+    if (m_thumbnailService) {
+        connect(m_thumbnailService, SIGNAL(thumbnailReady(KoPAPageBase*)), this, SLOT(thumbnailReady(KoPAPageBase*)));
+    }
+}
+
+void KoPAPageThumbnailModel::thumbnailReady(KoPAPageBase *page)
+{
+    const int row = m_pages.indexOf(page);
+    if (row >= 0) {
+        QModelIndex changed = index(row, 0);
+        emit dataChanged(changed, changed);
+    }
+}
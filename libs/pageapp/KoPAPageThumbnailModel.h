@@ -27,6 +27,7 @@
 
 class KoPAView;
 class KoPAPageBase;
+class KoPAThumbnailService;
 
 /**
  * Model class for the page thumbnails widget. This class is intented as a simple model to
@@ -50,12 +51,23 @@ public:
 
     void setIconSize(const QSize &size);
 
+    /**
+     * Set the service used to get the thumbnails without blocking
+     *
+     * If no service is set the thumbnails are painted when they are asked for.
+     */
+    void setThumbnailService(KoPAThumbnailService *service);
+
+private Q_SLOTS:
+    void thumbnailReady(KoPAPageBase *page);
+
 private:
     KoPAView *m_view;
     QList<KoPAPageBase *> m_pages;
 
     int m_iconWidth;
     QSize m_iconSize;
+    KoPAThumbnailService *m_thumbnailService;
 };
 
 #endif
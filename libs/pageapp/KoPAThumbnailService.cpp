@@ -0,0 +1,313 @@
+/* This file is part of the KDE project
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KoPAThumbnailService.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QImage>
+#include <QRunnable>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QTimer>
+#include <QUrl>
+
+#include "KoPADocument.h"
+#include "KoPAMasterPage.h"
+#include "KoPAPageBase.h"
+
+namespace {
+
+/// the thumbnails of documents that were not used recently are deleted when the cache gets bigger
+const qint64 MaxCacheSize = 64 * 1024 * 1024;
+
+QString cacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/pagethumbnails");
+}
+
+struct Request
+{
+    Request() : page(0) {}
+    Request(KoPAPageBase *page, const QSize &size) : page(page), size(size) {}
+
+    bool operator==(const Request &other) const
+    {
+        return page == other.page && size == other.size;
+    }
+
+    KoPAPageBase *page;
+    QSize size;
+};
+
+class LoadThumbnailJob : public QRunnable
+{
+public:
+    LoadThumbnailJob(KoPAThumbnailService *service, int requestId, const QString &fileName)
+        : m_service(service), m_requestId(requestId), m_fileName(fileName)
+    {
+    }
+
+    virtual void run()
+    {
+        const QImage image(m_fileName);
+        QMetaObject::invokeMethod(m_service, "thumbnailLoaded", Qt::QueuedConnection,
+                                  Q_ARG(int, m_requestId), Q_ARG(QImage, image));
+    }
+
+private:
+    KoPAThumbnailService *m_service;
+    const int m_requestId;
+    const QString m_fileName;
+};
+
+class SaveThumbnailJob : public QRunnable
+{
+public:
+    SaveThumbnailJob(const QImage &image, const QString &fileName)
+        : m_image(image), m_fileName(fileName)
+    {
+    }
+
+    virtual void run()
+    {
+        const QFileInfo fileInfo(m_fileName);
+        QDir().mkpath(fileInfo.absolutePath());
+        // write to a temporary file first so a concurrent load never sees a partial file
+        const QString tmpFileName = m_fileName + QLatin1String(".tmp");
+        if (m_image.save(tmpFileName, "PNG")) {
+            QFile::remove(m_fileName);
+            QFile::rename(tmpFileName, m_fileName);
+        }
+
+        // the thumbnails of older versions of the document are never used again
+        const QString version = fileInfo.fileName().section(QLatin1Char('_'), 0, 0) + QLatin1Char('_');
+        QDir dir(fileInfo.absolutePath());
+        foreach (const QString &fileName, dir.entryList(QStringList() << QLatin1String("*.png"), QDir::Files)) {
+            if (!fileName.startsWith(version)) {
+                dir.remove(fileName);
+            }
+        }
+    }
+
+private:
+    const QImage m_image;
+    const QString m_fileName;
+};
+
+class PruneCacheJob : public QRunnable
+{
+public:
+    virtual void run()
+    {
+        // there is one directory per document, the least recently written ones go first
+        QDir cacheDir(cacheDirectory());
+        const QFileInfoList documentDirs = cacheDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Time);
+        qint64 cacheSize = 0;
+        foreach (const QFileInfo &documentDir, documentDirs) {
+            const QFileInfoList files = QDir(documentDir.absoluteFilePath()).entryInfoList(QDir::Files);
+            qint64 size = 0;
+            foreach (const QFileInfo &file, files) {
+                size += file.size();
+            }
+            if (cacheSize + size > MaxCacheSize) {
+                QDir(documentDir.absoluteFilePath()).removeRecursively();
+            }
+            else {
+                cacheSize += size;
+            }
+        }
+    }
+};
+
+}
+
+class Q_DECL_HIDDEN KoPAThumbnailService::Private
+{
+public:
+    explicit Private(KoPADocument *document)
+        : document(document)
+        , nextRequestId(0)
+    {
+    }
+
+    /// the file the thumbnail is stored in, or an empty string if it can't be stored
+    QString cacheFileName(KoPAPageBase *page, const QSize &size) const;
+    bool isPending(const Request &request) const;
+    void render(const Request &request, const QString &fileName);
+
+    KoPADocument *document;
+    QList<Request> queue;
+    QHash<int, Request> loading;
+    int nextRequestId;
+    QTimer timer;
+    QThreadPool pool;
+};
+
+QString KoPAThumbnailService::Private::cacheFileName(KoPAPageBase *page, const QSize &size) const
+{
+    // only thumbnails of the pages as they are in the file can be reused later
+    if (document->isModified() || !document->url().isLocalFile()) {
+        return QString();
+    }
+    const QFileInfo fileInfo(document->url().toLocalFile());
+    if (!fileInfo.exists()) {
+        return QString();
+    }
+
+    // one directory per document, the file name starts with the version of the document
+    const QByteArray hash = QCryptographicHash::hash(fileInfo.absoluteFilePath().toUtf8(), QCryptographicHash::Md5).toHex();
+    const bool masterPage = dynamic_cast<KoPAMasterPage *>(page) != 0;
+    const QString fileName = QString("%1-%2_%3%4_%5x%6.png")
+        .arg(fileInfo.lastModified().toMSecsSinceEpoch())
+        .arg(fileInfo.size())
+        .arg(masterPage ? 'm' : 'p')
+        .arg(document->pageIndex(page))
+        .arg(size.width()).arg(size.height());
+
+    return cacheDirectory() + QLatin1Char('/') + QString::fromLatin1(hash) + QLatin1Char('/') + fileName;
+}
+
+bool KoPAThumbnailService::Private::isPending(const Request &request) const
+{
+    if (queue.contains(request)) {
+        return true;
+    }
+    foreach (const Request &loadingRequest, loading) {
+        if (loadingRequest == request) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void KoPAThumbnailService::Private::render(const Request &request, const QString &fileName)
+{
+    // this also puts the thumbnail into the thumbnail cache of the page
+    QPixmap pixmap = document->pageThumbnail(request.page, request.size);
+    if (!fileName.isEmpty() && !pixmap.isNull()) {
+        pool.start(new SaveThumbnailJob(pixmap.toImage(), fileName));
+    }
+}
+
+KoPAThumbnailService::KoPAThumbnailService(KoPADocument *document)
+    : QObject(document)
+    , d(new Private(document))
+{
+    d->timer.setSingleShot(true);
+    d->timer.setInterval(0);
+    d->pool.setMaxThreadCount(2);
+    connect(&d->timer, SIGNAL(timeout()), this, SLOT(processRequest()));
+    connect(document, SIGNAL(pageRemoved(KoPAPageBase*)), this, SLOT(pageRemoved(KoPAPageBase*)));
+    d->pool.start(new PruneCacheJob());
+}
+
+KoPAThumbnailService::~KoPAThumbnailService()
+{
+    // the jobs still reference this object
+    d->pool.waitForDone();
+    delete d;
+}
+
+QPixmap KoPAThumbnailService::thumbnail(KoPAPageBase *page, const QSize &size)
+{
+    if (!page || size.isEmpty()) {
+        return QPixmap();
+    }
+
+    QPixmap pixmap = page->cachedThumbnail(size);
+    if (pixmap.isNull()) {
+        const Request request(page, size);
+        if (!d->isPending(request)) {
+            d->queue.append(request);
+            d->timer.start();
+        }
+    }
+    return pixmap;
+}
+
+void KoPAThumbnailService::processRequest()
+{
+    if (d->queue.isEmpty()) {
+        return;
+    }
+
+    const Request request = d->queue.takeFirst();
+    // handle only one page per event loop iteration to keep the ui responsive
+    if (!d->queue.isEmpty()) {
+        d->timer.start();
+    }
+
+    if (!request.page->cachedThumbnail(request.size).isNull()) {
+        emit thumbnailReady(request.page);
+        return;
+    }
+
+    const QString fileName = d->cacheFileName(request.page, request.size);
+    if (!fileName.isEmpty() && QFile::exists(fileName)) {
+        const int requestId = d->nextRequestId++;
+        d->loading.insert(requestId, request);
+        d->pool.start(new LoadThumbnailJob(this, requestId, fileName));
+    }
+    else {
+        d->render(request, fileName);
+        emit thumbnailReady(request.page);
+    }
+}
+
+void KoPAThumbnailService::thumbnailLoaded(int requestId, const QImage &image)
+{
+    const Request request = d->loading.take(requestId);
+    if (!request.page) {
+        // the page was removed meanwhile
+        return;
+    }
+
+    // the page might have been changed while loading
+    if (image.isNull() || d->document->isModified()) {
+        d->render(request, d->cacheFileName(request.page, request.size));
+    }
+    else {
+        request.page->insertThumbnail(QPixmap::fromImage(image), request.size);
+    }
+    emit thumbnailReady(request.page);
+}
+
+void KoPAThumbnailService::pageRemoved(KoPAPageBase *page)
+{
+    QList<Request>::iterator it(d->queue.begin());
+    while (it != d->queue.end()) {
+        if (it->page == page) {
+            it = d->queue.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    QHash<int, Request>::iterator loadingIt(d->loading.begin());
+    for (; loadingIt != d->loading.end(); ++loadingIt) {
+        if (loadingIt->page == page) {
+            loadingIt->page = 0;
+        }
+    }
+}
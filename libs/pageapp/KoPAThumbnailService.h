@@ -0,0 +1,75 @@
+/* This file is part of the KDE project
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KOPATHUMBNAILSERVICE_H
+#define KOPATHUMBNAILSERVICE_H
+
+#include <QObject>
+#include <QPixmap>
+
+#include "kopageapp_export.h"
+
+class KoPADocument;
+class KoPAPageBase;
+class QImage;
+
+/**
+ * Service providing the page thumbnails of a document without blocking the user interface.
+ *
+ * Thumbnails that are not available yet are created later on, one page per event loop
+ * iteration, and thumbnailReady() is emitted once they are. While a document is not
+ * modified the thumbnails are also stored on disk, keyed by the document file, its
+ * modification time and the page, so reopening the document does not need to paint all
+ * pages again. Only the thumbnails of the latest version of a document are kept, and the
+ * documents used least recently are dropped when the cache grows beyond its size limit.
+ * Loading and storing the files is done on worker threads.
+ *
+ * Use KoPADocument::thumbnailService() to get the service of a document.
+ */
+class KOPAGEAPP_EXPORT KoPAThumbnailService : public QObject
+{
+    Q_OBJECT
+public:
+    explicit KoPAThumbnailService(KoPADocument *document);
+    virtual ~KoPAThumbnailService();
+
+    /**
+     * Get the thumbnail of a page
+     *
+     * @return the thumbnail or a null pixmap if it is not available yet. In that case
+     *         the thumbnail is created and thumbnailReady() is emitted when it is done.
+     */
+    QPixmap thumbnail(KoPAPageBase *page, const QSize &size);
+
+Q_SIGNALS:
+    /**
+     * Emitted when a thumbnail of the page requested before is available
+     */
+    void thumbnailReady(KoPAPageBase *page);
+
+private Q_SLOTS:
+    void processRequest();
+    void thumbnailLoaded(int requestId, const QImage &image);
+    void pageRemoved(KoPAPageBase *page);
+
+private:
+    class Private;
+    Private * const d;
+};
+
+#endif /* KOPATHUMBNAILSERVICE_H */
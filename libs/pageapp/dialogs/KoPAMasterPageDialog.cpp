@@ -57,6 +57,7 @@ KoPAMasterPageDialog::KoPAMasterPageDialog(KoPADocument *document, KoPAMasterPag
 
     m_pageThumbnailModel = new KoPAPageThumbnailModel(m_document->pages(true), m_listView);
     m_pageThumbnailModel->setIconSize(iconSize);
+    m_pageThumbnailModel->setThumbnailService(m_document->thumbnailService());
     m_listView->setModel(m_pageThumbnailModel);
     layout->addWidget(m_listView);
 
@@ -39,6 +39,7 @@
 
 #include <QThreadStorage>
 #include <QByteArray>
+#include <QColor>
 #include <QBitArray>
 #include <QPolygonF>
 #include <QPointF>
@@ -417,6 +418,24 @@ KoColorConversionTransformation* KoColorSpace::createColorConverter(const KoColo
     }
 }
 
+void KoColorSpace::fromQColors(const QVector<QColor> &colors, quint8 *dst, const KoColorProfile *profile) const
+{
+    const quint32 size = pixelSize();
+    foreach (const QColor &color, colors) {
+        fromQColor(color, dst, profile);
+        dst += size;
+    }
+}
+
+void KoColorSpace::toQColors(const quint8 *src, QColor *colors, quint32 nPixels, const KoColorProfile *profile) const
+{
+    const quint32 size = pixelSize();
+    for (quint32 i = 0; i < nPixels; ++i) {
+        toQColor(src, colors + i, profile);
+        src += size;
+    }
+}
+
 bool KoColorSpace::convertPixelsTo(const quint8 * src,
                                    quint8 * dst,
                                    const KoColorSpace * dstColorSpace,
@@ -296,6 +296,27 @@ public:
      */
     virtual void toQColor(const quint8 *src, QColor *c, const KoColorProfile * profile = 0) const = 0;
 
+    /**
+     * Convert a number of QColors at once, see fromQColor(). Color spaces
+     * can reimplement this to convert all colors in one go.
+     *
+     * @param colors the colors that will be used to fill dst
+     * @param dst a pointer to colors.size() contiguous pixels
+     * @param profile the optional profile that describes the color values of the QColors
+     */
+    virtual void fromQColors(const QVector<QColor> &colors, quint8 *dst, const KoColorProfile * profile = 0) const;
+
+    /**
+     * Convert a number of pixels to QColors at once, see toQColor(). Color spaces
+     * can reimplement this to convert all pixels in one go.
+     *
+     * @param src a pointer to nPixels contiguous source pixels
+     * @param colors the QColors that will be filled with the colors at src, at least nPixels long
+     * @param nPixels the number of pixels to convert
+     * @param profile the optional profile that describes the colors in colors
+     */
+    virtual void toQColors(const quint8 *src, QColor *colors, quint32 nPixels, const KoColorProfile * profile = 0) const;
+
     /**
      * Convert the pixels in data to (8-bit BGRA) QImage using the specified profiles.
      *
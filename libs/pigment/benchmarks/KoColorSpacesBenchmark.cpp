@@ -19,10 +19,13 @@
 #include "KoColorSpacesBenchmark.h"
 
 #include <QTest>
+#include <QColor>
+#include <QVector>
 #include <KoColorSpaceRegistry.h>
 #include <KoColorSpace.h>
 
 #define NB_PIXELS 1000000
+#define NB_COLORS 100000
 
 void KoColorSpacesBenchmark::createRowsColumns()
 {
@@ -146,4 +149,84 @@ void KoColorSpacesBenchmark::benchmarkSetAlpha2IndividualCall()
     END_BENCHMARK
 }
 
+// a palette like set of colors, every color occurs several times
+static QVector<QColor> createColors()
+{
+    QVector<QColor> colors(NB_COLORS);
+    for (int i = 0; i < NB_COLORS; ++i) {
+        colors[i] = QColor::fromHsv((i * 37) % 360, 255 - i % 64, 255 - i % 96);
+    }
+    return colors;
+}
+
+void KoColorSpacesBenchmark::benchmarkFromQColor_data()
+{
+    createRowsColumns();
+}
+
+void KoColorSpacesBenchmark::benchmarkFromQColor()
+{
+    START_BENCHMARK
+    const QVector<QColor> colors = createColors();
+    QBENCHMARK {
+        quint8* data_it = data;
+        foreach (const QColor &color, colors) {
+            colorSpace->fromQColor(color, data_it);
+            data_it += pixelSize;
+        }
+    }
+    END_BENCHMARK
+}
+
+void KoColorSpacesBenchmark::benchmarkFromQColors_data()
+{
+    createRowsColumns();
+}
+
+void KoColorSpacesBenchmark::benchmarkFromQColors()
+{
+    START_BENCHMARK
+    const QVector<QColor> colors = createColors();
+    QBENCHMARK {
+        colorSpace->fromQColors(colors, data);
+    }
+    END_BENCHMARK
+}
+
+void KoColorSpacesBenchmark::benchmarkToQColor_data()
+{
+    createRowsColumns();
+}
+
+void KoColorSpacesBenchmark::benchmarkToQColor()
+{
+    START_BENCHMARK
+    colorSpace->fromQColors(createColors(), data);
+    QVector<QColor> colors(NB_COLORS);
+    QBENCHMARK {
+        quint8* data_it = data;
+        for (int i = 0; i < NB_COLORS; ++i) {
+            colorSpace->toQColor(data_it, &colors[i]);
+            data_it += pixelSize;
+        }
+    }
+    END_BENCHMARK
+}
+
+void KoColorSpacesBenchmark::benchmarkToQColors_data()
+{
+    createRowsColumns();
+}
+
+void KoColorSpacesBenchmark::benchmarkToQColors()
+{
+    START_BENCHMARK
+    colorSpace->fromQColors(createColors(), data);
+    QVector<QColor> colors(NB_COLORS);
+    QBENCHMARK {
+        colorSpace->toQColors(data, colors.data(), NB_COLORS);
+    }
+    END_BENCHMARK
+}
+
 QTEST_MAIN(KoColorSpacesBenchmark)
@@ -39,6 +39,14 @@ private Q_SLOTS:
     void benchmarkSetAlphaIndividualCall();
     void benchmarkSetAlpha2IndividualCall_data();
     void benchmarkSetAlpha2IndividualCall();
+    void benchmarkFromQColor_data();
+    void benchmarkFromQColor();
+    void benchmarkFromQColors_data();
+    void benchmarkFromQColors();
+    void benchmarkToQColor_data();
+    void benchmarkToQColor();
+    void benchmarkToQColors_data();
+    void benchmarkToQColors();
 };
 
 #endif
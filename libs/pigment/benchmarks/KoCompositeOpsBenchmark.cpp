@@ -20,10 +20,12 @@
 
 #include "../compositeops/KoCompositeOpAlphaDarken.h"
 #include "../compositeops/KoCompositeOpOver.h"
+#include "../compositeops/KoCompositeOpGeneric.h"
 #include <KoOptimizedCompositeOpFactory.h>
 
 #include <KoColorSpaceTraits.h>
 #include <KoColorSpaceRegistry.h>
+#include <KoCompositeOpRegistry.h>
 
 #include <QTest>
 
@@ -87,5 +89,65 @@ void KoCompositeOpsBenchmark::benchmarkCompositeAlphaDarken()
     }
 }
 
+void KoCompositeOpsBenchmark::benchmarkCompositeSeparable_data()
+{
+    QTest::addColumn<QString>("id");
+    QTest::addColumn<bool>("optimized");
+
+    const QStringList ids = QStringList() << COMPOSITE_MULT << COMPOSITE_SCREEN << COMPOSITE_OVERLAY
+                                          << COMPOSITE_DARKEN << COMPOSITE_LIGHTEN
+                                          << COMPOSITE_ADD << COMPOSITE_SUBTRACT;
+    foreach (const QString &id, ids) {
+        QTest::newRow(QString("%1 generic").arg(id).toLatin1()) << id << false;
+        QTest::newRow(QString("%1 optimized").arg(id).toLatin1()) << id << true;
+    }
+}
+
+static KoCompositeOp* createGenericOp32(const KoColorSpace *cs, const QString &id)
+{
+    typedef KoBgrU8Traits::channels_type Arg;
+
+    if (id == COMPOSITE_MULT) {
+        return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfMultiply<Arg> >(cs, id, id, id);
+    } else if (id == COMPOSITE_SCREEN) {
+        return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfScreen<Arg> >(cs, id, id, id);
+    } else if (id == COMPOSITE_OVERLAY) {
+        return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfOverlay<Arg> >(cs, id, id, id);
+    } else if (id == COMPOSITE_DARKEN) {
+        return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfDarkenOnly<Arg> >(cs, id, id, id);
+    } else if (id == COMPOSITE_LIGHTEN) {
+        return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfLightenOnly<Arg> >(cs, id, id, id);
+    } else if (id == COMPOSITE_ADD) {
+        return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfAddition<Arg> >(cs, id, id, id);
+    } else {
+        return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfSubtract<Arg> >(cs, id, id, id);
+    }
+}
+
+void KoCompositeOpsBenchmark::benchmarkCompositeSeparable()
+{
+    QFETCH(QString, id);
+    QFETCH(bool, optimized);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KoCompositeOp *compositeOp = createGenericOp32(cs, id);
+    if (optimized) {
+        compositeOp = KoOptimizedCompositeOpFactory::createSeparableOp32(compositeOp);
+    }
+
+    QBENCHMARK{
+        for (int y = 0; y < TILES_IN_HEIGHT; y++){
+            for (int x = 0; x < TILES_IN_WIDTH; x++){
+                compositeOp->composite(m_dstBuffer, TILE_WIDTH * KoBgrU8Traits::pixelSize,
+                                      m_srcBuffer, TILE_WIDTH * KoBgrU8Traits::pixelSize,
+                                      0, 0,
+                                      TILE_WIDTH, TILE_HEIGHT,
+                                      OPACITY_HALF);
+            }
+        }
+    }
+
+    delete compositeOp;
+}
 
 QTEST_GUILESS_MAIN(KoCompositeOpsBenchmark)
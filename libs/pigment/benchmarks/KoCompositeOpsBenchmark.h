@@ -32,6 +32,8 @@ private Q_SLOTS:
     
     void benchmarkCompositeOver();
     void benchmarkCompositeAlphaDarken();
+    void benchmarkCompositeSeparable_data();
+    void benchmarkCompositeSeparable();
 
 private:
     quint8 * m_dstBuffer;
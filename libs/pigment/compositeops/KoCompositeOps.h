@@ -56,6 +56,9 @@ struct OptimizedOpsSelector
     static KoCompositeOp* createOverOp(const KoColorSpace *cs) {
         return new KoCompositeOpOver<Traits>(cs);
     }
+    static KoCompositeOp* createSeparableOp(KoCompositeOp *genericOp) {
+        return genericOp;
+    }
 };
 
 template<>
@@ -67,6 +70,9 @@ struct OptimizedOpsSelector<KoBgrU8Traits>
     static KoCompositeOp* createOverOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createOverOp32(cs);
     }
+    static KoCompositeOp* createSeparableOp(KoCompositeOp *genericOp) {
+        return KoOptimizedCompositeOpFactory::createSeparableOp32(genericOp);
+    }
 };
 
 template<>
@@ -78,6 +84,9 @@ struct OptimizedOpsSelector<KoLabU8Traits>
     static KoCompositeOp* createOverOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createOverOp32(cs);
     }
+    static KoCompositeOp* createSeparableOp(KoCompositeOp *genericOp) {
+        return KoOptimizedCompositeOpFactory::createSeparableOp32(genericOp);
+    }
 };
 
 template<>
@@ -89,6 +98,9 @@ struct OptimizedOpsSelector<KoRgbF32Traits>
     static KoCompositeOp* createOverOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createOverOp128(cs);
     }
+    static KoCompositeOp* createSeparableOp(KoCompositeOp *genericOp) {
+        return KoOptimizedCompositeOpFactory::createSeparableOp128(genericOp);
+    }
 };
 
 template<class Traits>
@@ -100,7 +112,8 @@ struct AddGeneralOps<Traits, true>
 
      template<CompositeFunc func>
      static void add(KoColorSpace* cs, const QString& id, const QString& description, const QString& category) {
-         cs->addCompositeOp(new KoCompositeOpGenericSC<Traits, func>(cs, id, description, category));
+         KoCompositeOp *genericOp = new KoCompositeOpGenericSC<Traits, func>(cs, id, description, category);
+         cs->addCompositeOp(OptimizedOpsSelector<Traits>::createSeparableOp(genericOp));
      }
 
      static void add(KoColorSpace* cs) {
@@ -51,3 +51,13 @@ KoCompositeOp* KoOptimizedCompositeOpFactory::createOverOp128(const KoColorSpace
 {
     return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOver128> >(cs);
 }
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createSeparableOp32(KoCompositeOp *genericOp)
+{
+    return createOptimizedClass<KoOptimizedSeparableCompositeOpFactoryPerArch<4> >(genericOp);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createSeparableOp128(KoCompositeOp *genericOp)
+{
+    return createOptimizedClass<KoOptimizedSeparableCompositeOpFactoryPerArch<16> >(genericOp);
+}
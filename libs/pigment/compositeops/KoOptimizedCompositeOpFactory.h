@@ -44,6 +44,19 @@ public:
     static KoCompositeOp* createOverOp32(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOp128(const KoColorSpace *cs);
     static KoCompositeOp* createOverOp128(const KoColorSpace *cs);
+
+    /**
+     * Returns a vectorized version of \p genericOp, a KoCompositeOpGenericSC of a
+     * 4 byte colorspace, and takes ownership of \p genericOp. If its blending
+     * function has no vectorized version, \p genericOp itself is returned.
+     */
+    static KoCompositeOp* createSeparableOp32(KoCompositeOp *genericOp);
+
+    /**
+     * The same as createSeparableOp32() for a KoCompositeOpGenericSC of
+     * a float RGBA colorspace.
+     */
+    static KoCompositeOp* createSeparableOp128(KoCompositeOp *genericOp);
 };
 
 #endif /* KOOPTIMIZEDCOMPOSITEOPFACTORY_H */
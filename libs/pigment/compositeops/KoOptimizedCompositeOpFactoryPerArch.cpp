@@ -26,6 +26,8 @@
 #include "KoOptimizedCompositeOpAlphaDarken128.h"
 #include "KoOptimizedCompositeOpOver32.h"
 #include "KoOptimizedCompositeOpOver128.h"
+#include "KoOptimizedCompositeOpSeparable32.h"
+#include "KoOptimizedCompositeOpSeparable128.h"
 
 #include <QString>
 #include "DebugPigment.h"
@@ -68,6 +70,22 @@ KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOver128>::create<Vc::
     return new KoOptimizedCompositeOpOver128<Vc::CurrentImplementation::current()>(param);
 }
 
+template<>
+template<>
+KoOptimizedSeparableCompositeOpFactoryPerArch<4>::ReturnType
+KoOptimizedSeparableCompositeOpFactoryPerArch<4>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedSeparableOp32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedSeparableCompositeOpFactoryPerArch<16>::ReturnType
+KoOptimizedSeparableCompositeOpFactoryPerArch<16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedSeparableOp128<Vc::CurrentImplementation::current()>(param);
+}
+
 #define __stringify(_s) #_s
 #define stringify(_s) __stringify(_s)
 
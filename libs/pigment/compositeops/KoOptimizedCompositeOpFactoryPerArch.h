@@ -50,6 +50,16 @@ struct KoOptimizedCompositeOpFactoryPerArch
     static ReturnType create(ParamType param);
 };
 
+template<int pixelSize>
+struct KoOptimizedSeparableCompositeOpFactoryPerArch
+{
+    typedef KoCompositeOp* ParamType;
+    typedef KoCompositeOp* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static ReturnType create(ParamType param);
+};
+
 struct KoReportCurrentArch
 {
     typedef void* ParamType;
@@ -56,6 +56,23 @@ KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOver128>::create<Vc::
     return new KoCompositeOpOver<KoRgbF32Traits>(param);
 }
 
+template<>
+template<>
+KoOptimizedSeparableCompositeOpFactoryPerArch<4>::ReturnType
+KoOptimizedSeparableCompositeOpFactoryPerArch<4>::create<Vc::ScalarImpl>(ParamType param)
+{
+    // the generic op is the scalar implementation already
+    return param;
+}
+
+template<>
+template<>
+KoOptimizedSeparableCompositeOpFactoryPerArch<16>::ReturnType
+KoOptimizedSeparableCompositeOpFactoryPerArch<16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return param;
+}
+
 template<>
 KoReportCurrentArch::ReturnType
 KoReportCurrentArch::create<Vc::ScalarImpl>(ParamType)
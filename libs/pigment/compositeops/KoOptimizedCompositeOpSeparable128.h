@@ -0,0 +1,200 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPSEPARABLE128_H_
+#define KOOPTIMIZEDCOMPOSITEOPSEPARABLE128_H_
+
+#include "KoCompositeOpBase.h"
+#include "KoCompositeOpRegistry.h"
+#include "KoStreamedMath.h"
+#include "KoOptimizedCompositeOpSeparable32.h"
+
+/**
+ * Compositor doing the same as KoCompositeOpGenericSC with all channels
+ * enabled for float RGBA pixels, on Vc::float_v::size() pixels at once.
+ */
+template<class BlendFunc>
+struct SeparableCompositor128 {
+    struct OptionalParams {
+        OptionalParams(const KoCompositeOp::ParameterInfo& params)
+        {
+            Q_UNUSED(params);
+        }
+    };
+
+    struct Pixel {
+        float red;
+        float green;
+        float blue;
+        float alpha;
+    };
+
+    // \see docs in SeparableCompositor32
+    template<class T>
+    static ALWAYS_INLINE T composeChannel(const T &src, const T &dst,
+                                          const T &dstWeight, const T &srcWeight, const T &blendWeight)
+    {
+        return dstWeight * dst + srcWeight * src + blendWeight * BlendFunc::blend(src, dst);
+    }
+
+    // \see docs in AlphaDarkenCompositor32
+    template<bool haveMask, bool src_aligned, Vc::Implementation _impl>
+    static ALWAYS_INLINE void compositeVector(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const OptionalParams &oparams)
+    {
+        Q_UNUSED(oparams);
+
+        const Vc::float_v uint8MaxRec1(1.0f / 255.0f);
+        const Vc::float_v zeroValue(Vc::Zero);
+        const Vc::float_v oneValue(Vc::One);
+
+        const Pixel *sp = reinterpret_cast<const Pixel*>(src);
+        Pixel *dp = reinterpret_cast<Pixel*>(dst);
+
+        Vc::float_v src_c1, src_c2, src_c3, src_alpha;
+
+        const Vc::float_v::IndexType indexes(Vc::IndexesFromZero);
+        Vc::InterleavedMemoryWrapper<Pixel, Vc::float_v> data(const_cast<Pixel*>(sp));
+        (src_c1, src_c2, src_c3, src_alpha) = data[indexes];
+
+        src_alpha *= Vc::float_v(opacity);
+
+        if (haveMask) {
+            const Vc::float_v mask_vec = KoStreamedMath<_impl>::fetch_mask_8(mask);
+            src_alpha *= mask_vec * uint8MaxRec1;
+        }
+
+        // a fully transparent source does not change the destination
+        if ((src_alpha == zeroValue).isFull()) {
+            return;
+        }
+
+        Vc::float_v dst_c1, dst_c2, dst_c3, dst_alpha;
+
+        Vc::InterleavedMemoryWrapper<Pixel, Vc::float_v> dataDest(dp);
+        (dst_c1, dst_c2, dst_c3, dst_alpha) = dataDest[indexes];
+
+        const Vc::float_v new_alpha = src_alpha + dst_alpha - src_alpha * dst_alpha;
+        const Vc::float_m transparent = new_alpha == zeroValue;
+        const Vc::float_v new_alpha_rec = oneValue / Vc::iif(transparent, oneValue, new_alpha);
+
+        const Vc::float_v dst_weight = (oneValue - src_alpha) * dst_alpha * new_alpha_rec;
+        const Vc::float_v src_weight = src_alpha * (oneValue - dst_alpha) * new_alpha_rec;
+        const Vc::float_v blend_weight = src_alpha * dst_alpha * new_alpha_rec;
+
+        Vc::float_v c1 = composeChannel(src_c1, dst_c1, dst_weight, src_weight, blend_weight);
+        Vc::float_v c2 = composeChannel(src_c2, dst_c2, dst_weight, src_weight, blend_weight);
+        Vc::float_v c3 = composeChannel(src_c3, dst_c3, dst_weight, src_weight, blend_weight);
+
+        c1 = Vc::iif(transparent, dst_c1, c1);
+        c2 = Vc::iif(transparent, dst_c2, c2);
+        c3 = Vc::iif(transparent, dst_c3, c3);
+
+        dataDest[indexes] = (c1, c2, c3, new_alpha);
+    }
+
+    template <bool haveMask, Vc::Implementation _impl>
+    static ALWAYS_INLINE void compositeOnePixelScalar(const quint8 *s, quint8 *d, const quint8 *mask, float opacity, const OptionalParams &oparams)
+    {
+        Q_UNUSED(oparams);
+        const qint32 alpha_pos = 3;
+        const float uint8Rec1 = 1.0 / 255.0;
+
+        const float *src = reinterpret_cast<const float*>(s);
+        float *dst = reinterpret_cast<float*>(d);
+
+        float srcAlpha = src[alpha_pos] * opacity;
+        if (haveMask) {
+            srcAlpha *= float(*mask) * uint8Rec1;
+        }
+
+        if (srcAlpha == 0.0) {
+            return;
+        }
+
+        const float dstAlpha = dst[alpha_pos];
+        const float newAlpha = srcAlpha + dstAlpha - srcAlpha * dstAlpha;
+
+        if (newAlpha != 0.0) {
+            const float newAlphaRec = 1.0 / newAlpha;
+
+            const float dstWeight = (1.0 - srcAlpha) * dstAlpha * newAlphaRec;
+            const float srcWeight = srcAlpha * (1.0 - dstAlpha) * newAlphaRec;
+            const float blendWeight = srcAlpha * dstAlpha * newAlphaRec;
+
+            for (int i = 0; i < alpha_pos; ++i) {
+                dst[i] = composeChannel<float>(src[i], dst[i], dstWeight, srcWeight, blendWeight);
+            }
+        }
+        dst[alpha_pos] = newAlpha;
+    }
+};
+
+/**
+ * A vectorized version of a KoCompositeOpGenericSC for 16 byte colorspaces
+ * with the alpha channel placed at the last float of the pixel: C1_C2_C3_A.
+ *
+ * Only compositing with all channels enabled is vectorized, otherwise
+ * the generic op passed to the constructor is used.
+ */
+template<Vc::Implementation _impl, class BlendFunc>
+class KoOptimizedCompositeOpSeparable128 : public KoCompositeOp
+{
+public:
+    /// takes ownership of \p genericOp
+    KoOptimizedCompositeOpSeparable128(KoCompositeOp *genericOp)
+        : KoCompositeOp(genericOp->colorSpace(), genericOp->id(), genericOp->description(), genericOp->category())
+        , m_genericOp(genericOp)
+    {
+    }
+
+    virtual ~KoOptimizedCompositeOpSeparable128()
+    {
+        delete m_genericOp;
+    }
+
+    using KoCompositeOp::composite;
+
+    virtual void composite(const KoCompositeOp::ParameterInfo& params) const
+    {
+        if (!params.channelFlags.isEmpty() &&
+            params.channelFlags != QBitArray(4, true)) {
+
+            m_genericOp->composite(params);
+        } else if (params.maskRowStart) {
+            KoStreamedMath<_impl>::template genericComposite128<true, false, SeparableCompositor128<BlendFunc> >(params);
+        } else {
+            KoStreamedMath<_impl>::template genericComposite128<false, false, SeparableCompositor128<BlendFunc> >(params);
+        }
+    }
+
+private:
+    KoCompositeOp *m_genericOp;
+};
+
+/**
+ * Returns a vectorized replacement of the KoCompositeOpGenericSC \p genericOp of
+ * a float RGBA colorspace, which it takes ownership of, or \p genericOp itself
+ * if its blending function is not vectorized.
+ */
+template<Vc::Implementation _impl>
+KoCompositeOp* createOptimizedSeparableOp128(KoCompositeOp *genericOp)
+{
+    return KoSeparableBlend::createOptimizedOp<KoOptimizedCompositeOpSeparable128, _impl,
+                                               KoSeparableBlend::FloatRange>(genericOp);
+}
+
+#endif // KOOPTIMIZEDCOMPOSITEOPSEPARABLE128_H_
@@ -0,0 +1,318 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPSEPARABLE32_H_
+#define KOOPTIMIZEDCOMPOSITEOPSEPARABLE32_H_
+
+#include "KoCompositeOpBase.h"
+#include "KoCompositeOpRegistry.h"
+#include "KoStreamedMath.h"
+
+/**
+ * Blending functions of the separable composite ops in KoCompositeOpFunctions.h.
+ * They are written once for floats and for Vc::float_v, the helpers below
+ * dispatch to the right operation.
+ *
+ * The functions are parametrized with the range of the color values,
+ * Uint8Range for 8-bit channels converted to float and FloatRange for
+ * float channels, see KoOptimizedCompositeOpSeparable128.h.
+ */
+namespace KoSeparableBlend {
+
+static ALWAYS_INLINE float min(float a, float b) { return qMin(a, b); }
+static ALWAYS_INLINE float max(float a, float b) { return qMax(a, b); }
+static ALWAYS_INLINE float select(bool condition, float a, float b) { return condition ? a : b; }
+
+static ALWAYS_INLINE Vc::float_v min(Vc::float_v::AsArg a, Vc::float_v::AsArg b) { return Vc::min(a, b); }
+static ALWAYS_INLINE Vc::float_v max(Vc::float_v::AsArg a, Vc::float_v::AsArg b) { return Vc::max(a, b); }
+static ALWAYS_INLINE Vc::float_v select(const Vc::float_m &condition, Vc::float_v::AsArg a, Vc::float_v::AsArg b) { return Vc::iif(condition, a, b); }
+
+/// color values in [0, 255], clamped like KoColorSpaceMaths<quint8>::clamp()
+struct Uint8Range {
+    static ALWAYS_INLINE float unitValue() { return 255.0f; }
+    static ALWAYS_INLINE float unitValueRec() { return 1.0f / 255.0f; }
+    // halfValue of 8-bit channels is 127, the values in between never occur
+    static ALWAYS_INLINE float halfValue() { return 127.5f; }
+    static const bool clamped = true;
+};
+
+/// color values in [0, 1], not clamped like KoColorSpaceMaths<float>::clamp()
+struct FloatRange {
+    static ALWAYS_INLINE float unitValue() { return 1.0f; }
+    static ALWAYS_INLINE float unitValueRec() { return 1.0f; }
+    static ALWAYS_INLINE float halfValue() { return 0.5f; }
+    static const bool clamped = false;
+};
+
+/// \see cfMultiply
+template<class Range>
+struct Multiply {
+    template<class T> static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return src * dst * T(Range::unitValueRec());
+    }
+};
+
+/// \see cfScreen
+template<class Range>
+struct Screen {
+    template<class T> static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return src + dst - src * dst * T(Range::unitValueRec());
+    }
+};
+
+/// \see cfOverlay, which is cfHardLight with src and dst swapped
+template<class Range>
+struct Overlay {
+    template<class T> static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        const T dst2 = dst + dst;
+        const T multiply = dst2 * src * T(Range::unitValueRec());
+        const T dst2Minus1 = dst2 - T(Range::unitValue());
+        const T screen = dst2Minus1 + src - dst2Minus1 * src * T(Range::unitValueRec());
+        return select(dst > T(Range::halfValue()), screen, multiply);
+    }
+};
+
+/// \see cfDarkenOnly
+template<class Range>
+struct Darken {
+    template<class T> static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return min(src, dst);
+    }
+};
+
+/// \see cfLightenOnly
+template<class Range>
+struct Lighten {
+    template<class T> static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return max(src, dst);
+    }
+};
+
+/// \see cfAddition
+template<class Range>
+struct Addition {
+    template<class T> static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return Range::clamped ? min(src + dst, T(Range::unitValue())) : src + dst;
+    }
+};
+
+/// \see cfSubtract
+template<class Range>
+struct Subtract {
+    template<class T> static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return Range::clamped ? max(dst - src, T(0.0f)) : dst - src;
+    }
+};
+
+/**
+ * Returns a KoOptimizedCompositeOp for \p genericOp, which it takes ownership of,
+ * or \p genericOp itself if its blending function is not vectorized.
+ */
+template<template<Vc::Implementation, class> class KoOptimizedCompositeOp, Vc::Implementation _impl, class Range>
+KoCompositeOp* createOptimizedOp(KoCompositeOp *genericOp)
+{
+    const QString id = genericOp->id();
+
+    if (id == COMPOSITE_MULT) {
+        return new KoOptimizedCompositeOp<_impl, Multiply<Range> >(genericOp);
+    } else if (id == COMPOSITE_SCREEN) {
+        return new KoOptimizedCompositeOp<_impl, Screen<Range> >(genericOp);
+    } else if (id == COMPOSITE_OVERLAY) {
+        return new KoOptimizedCompositeOp<_impl, Overlay<Range> >(genericOp);
+    } else if (id == COMPOSITE_DARKEN) {
+        return new KoOptimizedCompositeOp<_impl, Darken<Range> >(genericOp);
+    } else if (id == COMPOSITE_LIGHTEN) {
+        return new KoOptimizedCompositeOp<_impl, Lighten<Range> >(genericOp);
+    } else if (id == COMPOSITE_ADD || id == COMPOSITE_LINEAR_DODGE) {
+        return new KoOptimizedCompositeOp<_impl, Addition<Range> >(genericOp);
+    } else if (id == COMPOSITE_SUBTRACT) {
+        return new KoOptimizedCompositeOp<_impl, Subtract<Range> >(genericOp);
+    }
+
+    return genericOp;
+}
+
+}
+
+/**
+ * Compositor doing the same as KoCompositeOpGenericSC with all channels
+ * enabled, in floating point and on Vc::float_v::size() pixels at once.
+ */
+template<class BlendFunc>
+struct SeparableCompositor32 {
+    struct OptionalParams {
+        OptionalParams(const KoCompositeOp::ParameterInfo& params)
+        {
+            Q_UNUSED(params);
+        }
+    };
+
+    /**
+     * The color of the result is
+     *
+     *     ((1 - sa) * da * d + sa * (1 - da) * s + sa * da * blend(s, d)) / newAlpha
+     *
+     * with the normalized alpha values sa and da, see Arithmetic::blend().
+     */
+    template<class T>
+    static ALWAYS_INLINE T composeChannel(const T &src, const T &dst,
+                                          const T &dstWeight, const T &srcWeight, const T &blendWeight)
+    {
+        return dstWeight * dst + srcWeight * src + blendWeight * BlendFunc::blend(src, dst);
+    }
+
+    // \see docs in AlphaDarkenCompositor32
+    template<bool haveMask, bool src_aligned, Vc::Implementation _impl>
+    static ALWAYS_INLINE void compositeVector(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const OptionalParams &oparams)
+    {
+        Q_UNUSED(oparams);
+
+        const Vc::float_v uint8Max(255.0f);
+        const Vc::float_v uint8MaxRec1(1.0f / 255.0f);
+        const Vc::float_v zeroValue(Vc::Zero);
+        const Vc::float_v oneValue(Vc::One);
+
+        Vc::float_v src_alpha = KoStreamedMath<_impl>::template fetch_alpha_32<src_aligned>(src);
+        src_alpha *= Vc::float_v(opacity) * uint8MaxRec1;
+
+        if (haveMask) {
+            const Vc::float_v mask_vec = KoStreamedMath<_impl>::fetch_mask_8(mask);
+            src_alpha *= mask_vec * uint8MaxRec1;
+        }
+
+        // a fully transparent source does not change the destination
+        if ((src_alpha == zeroValue).isFull()) {
+            return;
+        }
+
+        const Vc::float_v dst_alpha = KoStreamedMath<_impl>::template fetch_alpha_32<true>(dst) * uint8MaxRec1;
+
+        Vc::float_v src_c1, src_c2, src_c3;
+        Vc::float_v dst_c1, dst_c2, dst_c3;
+        KoStreamedMath<_impl>::template fetch_colors_32<src_aligned>(src, src_c1, src_c2, src_c3);
+        KoStreamedMath<_impl>::template fetch_colors_32<true>(dst, dst_c1, dst_c2, dst_c3);
+
+        const Vc::float_v new_alpha = src_alpha + dst_alpha - src_alpha * dst_alpha;
+        /**
+         * new_alpha is zero only where both alpha values are zero, the colors
+         * of those pixels are kept like KoCompositeOpGenericSC does
+         */
+        const Vc::float_m transparent = new_alpha == zeroValue;
+        const Vc::float_v new_alpha_rec = oneValue / Vc::iif(transparent, oneValue, new_alpha);
+
+        const Vc::float_v dst_weight = (oneValue - src_alpha) * dst_alpha * new_alpha_rec;
+        const Vc::float_v src_weight = src_alpha * (oneValue - dst_alpha) * new_alpha_rec;
+        const Vc::float_v blend_weight = src_alpha * dst_alpha * new_alpha_rec;
+
+        Vc::float_v c1 = composeChannel(src_c1, dst_c1, dst_weight, src_weight, blend_weight);
+        Vc::float_v c2 = composeChannel(src_c2, dst_c2, dst_weight, src_weight, blend_weight);
+        Vc::float_v c3 = composeChannel(src_c3, dst_c3, dst_weight, src_weight, blend_weight);
+
+        c1 = Vc::iif(transparent, dst_c1, c1);
+        c2 = Vc::iif(transparent, dst_c2, c2);
+        c3 = Vc::iif(transparent, dst_c3, c3);
+
+        KoStreamedMath<_impl>::write_channels_32(dst, new_alpha * uint8Max, c1, c2, c3);
+    }
+
+    template <bool haveMask, Vc::Implementation _impl>
+    static ALWAYS_INLINE void compositeOnePixelScalar(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const OptionalParams &oparams)
+    {
+        Q_UNUSED(oparams);
+        const qint32 alpha_pos = 3;
+        const float uint8Rec1 = 1.0 / 255.0;
+
+        float srcAlpha = src[alpha_pos] * opacity * uint8Rec1;
+        if (haveMask) {
+            srcAlpha *= float(*mask) * uint8Rec1;
+        }
+
+        if (srcAlpha == 0.0) {
+            return;
+        }
+
+        const float dstAlpha = dst[alpha_pos] * uint8Rec1;
+        const float newAlpha = srcAlpha + dstAlpha - srcAlpha * dstAlpha;
+        const float newAlphaRec = 1.0 / newAlpha;
+
+        const float dstWeight = (1.0 - srcAlpha) * dstAlpha * newAlphaRec;
+        const float srcWeight = srcAlpha * (1.0 - dstAlpha) * newAlphaRec;
+        const float blendWeight = srcAlpha * dstAlpha * newAlphaRec;
+
+        for (int i = 0; i < alpha_pos; ++i) {
+            dst[i] = KoStreamedMath<_impl>::round_float_to_uint(
+                composeChannel<float>(src[i], dst[i], dstWeight, srcWeight, blendWeight));
+        }
+        dst[alpha_pos] = KoStreamedMath<_impl>::round_float_to_uint(newAlpha * 255.0);
+    }
+};
+
+/**
+ * A vectorized version of a KoCompositeOpGenericSC for 4 byte colorspaces
+ * with the alpha channel placed at the last byte of the pixel: C1_C2_C3_A.
+ *
+ * Only compositing with all channels enabled is vectorized, otherwise
+ * the generic op passed to the constructor is used.
+ */
+template<Vc::Implementation _impl, class BlendFunc>
+class KoOptimizedCompositeOpSeparable32 : public KoCompositeOp
+{
+public:
+    /// takes ownership of \p genericOp
+    KoOptimizedCompositeOpSeparable32(KoCompositeOp *genericOp)
+        : KoCompositeOp(genericOp->colorSpace(), genericOp->id(), genericOp->description(), genericOp->category())
+        , m_genericOp(genericOp)
+    {
+    }
+
+    virtual ~KoOptimizedCompositeOpSeparable32()
+    {
+        delete m_genericOp;
+    }
+
+    using KoCompositeOp::composite;
+
+    virtual void composite(const KoCompositeOp::ParameterInfo& params) const
+    {
+        if (!params.channelFlags.isEmpty() &&
+            params.channelFlags != QBitArray(4, true)) {
+
+            m_genericOp->composite(params);
+        } else if (params.maskRowStart) {
+            KoStreamedMath<_impl>::template genericComposite32<true, false, SeparableCompositor32<BlendFunc> >(params);
+        } else {
+            KoStreamedMath<_impl>::template genericComposite32<false, false, SeparableCompositor32<BlendFunc> >(params);
+        }
+    }
+
+private:
+    KoCompositeOp *m_genericOp;
+};
+
+/**
+ * Returns a vectorized replacement of the KoCompositeOpGenericSC \p genericOp, which
+ * it takes ownership of, or \p genericOp itself if its blending function is not
+ * vectorized.
+ */
+template<Vc::Implementation _impl>
+KoCompositeOp* createOptimizedSeparableOp32(KoCompositeOp *genericOp)
+{
+    return KoSeparableBlend::createOptimizedOp<KoOptimizedCompositeOpSeparable32, _impl,
+                                               KoSeparableBlend::Uint8Range>(genericOp);
+}
+
+#endif // KOOPTIMIZEDCOMPOSITEOPSEPARABLE32_H_
@@ -0,0 +1,224 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "TestKoOptimizedCompositeOps.h"
+
+#include "../compositeops/KoCompositeOpGeneric.h"
+#include <KoOptimizedCompositeOpFactory.h>
+
+#include <KoColorSpaceTraits.h>
+#include <KoRgbColorSpaceTraits.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoCompositeOpRegistry.h>
+
+#include <QTest>
+#include <QScopedPointer>
+#include <QVector>
+
+// odd sizes, so the rows start at different alignments and have scalar tails
+static const int COLS = 67;
+static const int ROWS = 5;
+
+template<class Traits>
+static KoCompositeOp* createGenericOp(const KoColorSpace *cs, const QString &id)
+{
+    typedef typename Traits::channels_type Arg;
+
+    if (id == COMPOSITE_MULT) {
+        return new KoCompositeOpGenericSC<Traits, &cfMultiply<Arg> >(cs, id, id, id);
+    } else if (id == COMPOSITE_SCREEN) {
+        return new KoCompositeOpGenericSC<Traits, &cfScreen<Arg> >(cs, id, id, id);
+    } else if (id == COMPOSITE_OVERLAY) {
+        return new KoCompositeOpGenericSC<Traits, &cfOverlay<Arg> >(cs, id, id, id);
+    } else if (id == COMPOSITE_DARKEN) {
+        return new KoCompositeOpGenericSC<Traits, &cfDarkenOnly<Arg> >(cs, id, id, id);
+    } else if (id == COMPOSITE_LIGHTEN) {
+        return new KoCompositeOpGenericSC<Traits, &cfLightenOnly<Arg> >(cs, id, id, id);
+    } else if (id == COMPOSITE_ADD) {
+        return new KoCompositeOpGenericSC<Traits, &cfAddition<Arg> >(cs, id, id, id);
+    } else {
+        return new KoCompositeOpGenericSC<Traits, &cfSubtract<Arg> >(cs, id, id, id);
+    }
+}
+
+/**
+ * Fills \p data with reproducible pixels. Every few pixels are fully
+ * transparent or fully opaque, the rest have random alpha values.
+ */
+template<class Traits>
+static void fillPixels(QVector<typename Traits::channels_type> &data, quint32 seed)
+{
+    typedef typename Traits::channels_type channels_type;
+
+    for (int i = 0; i < data.size(); ++i) {
+        seed = seed * 1103515245 + 12345;
+        quint8 value = (seed >> 16) & 0xFF;
+
+        if (i % Traits::channels_nb == Traits::alpha_pos) {
+            const int pixel = i / Traits::channels_nb;
+            if (pixel % 7 == 0) {
+                value = 0;
+            } else if (pixel % 5 == 0) {
+                value = 255;
+            }
+        }
+        data[i] = KoColorSpaceMaths<quint8, channels_type>::scaleToA(value);
+    }
+}
+
+template<class Traits>
+static void compareWithGenericOp(KoCompositeOp *(*createOptimizedOp)(KoCompositeOp*),
+                                 double tolerance)
+{
+    typedef typename Traits::channels_type channels_type;
+
+    QFETCH(QString, id);
+    QFETCH(qreal, opacity);
+    QFETCH(bool, useMask);
+    QFETCH(bool, fill);
+    QFETCH(QBitArray, channelFlags);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    QScopedPointer<KoCompositeOp> genericOp(createGenericOp<Traits>(cs, id));
+    QScopedPointer<KoCompositeOp> optimizedOp(createOptimizedOp(createGenericOp<Traits>(cs, id)));
+
+    const int channels = Traits::channels_nb;
+    const int rowStride = COLS * Traits::pixelSize;
+
+    // one spare pixel, the source starts one pixel after the buffer to be unaligned to dst
+    QVector<channels_type> src((COLS * ROWS + 1) * channels);
+    QVector<channels_type> dst(COLS * ROWS * channels);
+    QVector<quint8> mask(COLS * ROWS);
+    fillPixels<Traits>(src, 1);
+    fillPixels<Traits>(dst, 2);
+    for (int i = 0; i < mask.size(); ++i) {
+        mask[i] = i % 3 ? (i * 37) & 0xFF : 255;
+    }
+    QVector<channels_type> expected = dst;
+
+    KoCompositeOp::ParameterInfo params;
+    params.srcRowStart = reinterpret_cast<const quint8*>(src.constData() + channels);
+    params.srcRowStride = fill ? 0 : rowStride;
+    params.maskRowStart = useMask ? mask.constData() : 0;
+    params.maskRowStride = useMask ? COLS : 0;
+    params.rows = ROWS;
+    params.cols = COLS;
+    params.opacity = opacity;
+    params.channelFlags = channelFlags;
+
+    params.dstRowStart = reinterpret_cast<quint8*>(expected.data());
+    params.dstRowStride = rowStride;
+    genericOp->composite(params);
+
+    params.dstRowStart = reinterpret_cast<quint8*>(dst.data());
+    optimizedOp->composite(params);
+
+    /**
+     * The 8-bit generic op rounds every intermediate value, which the division
+     * by the new alpha magnifies for nearly transparent pixels. So compare the
+     * alpha and the premultiplied colors. These differ by less than four times
+     * the tolerance: one rounding of the alpha and up to three of the color.
+     */
+    const double unit = KoColorSpaceMathsTraits<channels_type>::unitValue;
+    for (int pixel = 0; pixel < COLS * ROWS; ++pixel) {
+        const channels_type *e = expected.constData() + pixel * channels;
+        const channels_type *r = dst.constData() + pixel * channels;
+        const double expectedAlpha = e[Traits::alpha_pos] / unit;
+        const double resultAlpha = r[Traits::alpha_pos] / unit;
+
+        QVERIFY2(qAbs(double(e[Traits::alpha_pos]) - double(r[Traits::alpha_pos])) <= tolerance,
+                 qPrintable(QString("pixel %1: alpha %2 != %3").arg(pixel)
+                            .arg(double(e[Traits::alpha_pos])).arg(double(r[Traits::alpha_pos]))));
+
+        for (int i = 0; i < channels; ++i) {
+            if (i == Traits::alpha_pos) continue;
+
+            const double expectedColor = e[i] * expectedAlpha;
+            const double resultColor = r[i] * resultAlpha;
+            QVERIFY2(qAbs(expectedColor - resultColor) < 4 * tolerance,
+                     qPrintable(QString("pixel %1 channel %2: %3 != %4 (alpha %5, %6)")
+                                .arg(pixel).arg(i).arg(double(e[i])).arg(double(r[i]))
+                                .arg(double(e[Traits::alpha_pos])).arg(double(r[Traits::alpha_pos]))));
+        }
+    }
+}
+
+static void addSeparableRows()
+{
+    QTest::addColumn<QString>("id");
+    QTest::addColumn<qreal>("opacity");
+    QTest::addColumn<bool>("useMask");
+    QTest::addColumn<bool>("fill");
+    QTest::addColumn<QBitArray>("channelFlags");
+
+    const QStringList ids = QStringList() << COMPOSITE_MULT << COMPOSITE_SCREEN << COMPOSITE_OVERLAY
+                                          << COMPOSITE_DARKEN << COMPOSITE_LIGHTEN
+                                          << COMPOSITE_ADD << COMPOSITE_SUBTRACT;
+
+    QBitArray alphaLocked(4, true);
+    alphaLocked.clearBit(3);
+    QBitArray secondChannelOff(4, true);
+    secondChannelOff.clearBit(1);
+
+    QList<QPair<QString, QBitArray> > flags;
+    flags << qMakePair(QString("no flags"), QBitArray())
+          << qMakePair(QString("all channels"), QBitArray(4, true))
+          << qMakePair(QString("alpha locked"), alphaLocked)
+          << qMakePair(QString("channel 1 off"), secondChannelOff);
+
+    const QList<qreal> opacities = QList<qreal>() << 1.0 << 0.5 << 0.2;
+
+    foreach (const QString &id, ids) {
+        foreach (qreal opacity, opacities) {
+            for (int useMask = 0; useMask < 2; ++useMask) {
+                for (int fill = 0; fill < 2; ++fill) {
+                    for (int f = 0; f < flags.size(); ++f) {
+                        const QString name = QString("%1 opacity %2%3%4 %5")
+                            .arg(id).arg(opacity)
+                            .arg(useMask ? " mask" : "").arg(fill ? " fill" : "")
+                            .arg(flags[f].first);
+                        QTest::newRow(name.toLatin1())
+                            << id << opacity << bool(useMask) << bool(fill) << flags[f].second;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void TestKoOptimizedCompositeOps::testSeparable32_data()
+{
+    addSeparableRows();
+}
+
+void TestKoOptimizedCompositeOps::testSeparable32()
+{
+    // the generic op uses integer arithmetics, the optimized one rounds once
+    compareWithGenericOp<KoBgrU8Traits>(&KoOptimizedCompositeOpFactory::createSeparableOp32, 1.0);
+}
+
+void TestKoOptimizedCompositeOps::testSeparable128_data()
+{
+    addSeparableRows();
+}
+
+void TestKoOptimizedCompositeOps::testSeparable128()
+{
+    // the generic op computes in double, the optimized one in float
+    compareWithGenericOp<KoRgbF32Traits>(&KoOptimizedCompositeOpFactory::createSeparableOp128, 1e-5);
+}
+
+QTEST_GUILESS_MAIN(TestKoOptimizedCompositeOps)
@@ -58,6 +58,7 @@ public:
     KoTextBlockPaintStrategyBase *paintStrategy;
     QMap<KoTextBlockData::MarkupType, QVector<MarkupRange> > markupRangesMap;
     QMap<KoTextBlockData::MarkupType, bool> layoutedMarkupRanges;
+    KoTextBlockData::LayoutCache layoutCache;
 };
 
 KoTextBlockData::KoTextBlockData(QTextBlock &block)
@@ -159,6 +160,21 @@ QVector<KoTextBlockData::MarkupRange>::Iterator KoTextBlockData::markupsEnd(Mark
     return d->markupRangesMap[type].end();
 }
 
+void KoTextBlockData::setLayoutCache(const LayoutCache &cache)
+{
+    d->layoutCache = cache;
+}
+
+KoTextBlockData::LayoutCache KoTextBlockData::layoutCache() const
+{
+    return d->layoutCache;
+}
+
+void KoTextBlockData::invalidateLayoutCache()
+{
+    d->layoutCache.revision = -1;
+}
+
 bool KoTextBlockData::hasCounterData() const
 {
     return d->counterWidth >= 0 && (!d->counterPlainText.isNull() || d->counterIsImage);
@@ -74,6 +74,30 @@ public:
         Grammar
     };
 
+    /**
+     * The geometry the lines of this paragraph were laid out with the last time
+     * the whole paragraph fit into one area. As long as the text and the horizontal
+     * geometry stay the same the layout can reuse the lines by just moving them.
+     */
+    struct LayoutCache {
+        LayoutCache() : revision(-1), left(0), width(0), indent(0), rightToLeft(false), top(0), bottom(0), neededWidth(0) {}
+        /// the QTextBlock::revision() the lines were created for, or -1 if invalid
+        int revision;
+        /// the horizontal position of the text
+        qreal left;
+        /// the available width
+        qreal width;
+        /// the indentation of the first line
+        qreal indent;
+        bool rightToLeft;
+        /// the y position of the first line
+        qreal top;
+        /// the y position just below the last line
+        qreal bottom;
+        /// the width needed by the widest line
+        qreal neededWidth;
+    };
+
     explicit KoTextBlockData(QTextBlock &block);
     explicit KoTextBlockData(QTextBlockUserData *userData);
     virtual ~KoTextBlockData();
@@ -107,6 +131,13 @@ public:
     QVector<MarkupRange>::Iterator markupsBegin(MarkupType type);
     QVector<MarkupRange>::Iterator markupsEnd(MarkupType type);
 
+    /// set the geometry the current lines of the paragraph were laid out with
+    void setLayoutCache(const LayoutCache &cache);
+    /// return the geometry the current lines of the paragraph were laid out with
+    LayoutCache layoutCache() const;
+    /// mark the current lines of the paragraph as not reusable
+    void invalidateLayoutCache();
+
     /**
      * Clear the counter and set everything to default values.
      */
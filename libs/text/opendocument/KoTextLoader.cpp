@@ -138,6 +138,8 @@ public:
 
     int loadSpanLevel;
     int loadSpanInitialPos;
+    // plain text of the current span, collected so it is inserted with a single call
+    QString pendingText;
 
     QVector<QString> nameSpacesList;
     QList<KoSection *> openingSections;
@@ -154,6 +156,8 @@ public:
     void setCurrentList(KoList *currentList, int level);
     /// level is between 1 and 10
     KoList *previousList(int level);
+    /// insert the collected plain text at the cursor
+    void insertPendingText(QTextCursor &cursor);
 
     explicit Private(KoShapeLoadingContext &context, KoShape *s)
         : context(context),
@@ -186,6 +190,14 @@ public:
     KoList *list(const QTextDocument *document, KoListStyle *listStyle, bool mergeSimilarStyledList);
 };
 
+void KoTextLoader::Private::insertPendingText(QTextCursor &cursor)
+{
+    if (!pendingText.isEmpty()) {
+        cursor.insertText(pendingText);
+        pendingText.clear();
+    }
+}
+
 KoList *KoTextLoader::Private::list(const QTextDocument *document, KoListStyle *listStyle, bool mergeSimilarStyledList)
 {
     //TODO: Remove mergeSimilarStyledList parameter by finding a way to put the numbered-paragraphs of same level
@@ -896,15 +908,12 @@ void KoTextLoader::loadText(const QString &fulltext, QTextCursor &cursor,
         // we can remove the leading space in the next text
         *stripLeadingSpace = text[text.length() - 1].isSpace();
 
-        cursor.insertText(text);
+        // the text is inserted into the document by loadSpan once a tag needs it there
+        d->pendingText.append(text);
 
         if (d->loadSpanLevel == 1 && isLastNode
-                && cursor.position() > d->loadSpanInitialPos) {
-            QTextCursor tempCursor(cursor);
-            tempCursor.movePosition(QTextCursor::Left, QTextCursor::KeepAnchor, 1); // select last char loaded
-            if (tempCursor.selectedText() == " " && *stripLeadingSpace) {            // if it's a collapsed blankspace
-                tempCursor.removeSelectedText();                                    // remove it
-            }
+                && d->pendingText.endsWith(QLatin1Char(' ')) && *stripLeadingSpace) { // if it's a collapsed blankspace
+            d->pendingText.chop(1);                                                   // remove it
         }
     }
 }
@@ -937,6 +946,14 @@ void KoTextLoader::loadSpan(const KoXmlElement &element, QTextCursor &cursor, bo
             d->endCharStyle = 0;
         }
 
+        // consecutive text, spaces, tabs and line breaks are collected and inserted at once,
+        // everything else works on the cursor and needs the text loaded so far in the document
+        const bool isPlainText = node.isText()
+                || (isTextNS && (localName == "s" || localName == "tab" || localName == "line-break"));
+        if (!isPlainText) {
+            d->insertPendingText(cursor);
+        }
+
         if (node.isText()) {
             bool isLastNode = node.nextSibling().isNull();
             loadText(node.toText().data(), cursor, stripLeadingSpace,
@@ -967,14 +984,14 @@ void KoTextLoader::loadSpan(const KoXmlElement &element, QTextCursor &cursor, bo
             if (ts.hasAttributeNS(KoXmlNS::text, "c")) {
                 howmany = ts.attributeNS(KoXmlNS::text, "c", QString()).toInt();
             }
-            cursor.insertText(QString().fill(32, howmany));
+            d->pendingText.append(QString().fill(32, howmany));
             *stripLeadingSpace = false;
         } else if ( (isTextNS && localName == "note")) { // text:note
             loadNote(ts, cursor);
         } else if (isTextNS && localName == "bibliography-mark") { // text:bibliography-mark
             loadCite(ts,cursor);
         } else if (isTextNS && localName == "tab") { // text:tab
-            cursor.insertText("\t");
+            d->pendingText.append(QLatin1Char('\t'));
             *stripLeadingSpace = false;
         } else if (isTextNS && localName == "a") { // text:a
             QString target = ts.attributeNS(KoXmlNS::xlink, "href");
@@ -1002,7 +1019,7 @@ void KoTextLoader::loadSpan(const KoXmlElement &element, QTextCursor &cursor, bo
 #ifdef KOOPENDOCUMENTLOADER_DEBUG
             debugText << "  <line-break> Node localName=" << localName;
 #endif
-            cursor.insertText(QChar(0x2028));
+            d->pendingText.append(QChar(0x2028));
             *stripLeadingSpace = false;
         } else if (isTextNS && localName == "soft-page-break") { // text:soft-page-break
             KoInlineTextObjectManager *textObjectManager = KoTextDocument(cursor.block().document()).inlineTextObjectManager();
@@ -1182,6 +1199,7 @@ void KoTextLoader::loadSpan(const KoXmlElement &element, QTextCursor &cursor, bo
 #endif
         }
     }
+    d->insertPendingText(cursor);
     --d->loadSpanLevel;
 }
 
@@ -137,7 +137,8 @@ private:
     void loadSection(const KoXmlElement &element, QTextCursor &cursor);
 
     /**
-    * Load the text into the \p cursor .
+    * Load the text into the \p cursor . The text is inserted together with
+    * the following plain text of the span when loadSpan() needs it in the document.
     */
     void loadText(const QString &text, QTextCursor &cursor,
                   bool *stripLeadingSpace, bool isLastNode);
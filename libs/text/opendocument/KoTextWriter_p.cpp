@@ -264,7 +264,16 @@ void KoTextWriter::Private::closeTagRegion()
 
 QString KoTextWriter::Private::saveParagraphStyle(const QTextBlock &block)
 {
-    return KoTextWriter::saveParagraphStyle(block, styleManager, context);
+    QHash<FormatIndexes, QString> &styleNames = paragraphStyleNames[block.document()];
+    const FormatIndexes formats(block.blockFormatIndex(), block.charFormatIndex());
+    QHash<FormatIndexes, QString>::const_iterator it = styleNames.constFind(formats);
+    if (it != styleNames.constEnd()) {
+        return it.value();
+    }
+
+    const QString styleName = KoTextWriter::saveParagraphStyle(block, styleManager, context);
+    styleNames.insert(formats, styleName);
+    return styleName;
 }
 
 QString KoTextWriter::Private::saveParagraphStyle(const QTextBlockFormat &blockFormat, const QTextCharFormat &charFormat)
@@ -305,6 +314,20 @@ QString KoTextWriter::Private::saveCharacterStyle(const QTextCharFormat &charFor
     return generatedName;
 }
 
+QString KoTextWriter::Private::saveCharacterStyle(const QTextFragment &fragment, const QTextBlock &block)
+{
+    QHash<FormatIndexes, QString> &styleNames = characterStyleNames[block.document()];
+    const FormatIndexes formats(fragment.charFormatIndex(), block.charFormatIndex());
+    QHash<FormatIndexes, QString>::const_iterator it = styleNames.constFind(formats);
+    if (it != styleNames.constEnd()) {
+        return it.value();
+    }
+
+    const QString styleName = saveCharacterStyle(fragment.charFormat(), block.charFormat());
+    styleNames.insert(formats, styleName);
+    return styleName;
+}
+
 QString KoTextWriter::Private::saveTableStyle(const QTextTable& table)
 {
     KoTableStyle *originalTableStyle = styleManager->tableStyle(table.format().intProperty(KoTableStyle::StyleId));
@@ -567,7 +590,7 @@ void KoTextWriter::Private::saveParagraph(const QTextBlock &block, int from, int
                 bool saveSpan = dynamic_cast<KoVariable*>(inlineObject) != 0;
 
                 if (saveSpan) {
-                    QString styleName = saveCharacterStyle(charFormat, blockCharFormat);
+                    QString styleName = saveCharacterStyle(currentFragment, block);
                     if (!styleName.isEmpty()) {
                         writer->startElement("text:span", false);
                         writer->addAttribute("text:style-name", styleName);
@@ -611,7 +634,7 @@ void KoTextWriter::Private::saveParagraph(const QTextBlock &block, int from, int
                 }*/
             } else {
                 // Normal block, easier to handle
-                QString styleName = saveCharacterStyle(charFormat, blockCharFormat);
+                QString styleName = saveCharacterStyle(currentFragment, block);
 
                 TagInformation fragmentTagInformation;
                 if (!styleName.isEmpty() /*&& !identical*/) {
@@ -43,6 +43,7 @@ class QTextDocument;
 class QTextTable;
 class QTextTableCellFormat;
 class QTextList;
+class QTextFragment;
 class QTextStream;
 
 /**
@@ -129,6 +130,7 @@ private:
     QString saveParagraphStyle(const QTextBlock &block);
     QString saveParagraphStyle(const QTextBlockFormat &blockFormat, const QTextCharFormat &charFormat);
     QString saveCharacterStyle(const QTextCharFormat &charFormat, const QTextCharFormat &blockCharFormat);
+    QString saveCharacterStyle(const QTextFragment &fragment, const QTextBlock &block);
     QString saveTableStyle(const QTextTable &table);
     QString saveTableColumnStyle(const KoTableColumnStyle &columnStyle, int columnNumber, const QString &tableStyleName);
     QString saveTableRowStyle(const KoTableRowStyle &rowStyle, int rowNumber, const QString &tableStyleName);
@@ -175,6 +177,13 @@ private:
     QMap<KoList *, QString> listXmlIds;
 
     QMap<KoList *, QString> numberedParagraphListIds;
+
+    // The style names already generated for the formats of a document, so every distinct
+    // format is turned into a style only once. Identical formats share one index in
+    // the format collection of the document.
+    typedef QPair<int, int> FormatIndexes;
+    QHash<const QTextDocument *, QHash<FormatIndexes, QString> > paragraphStyleNames; // block format, block char format
+    QHash<const QTextDocument *, QHash<FormatIndexes, QString> > characterStyleNames; // char format, block char format
 };
 
 #endif // KOTEXTWRITER_P_H
@@ -53,6 +53,7 @@
 #include <QTextBlock>
 #include <QTextTable>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QList>
 
 extern int qt_defaultDpiY();
@@ -64,6 +65,9 @@ KoInlineObjectExtent::KoInlineObjectExtent(qreal ascent, qreal descent)
 {
 }
 
+// maximum time in ms a scheduled layout run may take before it continues in a later run
+static const int MaximumLayoutTime = 50;
+
 class Q_DECL_HIDDEN KoTextDocumentLayout::Private
 {
 public:
@@ -86,6 +90,7 @@ public:
        , y(0)
        , isLayouting(false)
        , layoutScheduled(false)
+       , timeSlicedLayout(false)
        , continuousLayout(true)
        , layoutBlocked(false)
        , changesBlocked(false)
@@ -132,6 +137,8 @@ public:
     qreal y;
     bool isLayouting;
     bool layoutScheduled;
+    bool timeSlicedLayout; // scheduled layout runs give back control once their time is up
+    QElapsedTimer layoutTimer;
     bool continuousLayout;
     bool layoutBlocked;
     bool changesBlocked;
@@ -297,6 +304,17 @@ qreal KoTextDocumentLayout::defaultTabSpacing() const
 // this method is called on every char inserted or deleted, on format changes, setting/moving of variables or objects.
 void KoTextDocumentLayout::documentChanged(int position, int charsRemoved, int charsAdded)
 {
+    // The lines of changed blocks can't be reused even if the layout itself ignores the change.
+    QTextBlock changedBlock = document()->findBlock(position);
+    const int changedEnd = position + qMax(charsRemoved, charsAdded);
+    while (changedBlock.isValid() && changedBlock.position() <= changedEnd) {
+        if (changedBlock.userData()) {
+            KoTextBlockData data(changedBlock);
+            data.invalidateLayoutCache();
+        }
+        changedBlock = changedBlock.next();
+    }
+
     if (d->changesBlocked) {
         return;
     }
@@ -695,6 +713,7 @@ void KoTextDocumentLayout::layout()
 
     Q_ASSERT(!d->isLayouting);
     d->isLayouting = true;
+    d->layoutTimer.start();
 
     bool finished;
     do {
@@ -859,6 +878,13 @@ bool KoTextDocumentLayout::doLayout()
             if (!continuousLayout()) {
                 return false; // Let's take a break. We are not finished layouting yet.
             }
+
+            if (d->timeSlicedLayout && d->layoutTimer.elapsed() > MaximumLayoutTime) {
+                // Give the event loop a chance to handle input and continue later. All root
+                // areas done so far are clean then and will be skipped quickly by the next run.
+                scheduleLayout();
+                return false;
+            }
         } else {
             // Drop following rootAreas
             delete d->layoutPosition;
@@ -907,7 +933,9 @@ void KoTextDocumentLayout::executeScheduledLayout()
         // root-areas that got dirty and are before the currently processed root-area.
         d->restartLayout = true;
     } else {
+        d->timeSlicedLayout = true;
         layout();
+        d->timeSlicedLayout = false;
     }
 }
 
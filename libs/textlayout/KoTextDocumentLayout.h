@@ -293,6 +293,8 @@ public Q_SLOTS:
      * to this slot will be compressed into one layout-call to prevent calling layouting
      * to much. Also if meanwhile \a layout was called then the scheduled layout won't
      * be executed.
+     * A scheduled layout run gives back control to the event loop after a short time
+     * and schedules itself again to continue with the remaining root areas.
      */
     virtual void scheduleLayout();
 
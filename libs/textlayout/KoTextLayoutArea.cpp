@@ -52,6 +52,7 @@
 #include <KoInlineNote.h>
 #include <KoTextSoftPageBreak.h>
 #include <KoInlineTextObjectManager.h>
+#include <KoTextRangeManager.h>
 
 #include <TextLayoutDebug.h>
 
@@ -806,6 +807,46 @@ QTextLine KoTextLayoutArea::Private::recreatePartialLayout(QTextBlock &block, co
     return line;
 }
 
+bool KoTextLayoutArea::Private::isLayoutCacheable(const QTextBlock &block, const KoParagraphStyle &pStyle) const
+{
+    // Only plain paragraphs that are laid out in one go and that don't depend on
+    // anything but their own text and the horizontal geometry can be reused.
+    if (block.textList() || pStyle.dropCaps() || dropCapsWidth != 0 || maximumAllowedWidth > 0
+            || block.blockFormat().hasProperty(KoParagraphStyle::HiddenByTable)
+            || block.blockFormat().boolProperty(KoParagraphStyle::UnnumberedListItem)) {
+        return false;
+    }
+    // inline objects like notes, variables and soft page breaks
+    if (block.text().contains(QChar::ObjectReplacementCharacter) || !block.layout()->preeditAreaText().isEmpty()) {
+        return false;
+    }
+    if (!documentLayout->currentObstructions().isEmpty()
+            || documentLayout->anchoringSoftBreak() < block.position() + block.length()) {
+        return false;
+    }
+    if (documentLayout->changeTracker() && documentLayout->changeTracker()->displayChanges()) {
+        return false;
+    }
+    if (documentLayout->textRangeManager()) {
+        const int first = block.position();
+        const int last = block.position() + block.length() - 1;
+        if (!documentLayout->textRangeManager()->textRangesChangingWithin(block.document(), first, last, first, last).isEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool KoTextLayoutArea::Private::isLayoutCacheValid(const QTextBlock &block, const KoTextBlockData::LayoutCache &cache) const
+{
+    return cache.revision == block.revision()
+        && block.layout()->lineCount() > 0
+        && qAbs(cache.left - x) < 0.001
+        && qAbs(cache.width - width) < 0.001
+        && qAbs(cache.indent - indent) < 0.001
+        && cache.rightToLeft == isRtl;
+}
+
 static bool compareTab(const QTextOption::Tab &tab1, const QTextOption::Tab &tab2)
 {
     return tab1.position < tab2.position;
@@ -1243,8 +1284,22 @@ bool KoTextLayoutArea::layoutBlock(FrameIterator *cursor)
     // ==============
     // Setup line and possibly restart paragraph continuing from previous other area
     // ==============
+    // The lines of an unchanged paragraph that did fit in one area before are kept
+    // as they are and only moved to their new vertical position further below.
+    const bool cacheable = cursor->lineTextStart == -1 && !lastOfPreviousRun
+                           && d->isLayoutCacheable(block, pStyle);
+    KoTextBlockData::LayoutCache layoutCache = blockData.layoutCache();
+    bool reuseLines = cacheable && d->isLayoutCacheValid(block, layoutCache);
+    blockData.invalidateLayoutCache();
+    layoutCache.left = d->x;
+    layoutCache.width = d->width;
+    layoutCache.indent = d->indent;
+    layoutCache.rightToLeft = d->isRtl;
+
     QTextLine line;
-    if (cursor->lineTextStart == -1) {
+    if (reuseLines) {
+        cursor->fragmentIterator = block.begin();
+    } else if (cursor->lineTextStart == -1) {
         layout->beginLayout();
         line = layout->createLine();
         cursor->fragmentIterator = block.begin();
@@ -1325,6 +1380,40 @@ bool KoTextLayoutArea::layoutBlock(FrameIterator *cursor)
     expandBoundingLeft(d->blockRects.last().x());
     expandBoundingRight(d->blockRects.last().right());
 
+    // ==============
+    // Reuse the lines of this paragraph if only its vertical position changed
+    // ==============
+    if (reuseLines) {
+        const qreal dy = d->y - layoutCache.top;
+        const QTextLine lastLine = layout->lineAt(layout->lineCount() - 1);
+        if (lastLine.y() + lastLine.height() + dy <= maximumAllowedBottom()) {
+            for (int i = 0; i < layout->lineCount(); ++i) {
+                QTextLine cachedLine = layout->lineAt(i);
+                cachedLine.setPosition(cachedLine.position() + QPointF(0, dy));
+            }
+            d->y = layoutCache.bottom + dy;
+            d->neededWidth = qMax(d->neededWidth, layoutCache.neededWidth);
+            d->indent = 0;
+            d->extraTextIndent = 0;
+            documentLayout()->positionAnchoredObstructions();
+
+            layoutCache.top += dy;
+            layoutCache.bottom += dy;
+            blockData.setLayoutCache(layoutCache);
+
+            d->bottomSpacing = pStyle.bottomMargin();
+            setVirginPage(false);
+            cursor->lineTextStart = -1;
+            block.setLineCount(layout->lineCount());
+            return true;
+        }
+        // doesn't fit anymore so we need to break it into lines again
+        layout->beginLayout();
+        line = layout->createLine();
+    }
+    layoutCache.top = d->y;
+    layoutCache.neededWidth = 0;
+
     // ==============
     // Create the lines of this paragraph
     // ==============
@@ -1437,6 +1526,7 @@ bool KoTextLayoutArea::layoutBlock(FrameIterator *cursor)
         maxLineHeight = qMax(maxLineHeight, addLine(line, cursor, blockData));
 
         d->neededWidth = qMax(d->neededWidth, line.naturalTextWidth() + d->indent);
+        layoutCache.neededWidth = qMax(layoutCache.neededWidth, line.naturalTextWidth() + d->indent);
 
         if (!runAroundHelper.stayOnBaseline() && !(block.blockFormat().hasProperty(KoParagraphStyle::HiddenByTable)
          && block.length() <= 1)) {
@@ -1479,6 +1569,12 @@ bool KoTextLayoutArea::layoutBlock(FrameIterator *cursor)
         }
     }
 
+    if (cacheable && documentLayout()->currentObstructions().isEmpty()) {
+        layoutCache.revision = block.revision();
+        layoutCache.bottom = d->y;
+        blockData.setLayoutCache(layoutCache);
+    }
+
     d->bottomSpacing = pStyle.bottomMargin();
 
     layout->endLayout();
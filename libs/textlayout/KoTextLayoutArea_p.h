@@ -36,6 +36,9 @@
 #include "KoTextLayoutNoteArea.h"
 
 #include <KoTextBlockBorderData.h>
+#include <KoTextBlockData.h>
+
+class KoParagraphStyle;
 
 //local type for temporary use in restartLayout
 struct LineKeeper
@@ -143,6 +146,10 @@ public:
     void stashRemainingLayout(QTextBlock &block, int lineTextStartOfFirstKeep, QVector<LineKeeper> &stashedLines, QPointF &stashedCounterPosition);
     /// utility method to recreate partial layout of a split block
     QTextLine recreatePartialLayout(QTextBlock &block, const QVector<LineKeeper> &stashedLines, QPointF &stashedCounterPosition, QTextLine &line);
+    /// utility method to check if the lines of a block can be stored in and reused from its layout cache
+    bool isLayoutCacheable(const QTextBlock &block, const KoParagraphStyle &pStyle) const;
+    /// utility method to check if the cached lines of a block are valid for the current geometry
+    bool isLayoutCacheValid(const QTextBlock &block, const KoTextBlockData::LayoutCache &cache) const;
 
 
 };
@@ -1224,4 +1224,43 @@ void TestBlockLayout::testDropCapsWithNewline()
     QCOMPARE(line.height(), heightNormalLine);
 }
 
+void TestBlockLayout::testReuseUnchangedLines()
+{
+    setupTest(m_loremIpsum);
+    QTextCursor cursor(m_doc);
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertBlock();
+    cursor.insertText(m_loremIpsum);
+    m_layout->layout();
+
+    QTextBlock secondBlock = m_block.next();
+    QTextLayout *blockLayout = secondBlock.layout();
+    const int lineCount = blockLayout->lineCount();
+    const qreal firstLineY = blockLayout->lineAt(0).y();
+    QCOMPARE(KoTextBlockData(secondBlock).layoutCache().revision, secondBlock.revision());
+
+    // make the first paragraph longer so the second one only moves down
+    cursor.setPosition(0);
+    cursor.insertText(m_loremIpsum.left(200));
+    m_layout->layout();
+
+    QCOMPARE(blockLayout->lineCount(), lineCount);
+    QVERIFY(blockLayout->lineAt(0).y() > firstLineY);
+    QVERIFY(qAbs(KoTextBlockData(secondBlock).layoutCache().top - blockLayout->lineAt(0).y()) < ROUNDING);
+    QList<QPointF> reusedPositions;
+    for (int i = 0; i < lineCount; ++i) {
+        reusedPositions.append(blockLayout->lineAt(i).position());
+    }
+
+    // a fresh layout of the paragraph needs to end up at the same positions
+    m_layout->documentChanged(secondBlock.position(), 0, 0);
+    QCOMPARE(KoTextBlockData(secondBlock).layoutCache().revision, -1);
+    m_layout->layout();
+    QCOMPARE(blockLayout->lineCount(), lineCount);
+    for (int i = 0; i < lineCount; ++i) {
+        QVERIFY(qAbs(blockLayout->lineAt(i).x() - reusedPositions[i].x()) < ROUNDING);
+        QVERIFY(qAbs(blockLayout->lineAt(i).y() - reusedPositions[i].y()) < ROUNDING);
+    }
+}
+
 QTEST_MAIN(TestBlockLayout)
@@ -88,6 +88,9 @@ private Q_SLOTS:
     void testDropCapsShortText();
     void testDropCapsWithNewline();
 
+    /// Test that the lines of an unchanged paragraph are reused when it only moves.
+    void testReuseUnchangedLines();
+
 private:
     void setupTest(const QString &initText = QString());
 
@@ -70,7 +70,7 @@ void BuiltinSchedulerPlugin::calculate( Project &project, ScheduleManager *sm, b
         connect(job, SIGNAL(progressChanged(int)), sm, SLOT(setProgress(int)));
         job->doRun();
     } else {
-        job->start();
+        startJob( job );
     }
     m_synctimer.start();
 }
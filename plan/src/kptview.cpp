@@ -1013,6 +1013,7 @@ ViewBase *View::createScheduleHandler( ViewListItem *cat, const QString &tag, co
     connect( handler->scheduleEditor(), SIGNAL(moveScheduleManager(ScheduleManager*,ScheduleManager*,int)), SLOT(slotMoveScheduleManager(ScheduleManager*,ScheduleManager*,int)));
 
     connect( handler->scheduleEditor(), SIGNAL(calculateSchedule(Project*,ScheduleManager*)), SLOT(slotCalculateSchedule(Project*,ScheduleManager*)) );
+    connect( handler->scheduleEditor(), SIGNAL(calculateSchedules(Project*,QList<ScheduleManager*>)), SLOT(slotCalculateSchedules(Project*,QList<ScheduleManager*>)) );
 
     connect( handler->scheduleEditor(), SIGNAL(baselineSchedule(Project*,ScheduleManager*)), SLOT(slotBaselineSchedule(Project*,ScheduleManager*)) );
 
@@ -1039,6 +1040,7 @@ ScheduleEditor *View::createScheduleEditor( QWidget *parent )
     connect( scheduleeditor, SIGNAL(deleteScheduleManager(Project*,ScheduleManager*)), SLOT(slotDeleteScheduleManager(Project*,ScheduleManager*)) );
 
     connect( scheduleeditor, SIGNAL(calculateSchedule(Project*,ScheduleManager*)), SLOT(slotCalculateSchedule(Project*,ScheduleManager*)) );
+    connect( scheduleeditor, SIGNAL(calculateSchedules(Project*,QList<ScheduleManager*>)), SLOT(slotCalculateSchedules(Project*,QList<ScheduleManager*>)) );
 
     connect( scheduleeditor, SIGNAL(baselineSchedule(Project*,ScheduleManager*)), SLOT(slotBaselineSchedule(Project*,ScheduleManager*)) );
 
@@ -1071,6 +1073,7 @@ ViewBase *View::createScheduleEditor( ViewListItem *cat, const QString &tag, con
     connect( scheduleeditor, SIGNAL(deleteScheduleManager(Project*,ScheduleManager*)), SLOT(slotDeleteScheduleManager(Project*,ScheduleManager*)) );
 
     connect( scheduleeditor, SIGNAL(calculateSchedule(Project*,ScheduleManager*)), SLOT(slotCalculateSchedule(Project*,ScheduleManager*)) );
+    connect( scheduleeditor, SIGNAL(calculateSchedules(Project*,QList<ScheduleManager*>)), SLOT(slotCalculateSchedules(Project*,QList<ScheduleManager*>)) );
 
     connect( scheduleeditor, SIGNAL(baselineSchedule(Project*,ScheduleManager*)), SLOT(slotBaselineSchedule(Project*,ScheduleManager*)) );
 
@@ -1759,6 +1762,19 @@ void View::slotCalculateSchedule( Project *project, ScheduleManager *sm )
     slotUpdate();
 }
 
+void View::slotCalculateSchedules( Project *project, const QList<ScheduleManager*> &managers )
+{
+    if ( project == 0 || managers.isEmpty() ) {
+        return;
+    }
+    if ( managers.contains( currentScheduleManager() ) ) {
+        connect( project, SIGNAL(projectCalculated(ScheduleManager*)), this, SLOT(slotProjectCalculated(ScheduleManager*)) );
+    }
+    CalculateAllSchedulesCmd *cmd =  new CalculateAllSchedulesCmd( *project, managers, kundo2_i18n( "Calculate all schedules" ) );
+    getPart() ->addCommand( cmd );
+    slotUpdate();
+}
+
 void View::slotRemoveCommands()
 {
     while ( ! m_undocommands.isEmpty() ) {
@@ -259,6 +259,7 @@ protected Q_SLOTS:
     void slotDeleteScheduleManager( Project *project, ScheduleManager *sm );
     void slotMoveScheduleManager( ScheduleManager *sm, ScheduleManager *parent, int index );
     void slotCalculateSchedule( Project*, ScheduleManager* );
+    void slotCalculateSchedules( Project *project, const QList<ScheduleManager*> &managers );
     void slotBaselineSchedule( Project *project, ScheduleManager *sm );
 
     void slotProjectWorktime();
@@ -42,6 +42,10 @@
 
 #include <QTimeZone>
 #include <QDate>
+#include <QMutex>
+#include <QVector>
+
+#include <algorithm>
 
 namespace KPlato
 {
@@ -708,6 +712,209 @@ int CalendarWeekdays::indexOf( const CalendarDay *day ) const
     return m_weekdays.values().indexOf( const_cast<CalendarDay*>(day) );
 }
 
+/////   Calendar::WorkIndex   ////
+
+/**
+ * The working intervals of a calendar in a range of dates, in utc milliseconds
+ * since epoch, together with the working time of all intervals before each interval.
+ * The intervals are generated with firstInterval() day by day, so effort and the
+ * first available times can be found with binary searches instead of walking the days.
+ * The index is rebuilt when the calendar, its parents or its time zone changes,
+ * and grows when a time outside the range is asked for.
+ */
+class Calendar::WorkIndex
+{
+public:
+    WorkIndex() : version(-1), rangeStart(0), rangeEnd(0) {}
+
+    void clear() { version = -1; firstDate = QDate(); }
+
+    /// Returns false if @p result must be calculated by walking the days
+    bool effort(const Calendar *calendar, qint64 start, qint64 end, Duration &result);
+    /// The @p result is in the time zone of the calendar, and invalid if not available
+    bool firstAvailableAfter(const Calendar *calendar, qint64 time, qint64 limit, DateTime &result);
+    bool firstAvailableBefore(const Calendar *calendar, qint64 time, qint64 limit, DateTime &result);
+
+private:
+    static QList<const Calendar*> parentsOf(const Calendar *calendar);
+    /// Make sure the index is up to date and contains the interval @p start to @p end
+    void cover(const Calendar *calendar, qint64 start, qint64 end);
+    void build(const Calendar *calendar, QDate first, QDate last);
+    /// Returns true if @p time is close to a day that does not have 24 hours (daylight saving)
+    bool isIrregular(qint64 time) const;
+    /// Returns the working time before @p time
+    qint64 workBefore(qint64 time) const;
+
+    QMutex mutex;
+    int version;
+    QTimeZone timeZone;
+    QList<const Calendar*> parents;
+    QDate firstDate;
+    QDate lastDate;
+    qint64 rangeStart; // start of firstDate
+    qint64 rangeEnd; // end of lastDate
+    QVector<qint64> starts;
+    QVector<qint64> ends;
+    QVector<qint64> accumulated; // working time of the intervals before, one entry more than starts
+    QVector<qint64> irregular; // start and end of the days around a daylight saving change
+};
+
+QList<const Calendar*> Calendar::WorkIndex::parentsOf(const Calendar *calendar)
+{
+    QList<const Calendar*> lst;
+    for (const Calendar *c = calendar->parentCal(); c; c = c->parentCal()) {
+        lst << c;
+    }
+    return lst;
+}
+
+void Calendar::WorkIndex::cover(const Calendar *calendar, qint64 start, qint64 end)
+{
+    if (version != calendar->cacheVersion() || timeZone != calendar->m_timeZone || parents != parentsOf(calendar)) {
+        clear();
+    }
+    if (firstDate.isValid() && start >= rangeStart && end <= rangeEnd) {
+        return;
+    }
+    const QTimeZone tz = calendar->m_timeZone;
+    QDate first = QDateTime::fromMSecsSinceEpoch(start, tz).date();
+    QDate last = QDateTime::fromMSecsSinceEpoch(end, tz).date();
+    if (!firstDate.isValid()) {
+        build(calendar, first.addDays(-31), last.addDays(31));
+        return;
+    }
+    // grow at least with the current size so extending the range is amortized
+    const qint64 extra = qMax<qint64>(31, firstDate.daysTo(lastDate) + 1);
+    first = first < firstDate ? first.addDays(-extra) : firstDate;
+    last = last > lastDate ? last.addDays(extra) : lastDate;
+    build(calendar, first, last);
+}
+
+void Calendar::WorkIndex::build(const Calendar *calendar, QDate first, QDate last)
+{
+    version = calendar->cacheVersion();
+    timeZone = calendar->m_timeZone;
+    parents = parentsOf(calendar);
+    firstDate = first;
+    lastDate = last;
+    starts.clear();
+    ends.clear();
+    accumulated.clear();
+    irregular.clear();
+
+    const QTime t0(0, 0, 0);
+    const int aday = 1000 * 60 * 60 * 24;
+    qint64 dayStart = QDateTime(first, t0, timeZone).toMSecsSinceEpoch();
+    rangeStart = dayStart;
+    qint64 work = 0;
+    accumulated << work;
+    for (QDate date = first; date <= last; date = date.addDays(1)) {
+        const qint64 dayEnd = QDateTime(date.addDays(1), t0, timeZone).toMSecsSinceEpoch();
+        if (dayEnd - dayStart != aday) {
+            // the intervals of this day may end in the next one
+            irregular << dayStart << QDateTime(date.addDays(2), t0, timeZone).toMSecsSinceEpoch();
+        }
+        int from = 0;
+        while (from < aday) {
+            const TimeInterval ti = calendar->firstInterval(date, t0.addMSecs(from), aday - from);
+            if (!ti.isValid()) {
+                break;
+            }
+            const qint64 s = DateTime(date, ti.first, timeZone).toMSecsSinceEpoch();
+            starts << s;
+            ends << s + ti.second;
+            work += ti.second;
+            accumulated << work;
+            from = t0.msecsTo(ti.first) + ti.second;
+        }
+        dayStart = dayEnd;
+    }
+    rangeEnd = dayStart;
+}
+
+bool Calendar::WorkIndex::isIrregular(qint64 time) const
+{
+    for (int i = 0; i < irregular.count(); i += 2) {
+        if (time >= irregular.at(i) && time < irregular.at(i + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+qint64 Calendar::WorkIndex::workBefore(qint64 time) const
+{
+    const int i = std::lower_bound(starts.constBegin(), starts.constEnd(), time) - starts.constBegin();
+    qint64 work = accumulated.at(i);
+    if (i > 0 && ends.at(i - 1) > time) {
+        work -= ends.at(i - 1) - time;
+    }
+    return work;
+}
+
+bool Calendar::WorkIndex::effort(const Calendar *calendar, qint64 start, qint64 end, Duration &result)
+{
+    QMutexLocker locker(&mutex);
+    cover(calendar, start, end);
+    if (isIrregular(start) || isIrregular(end)) {
+        return false;
+    }
+    result = Duration(workBefore(end) - workBefore(start));
+    return true;
+}
+
+bool Calendar::WorkIndex::firstAvailableAfter(const Calendar *calendar, qint64 time, qint64 limit, DateTime &result)
+{
+    QMutexLocker locker(&mutex);
+    cover(calendar, time, time);
+    if (isIrregular(time)) {
+        return false;
+    }
+    forever {
+        const int i = std::upper_bound(ends.constBegin(), ends.constEnd(), time) - ends.constBegin();
+        if (i < ends.count()) {
+            if (isIrregular(limit)) {
+                return false;
+            }
+            if (starts.at(i) < limit) {
+                result = DateTime(QDateTime::fromMSecsSinceEpoch(qMax(time, starts.at(i)), timeZone));
+            }
+            break;
+        }
+        if (rangeEnd >= limit) {
+            break;
+        }
+        cover(calendar, time, rangeEnd);
+    }
+    return true;
+}
+
+bool Calendar::WorkIndex::firstAvailableBefore(const Calendar *calendar, qint64 time, qint64 limit, DateTime &result)
+{
+    QMutexLocker locker(&mutex);
+    cover(calendar, time, time);
+    if (isIrregular(time)) {
+        return false;
+    }
+    forever {
+        const int i = std::lower_bound(starts.constBegin(), starts.constEnd(), time) - starts.constBegin();
+        if (i > 0) {
+            if (isIrregular(limit)) {
+                return false;
+            }
+            if (ends.at(i - 1) > limit) {
+                result = DateTime(QDateTime::fromMSecsSinceEpoch(qMin(time, ends.at(i - 1)), timeZone));
+            }
+            break;
+        }
+        if (rangeStart <= limit) {
+            break;
+        }
+        cover(calendar, rangeStart - 1, time);
+    }
+    return true;
+}
+
 /////   Calendar   ////
 
 Calendar::Calendar()
@@ -741,6 +948,7 @@ Calendar::~Calendar() {
     delete m_weekdays;
     while (!m_days.isEmpty())
         delete m_days.takeFirst();
+    delete m_workIndex;
 }
 // Not allowed, QObject
 // Calendar::Calendar(Calendar *calendar)
@@ -763,6 +971,7 @@ const Calendar &Calendar::copy( const Calendar &calendar ) {
     }
     delete m_weekdays;
     m_weekdays = new CalendarWeekdays(calendar.weekdays());
+    m_workIndex->clear();
     return *this;
 }
 
@@ -774,6 +983,7 @@ void Calendar::init() {
     m_timeZone = QTimeZone::systemTimeZone();
     m_cacheversion = 0;
     m_blockversion = false;
+    m_workIndex = new WorkIndex();
 }
 
 int Calendar::cacheVersion() const
@@ -1291,6 +1501,9 @@ Duration Calendar::effort(const DateTime &start, const DateTime &end, Schedule *
         return eff;
     }
     Q_ASSERT(m_timeZone.isValid());
+    if ( !sch && m_workIndex->effort( this, start.toMSecsSinceEpoch(), end.toMSecsSinceEpoch(), eff ) ) {
+        return eff;
+    }
     QDateTime zonedStart = start.toTimeZone( m_timeZone );
     QDateTime zonedEnd = end.toTimeZone( m_timeZone );
     Q_ASSERT( zonedStart.isValid() && zonedEnd.isValid() );
@@ -1422,6 +1635,10 @@ DateTime Calendar::firstAvailableAfter(const DateTime &time, const DateTime &lim
         return DateTime();
     }
     Q_ASSERT( m_timeZone.isValid() );
+    DateTime result;
+    if ( !sch && m_workIndex->firstAvailableAfter( this, time.toMSecsSinceEpoch(), limit.toMSecsSinceEpoch(), result ) ) {
+        return result;
+    }
     QDateTime zonedTime = time.toTimeZone( m_timeZone );
     QDateTime zonedLimit = limit.toTimeZone( m_timeZone );
     Q_ASSERT( zonedTime.isValid() && zonedLimit.isValid() );
@@ -1486,6 +1703,10 @@ DateTime Calendar::firstAvailableBefore(const DateTime &time, const DateTime &li
         return DateTime();
     }
     Q_ASSERT(m_timeZone.isValid());
+    DateTime result;
+    if ( !sch && m_workIndex->firstAvailableBefore( this, time.toMSecsSinceEpoch(), limit.toMSecsSinceEpoch(), result ) ) {
+        return DateTime( result.toTimeZone( projectTimeZone() ) ); // return in local timezone
+    }
     return firstAvailableBefore( time.toTimeZone(m_timeZone), limit.toTimeZone(m_timeZone), sch );
 }
 
@@ -1600,6 +1821,7 @@ void Calendar::setHolidayRegion(const QString &code)
     if (m_project) {
         m_project->changed(this);
     }
+    incCacheVersion();
 }
 
 QString Calendar::holidayRegionCode() const
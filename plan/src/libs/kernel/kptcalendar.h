@@ -456,7 +456,8 @@ public:
     /**
      * Returns the amount of 'worktime' that can be done in the
      * interval from @p start to @p end
-     * If @p sch is not 0, the schedule is checked for availability.
+     * If @p sch is not 0, the schedule is checked for availability,
+     * else the result is looked up in an index of the working intervals.
      */
     Duration effort(const DateTime &start, const DateTime &end, Schedule *sch=0) const;
 
@@ -621,6 +622,9 @@ private:
     int m_cacheversion; // incremented every time a calendar is changed
     friend class Project;
     int m_blockversion; // don't update if true
+
+    class WorkIndex;
+    mutable WorkIndex *m_workIndex; // the working intervals, used when no schedule is checked
 #ifndef NDEBUG
 public:
     void printDebug(const QString& indent=QString());
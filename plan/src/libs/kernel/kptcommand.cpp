@@ -27,6 +27,7 @@
 #include "kptcalendar.h"
 #include "kptrelation.h"
 #include "kptresource.h"
+#include "kptschedulerplugin.h"
 #include "kptdocuments.h"
 #include "kptlocale.h"
 #include "kptdebug.h"
@@ -2899,6 +2900,63 @@ void CalculateScheduleCmd::unexecute()
 }
 
 //------------------------
+CalculateAllSchedulesCmd::CalculateAllSchedulesCmd( Project &node, const QList<ScheduleManager*> &managers, const KUndo2MagicString& name )
+    : NamedCommand( name ),
+    m_node( node ),
+    m_first( true )
+{
+    foreach ( ScheduleManager *sm, managers ) {
+        m_managers << sm;
+        m_oldexpected << sm->expected();
+    }
+}
+
+void CalculateAllSchedulesCmd::execute()
+{
+    if ( m_first ) {
+        // one batch per scheduler, so the schedules are calculated in parallel
+        QMap<SchedulerPlugin*, QList<ScheduleManager*> > batches;
+        foreach ( ScheduleManager *sm, m_managers ) {
+            if ( sm && sm->schedulerPlugin() ) {
+                batches[ sm->schedulerPlugin() ] << sm;
+            }
+        }
+        QMap<SchedulerPlugin*, QList<ScheduleManager*> >::const_iterator it;
+        for ( it = batches.constBegin(); it != batches.constEnd(); ++it ) {
+            it.key()->calculateAll( m_node, it.value() );
+        }
+        m_newexpected.clear();
+        foreach ( ScheduleManager *sm, m_managers ) {
+            m_newexpected << ( sm ? sm->expected() : 0 );
+        }
+        m_first = false;
+    } else {
+        for ( int i = 0; i < m_managers.count(); ++i ) {
+            if ( m_managers.at( i ) ) {
+                m_managers.at( i )->setExpected( m_newexpected.at( i ) );
+            }
+        }
+    }
+}
+
+void CalculateAllSchedulesCmd::unexecute()
+{
+    for ( int i = 0; i < m_managers.count(); ++i ) {
+        ScheduleManager *sm = m_managers.at( i );
+        if ( sm == 0 ) {
+            continue;
+        }
+        if ( sm->scheduling() ) {
+            // terminate scheduling
+            QApplication::setOverrideCursor( Qt::WaitCursor );
+            sm->haltCalculation();
+            m_first = true;
+            QApplication::restoreOverrideCursor();
+        }
+        sm->setExpected( m_oldexpected.at( i ) );
+    }
+}
+
 BaselineScheduleCmd::BaselineScheduleCmd( ScheduleManager &sm, const KUndo2MagicString& name )
     : NamedCommand( name ),
     m_sm( sm )
@@ -1615,6 +1615,22 @@ private:
     MainSchedule *m_newexpected;
 };
 
+class KPLATOKERNEL_EXPORT CalculateAllSchedulesCmd : public NamedCommand
+{
+public:
+    /// Calculate the schedules @p managers, one batch per scheduler plugin
+    CalculateAllSchedulesCmd( Project &project, const QList<ScheduleManager*> &managers, const KUndo2MagicString& name = KUndo2MagicString() );
+    void execute();
+    void unexecute();
+
+private:
+    Project &m_node;
+    QList<QPointer<ScheduleManager> > m_managers;
+    bool m_first;
+    QList<MainSchedule*> m_oldexpected;
+    QList<MainSchedule*> m_newexpected;
+};
+
 class KPLATOKERNEL_EXPORT BaselineScheduleCmd : public NamedCommand
 {
 public:
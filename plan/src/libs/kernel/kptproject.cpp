@@ -293,6 +293,12 @@ void Project::calculate( Schedule *schedule )
     calculate();
 }
 
+// TODO: Incremental recalculation after a single change.
+// Without resource leveling, early/late times of a task only depend on its
+// predecessors/successors, so a dirty node worklist could limit the passes to
+// the successor/predecessor cones. This needs the previous schedule of the
+// manager, but the scheduler plugins calculate on a project copy loaded from xml
+// that does not contain it, and every calculation creates a new schedule id.
 void Project::calculate()
 {
     if ( m_currentSchedule == 0 ) {
@@ -830,6 +830,41 @@ bool NodeSchedule::loadXML( const KoXmlElement &sch, XMLLoaderObject &status )
     return true;
 }
 
+static DateTime inTimeZone( const DateTime &dt, const QTimeZone &timeZone )
+{
+    // same as a save/load cycle: keep the wall clock time
+    return dt.isValid() ? DateTime( dt.date(), dt.time(), timeZone ) : DateTime();
+}
+
+void NodeSchedule::copyScheduleValues( const NodeSchedule &other, const QTimeZone &timeZone )
+{
+    m_name = other.m_name;
+    m_type = other.m_type;
+    m_id = other.m_id;
+
+    earlyStart = inTimeZone( other.earlyStart, timeZone );
+    lateStart = inTimeZone( other.lateStart, timeZone );
+    earlyFinish = inTimeZone( other.earlyFinish, timeZone );
+    lateFinish = inTimeZone( other.lateFinish, timeZone );
+    startTime = inTimeZone( other.startTime, timeZone );
+    endTime = inTimeZone( other.endTime, timeZone );
+    workStartTime = inTimeZone( other.workStartTime, timeZone );
+    workEndTime = inTimeZone( other.workEndTime, timeZone );
+    duration = other.duration;
+
+    inCriticalPath = other.inCriticalPath;
+    resourceError = other.resourceError;
+    resourceOverbooked = other.resourceOverbooked;
+    resourceNotAvailable = other.resourceNotAvailable;
+    constraintError = other.constraintError;
+    schedulingError = other.schedulingError;
+    notScheduled = other.notScheduled;
+
+    positiveFloat = other.positiveFloat;
+    negativeFloat = other.negativeFloat;
+    freeFloat = other.freeFloat;
+}
+
 void NodeSchedule::saveXML( QDomElement &element ) const
 {
     //debugPlan;
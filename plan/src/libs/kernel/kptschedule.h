@@ -381,6 +381,11 @@ public:
 
     virtual bool loadXML( const KoXmlElement &element, XMLLoaderObject &status );
     virtual void saveXML( QDomElement &element ) const;
+    /**
+     * Copy the values saved by saveXML() from @p other, with times in @p timeZone.
+     * Used to move a calculated schedule into another project without an xml round trip.
+     */
+    void copyScheduleValues( const NodeSchedule &other, const QTimeZone &timeZone );
 
     // tasks------------>
     virtual void addAppointment( Schedule *resource, const DateTime &start, const DateTime &end, double load = 100 );
@@ -26,6 +26,9 @@
 
 #include "KoXmlReader.h"
 
+#include <QHash>
+#include <QPointer>
+
 
 namespace KPlato
 {
@@ -33,12 +36,85 @@ namespace KPlato
 class Q_DECL_HIDDEN SchedulerPlugin::Private
 {
 public:
-    Private() {}
+    Private() : maxJobs( qMax( 1, QThread::idealThreadCount() ) ), threadCount( 1 ), timeBudget( 0 ) {}
+
+    void startQueuedJobs();
+    /// Return the number of jobs that may run at the same time
+    int jobLimit() const;
+    /// Return the number of threads a job started now may use
+    int jobThreadCount() const;
+    /// Return true if a parent schedule of @p sm is not calculated yet
+    bool waitsForParent( const ScheduleManager *sm ) const;
+    /// Remove the sub-schedules of @p sm from the waiting schedules
+    void removeWaitingChildren( const ScheduleManager *sm );
 
     QString name;
     QString comment;
+
+    int maxJobs;
+    int threadCount;
+    int timeBudget;
+    QList<SchedulerThread*> running;
+    QList<SchedulerThread*> queued;
+    /// The schedule managers of the running and queued jobs
+    QHash<SchedulerThread*, QPointer<ScheduleManager> > managers;
+    /// Sub-schedules of calculateAll() waiting for their parent schedule
+    QList<QPointer<ScheduleManager> > waiting;
 };
 
+void SchedulerPlugin::Private::startQueuedJobs()
+{
+    while ( ! queued.isEmpty() && running.count() < jobLimit() ) {
+        SchedulerThread *job = queued.takeFirst();
+        job->setThreadCount( jobThreadCount() );
+        running << job;
+        job->start();
+    }
+}
+
+int SchedulerPlugin::Private::jobLimit() const
+{
+    return qMax( 1, qMin( maxJobs, QThread::idealThreadCount() ) );
+}
+
+int SchedulerPlugin::Private::jobThreadCount() const
+{
+    // share the cores between the jobs that run at the same time,
+    // so several schedules run in parallel even if one job could use all cores
+    const int jobs = qBound( 1, running.count() + queued.count(), jobLimit() );
+    return qBound( 1, QThread::idealThreadCount() / jobs, threadCount );
+}
+
+bool SchedulerPlugin::Private::waitsForParent( const ScheduleManager *sm ) const
+{
+    const QList<QPointer<ScheduleManager> > pending = managers.values();
+    for ( ScheduleManager *p = sm->parentManager(); p; p = p->parentManager() ) {
+        if ( pending.contains( p ) || waiting.contains( p ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SchedulerPlugin::Private::removeWaitingChildren( const ScheduleManager *sm )
+{
+    QList<QPointer<ScheduleManager> >::iterator it = waiting.begin();
+    while ( it != waiting.end() ) {
+        bool child = false;
+        for ( ScheduleManager *p = it->isNull() ? 0 : (*it)->parentManager(); p; p = p->parentManager() ) {
+            if ( p == sm ) {
+                child = true;
+                break;
+            }
+        }
+        if ( it->isNull() || child ) {
+            it = waiting.erase( it );
+        } else {
+            ++it;
+        }
+    }
+}
+
 SchedulerPlugin::SchedulerPlugin(QObject *parent)
     : QObject(parent),
       d( new SchedulerPlugin::Private() ),
@@ -56,6 +132,8 @@ SchedulerPlugin::~SchedulerPlugin()
     foreach ( SchedulerThread *s, m_jobs ) {
         s->haltScheduling();
     }
+    // queued jobs have not been started, so they can not delete themselves
+    qDeleteAll( d->queued );
     delete d;
 }
 
@@ -96,6 +174,9 @@ void SchedulerPlugin::stopCalculation( ScheduleManager *sm )
 void SchedulerPlugin::haltCalculation( ScheduleManager *sm )
 {
     debugPlan<<"SchedulerPlugin::haltCalculation:"<<sm;
+    // the sub-schedules would be calculated from a schedule that does not exist
+    d->waiting.removeAll( sm );
+    d->removeWaitingChildren( sm );
     foreach ( SchedulerThread *j, m_jobs ) {
         if ( sm == j->mainManager() ) {
             haltCalculation( j );
@@ -115,11 +196,132 @@ void SchedulerPlugin::haltCalculation( SchedulerThread *job )
 {
     debugPlan<<"SchedulerPlugin::haltCalculation:"<<job<<m_jobs.contains( job );
     disconnect(this, 0, job, 0 );
+    d->removeWaitingChildren( job->mainManager() );
     job->haltScheduling();
     if ( m_jobs.contains( job ) ) {
         debugPlan<<"SchedulerPlugin::haltCalculation: remove"<<job;
         m_jobs.removeAt( m_jobs.indexOf( job ) );
     }
+    if ( d->queued.contains( job ) ) {
+        d->queued.removeAll( job );
+        d->managers.remove( job );
+        job->deleteLater();
+    }
+}
+
+void SchedulerPlugin::calculateAll( Project &project, const QList<ScheduleManager*> &managers )
+{
+    QList<ScheduleManager*> batch;
+    foreach ( ScheduleManager *sm, managers ) {
+        if ( sm->schedulerPlugin() == this && ! sm->scheduling() ) {
+            batch << sm;
+        }
+    }
+    QList<ScheduleManager*> independent;
+    foreach ( ScheduleManager *sm, batch ) {
+        bool child = false;
+        for ( ScheduleManager *p = sm->parentManager(); p; p = p->parentManager() ) {
+            if ( batch.contains( p ) ) {
+                child = true;
+                break;
+            }
+        }
+        if ( child ) {
+            d->waiting << sm;
+        } else {
+            independent << sm;
+        }
+    }
+    debugPlan<<"SchedulerPlugin::calculateAll:"<<independent.count()<<"independent"<<d->waiting.count()<<"waiting";
+    // create all jobs before any result is fetched into the project
+    foreach ( ScheduleManager *sm, independent ) {
+        sm->setCalculationResult( ScheduleManager::CalculationRunning );
+        calculate( project, sm );
+    }
+}
+
+int SchedulerPlugin::maxJobs() const
+{
+    return d->maxJobs;
+}
+
+void SchedulerPlugin::setMaxJobs( int count )
+{
+    d->maxJobs = qMax( 1, count );
+    d->startQueuedJobs();
+}
+
+int SchedulerPlugin::threadCount() const
+{
+    return d->threadCount;
+}
+
+void SchedulerPlugin::setThreadCount( int count )
+{
+    d->threadCount = qMax( 1, count );
+    d->startQueuedJobs();
+}
+
+int SchedulerPlugin::timeBudget() const
+{
+    return d->timeBudget;
+}
+
+void SchedulerPlugin::setTimeBudget( int msecs )
+{
+    d->timeBudget = qMax( 0, msecs );
+}
+
+void SchedulerPlugin::startJob( SchedulerThread *job )
+{
+    connect(job, SIGNAL(finished()), this, SLOT(slotJobThreadFinished()));
+    d->managers.insert( job, job->mainManager() );
+    // start when control returns to the event loop, so the jobs
+    // created together know of each other when the threads are shared
+    debugPlan<<"SchedulerPlugin::startJob: queued"<<job->mainManager()->name();
+    d->queued << job;
+    QTimer::singleShot( 0, this, SLOT(slotStartQueuedJobs()) );
+}
+
+void SchedulerPlugin::slotStartQueuedJobs()
+{
+    d->startQueuedJobs();
+}
+
+void SchedulerPlugin::slotJobThreadFinished()
+{
+    // the job may be deleted already, do not access it
+    SchedulerThread *job = static_cast<SchedulerThread*>( sender() );
+    d->running.removeAll( job );
+    ScheduleManager *sm = d->managers.take( job );
+    // sub-schedules of a canceled or failed schedule have nothing to start from
+    if ( sm && ( sm->calculationResult() == ScheduleManager::CalculationCanceled || sm->calculationResult() == ScheduleManager::CalculationError ) ) {
+        d->removeWaitingChildren( sm );
+    }
+    d->startQueuedJobs();
+
+    // the result of the job has been fetched, so sub-schedules can be calculated now
+    forever {
+        QList<ScheduleManager*> ready;
+        QList<QPointer<ScheduleManager> >::iterator it = d->waiting.begin();
+        while ( it != d->waiting.end() ) {
+            if ( it->isNull() ) {
+                it = d->waiting.erase( it );
+            } else if ( ! d->waitsForParent( *it ) ) {
+                ready << *it;
+                it = d->waiting.erase( it );
+            } else {
+                ++it;
+            }
+        }
+        if ( ready.isEmpty() ) {
+            break;
+        }
+        foreach ( ScheduleManager *sm, ready ) {
+            sm->setCalculationResult( ScheduleManager::CalculationRunning );
+            calculate( sm->project(), sm );
+        }
+    }
 }
 
 QList<long unsigned int> SchedulerPlugin::granularities() const
@@ -250,25 +452,17 @@ void SchedulerPlugin::updateNode( const Node *tn, Node *mn, long sid, XMLLoaderO
         warnPlan<<"SchedulerPlugin::updateNode:"<<"Task:"<<tn->name()<<"could not find schedule with id:"<<sid;
         return;
     }
-    QDomDocument doc( "tmp" );
-    QDomElement e = doc.createElement( "schedules" );
-    doc.appendChild( e );
-    s->saveXML( e );
-
     Q_ASSERT( ! mn->findSchedule( sid ) );
-    s = static_cast<NodeSchedule*>( mn->schedule( sid ) );
-    Q_ASSERT( s == 0 );
-    s = new NodeSchedule();
-
-    KoXmlDocument xd;
-    xd.setContent( doc.toString() );
-    KoXmlElement se = xd.documentElement().namedItem( "schedule" ).toElement();
-    Q_ASSERT( ! se.isNull() );
+    NodeSchedule *ms = static_cast<NodeSchedule*>( mn->schedule( sid ) );
+    Q_ASSERT( ms == 0 );
+    ms = new NodeSchedule();
 
-    s->loadXML( se, status );
-    s->setDeleted( false );
-    s->setNode( mn );
-    mn->addSchedule( s );
+    // this is done for every node in the ui thread, so copy the values directly,
+    // a save/load cycle per node is far too slow for large projects
+    ms->copyScheduleValues( *s, status.projectTimeZone() );
+    ms->setDeleted( false );
+    ms->setNode( mn );
+    mn->addSchedule( ms );
 }
 
 void SchedulerPlugin::updateResource( const Resource *tr, Resource *r, XMLLoaderObject &status ) const
@@ -332,6 +526,7 @@ SchedulerThread::SchedulerThread( Project *project, ScheduleManager *manager, QO
     m_manager( 0 ),
     m_stopScheduling(false ),
     m_haltScheduling( false ),
+    m_threadCount( 1 ),
     m_progress( 0 )
 {
     manager->createSchedules(); // creates expected() to get log messages during calculation
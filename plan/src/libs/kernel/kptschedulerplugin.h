@@ -59,6 +59,9 @@ class XMLLoaderObject;
 
  When the thread has finished scheduling, data can be fetched from its temporary project
  into the real project by calling the updateProject() method.
+
+ Start the thread with startJob(). At most maxJobs() threads are running at the same time,
+ the rest are queued. Use calculateAll() to calculate several schedules in one go.
 */
 class KPLATOKERNEL_EXPORT SchedulerPlugin : public QObject
 {
@@ -100,6 +103,28 @@ public:
     /// Calculate the project
     virtual void calculate( Project &project, ScheduleManager *sm, bool nothread = false ) = 0;
 
+    /**
+     * Calculate the schedules @p managers of @p project that use this plugin.
+     * All jobs copy the project before any result is fetched, so each schedule
+     * is calculated from the same data whatever order the jobs finish in.
+     * A sub-schedule in @p managers is calculated when its parent schedule is done.
+     */
+    void calculateAll( Project &project, const QList<ScheduleManager*> &managers );
+    /// Return the maximum number of calculations running at the same time.
+    /// At most one per core is run. The cores are shared between the calculations
+    /// started together, each using at most threadCount() threads.
+    int maxJobs() const;
+    /// Set the maximum number of calculations running at the same time to @p count
+    void setMaxJobs( int count );
+    /// Return the number of threads one calculation may use, default is 1
+    int threadCount() const;
+    /// Set the number of threads one calculation may use to @p count, if the scheduler supports it
+    void setThreadCount( int count );
+    /// Return the time in milliseconds after which a calculation uses the best result found so far. 0 means no limit (default)
+    int timeBudget() const;
+    /// Set the time budget of a calculation to @p msecs, if the scheduler supports it
+    void setTimeBudget( int msecs );
+
     /// Return the list of supported granularities
     /// An empty list means granularity is not supported (the default)
     QList<long unsigned int> granularities() const;
@@ -111,7 +136,14 @@ public:
 protected Q_SLOTS:
     virtual void slotSyncData();
 
+private Q_SLOTS:
+    void slotStartQueuedJobs();
+    void slotJobThreadFinished();
+
 protected:
+    /// Start @p job when control returns to the event loop, or queue it if maxJobs() jobs are running already
+    void startJob( SchedulerThread *job );
+
     void updateProject( const Project *tp, const ScheduleManager *tm, Project *mp, ScheduleManager *sm ) const;
     void updateNode( const Node *tn, Node *mn, long sid, XMLLoaderObject &status ) const;
     void updateResource( const KPlato::Resource *tr, Resource *r, XMLLoaderObject &status ) const;
@@ -177,6 +209,11 @@ public:
 
     QMap<int, QString> phaseNames() const;
 
+    /// Return the number of threads the calculation may use, default is 1
+    int threadCount() const { return m_threadCount; }
+    /// Set the number of threads the calculation may use to @p count, if the scheduler supports it
+    void setThreadCount( int count ) { m_threadCount = qMax( 1, count ); }
+
     /// Save the @p project into @p document
     static void saveProject( Project *project, QDomDocument &document );
     /// Load the @p project from @p document
@@ -239,6 +276,7 @@ protected:
 
     bool m_stopScheduling; /// Stop asap, preliminary result may be used
     bool m_haltScheduling; /// Stop and discrad result. Delete yourself.
+    int m_threadCount;
     
     KoXmlDocument m_pdoc;
 
@@ -361,6 +361,43 @@ void CalendarTester::dstSpring()
     
 }
 
+void CalendarTester::workIndex()
+{
+    Calendar p("Parent");
+    CalendarDay wd( CalendarDay::Working );
+    wd.addInterval( TimeInterval( QTime( 8, 0, 0 ), 8*60*60*1000 ) );
+    for ( int i = Qt::Monday; i <= Qt::Friday; ++i ) {
+        p.setWeekday( i, wd );
+    }
+    Calendar t("Test");
+    t.setParentCal( &p );
+
+    QDate monday( 2006, 1, 2 );
+    DateTime start( monday, QTime( 0, 0, 0 ) );
+    DateTime end( monday.addDays( 7 ), QTime( 0, 0, 0 ) );
+    QCOMPARE( t.effort( start, end ), Duration( 40.0, Duration::Unit_h ) );
+    QCOMPARE( t.effort( DateTime( monday, QTime( 12, 0, 0 ) ), DateTime( monday.addDays( 1 ), QTime( 10, 0, 0 ) ) ), Duration( 6.0, Duration::Unit_h ) );
+    QCOMPARE( t.firstAvailableAfter( DateTime( monday, QTime( 17, 0, 0 ) ), end ), DateTime( monday.addDays( 1 ), QTime( 8, 0, 0 ) ) );
+    QCOMPARE( t.firstAvailableBefore( DateTime( monday.addDays( 1 ), QTime( 7, 0, 0 ) ), start ), DateTime( monday, QTime( 16, 0, 0 ) ) );
+
+    // a change in the parent must be seen by the child
+    p.addDay( new CalendarDay( monday.addDays( 1 ), CalendarDay::NonWorking ) );
+    QCOMPARE( t.effort( start, end ), Duration( 32.0, Duration::Unit_h ) );
+    QCOMPARE( t.firstAvailableAfter( DateTime( monday, QTime( 17, 0, 0 ) ), end ), DateTime( monday.addDays( 2 ), QTime( 8, 0, 0 ) ) );
+
+    // far outside the range used so far
+    QDate later = monday.addDays( 7 * 100 );
+    QCOMPARE( t.effort( DateTime( later, QTime( 0, 0, 0 ) ), DateTime( later.addDays( 7 ), QTime( 0, 0, 0 ) ) ), Duration( 40.0, Duration::Unit_h ) );
+    QCOMPARE( t.firstAvailableBefore( DateTime( later, QTime( 0, 0, 0 ) ), start ), DateTime( later.addDays( -3 ), QTime( 16, 0, 0 ) ) );
+
+    // no working time
+    Calendar empty("Empty");
+    t.setParentCal( &empty );
+    QCOMPARE( t.effort( start, end ), Duration::zeroDuration );
+    QVERIFY( ! t.firstAvailableAfter( start, end ).isValid() );
+    QVERIFY( ! t.firstAvailableBefore( end, start ).isValid() );
+}
+
 } //namespace KPlato
 
 QTEST_GUILESS_MAIN( KPlato::CalendarTester )
@@ -37,6 +37,7 @@ private Q_SLOTS:
     void workIntervals();
     void workIntervalsFullDays();
     void dstSpring();
+    void workIndex();
 };
 
 } //namespace KPlato
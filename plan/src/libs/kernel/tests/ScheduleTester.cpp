@@ -20,7 +20,11 @@
 
 #include "kptdatetime.h"
 #include "kptschedule.h"
+#include "kptxmlloaderobject.h"
 
+#include <KoXmlReader.h>
+
+#include <QDomDocument>
 #include <QTest>
 
 namespace QTest
@@ -141,6 +145,56 @@ void ScheduleTester::busy()
 
 }
 
+void ScheduleTester::copyScheduleValues()
+{
+    NodeSchedule s( 0, "Test", Schedule::Expected, 5 );
+    s.earlyStart = DateTime( date, t1 );
+    s.lateStart = DateTime( date, t2 );
+    s.earlyFinish = DateTime( date, t3 );
+    s.lateFinish = DateTime( date.addDays(1), t3 );
+    s.startTime = s.earlyStart;
+    s.endTime = s.earlyFinish;
+    s.duration = s.endTime - s.startTime;
+    s.inCriticalPath = true;
+    s.resourceOverbooked = true;
+    s.notScheduled = false;
+    s.positiveFloat = s.lateFinish - s.earlyFinish;
+    s.freeFloat = Duration( 0, 2, 0 );
+
+    QDomDocument doc( "tmp" );
+    QDomElement e = doc.createElement( "schedules" );
+    doc.appendChild( e );
+    s.saveXML( e );
+
+    KoXmlDocument xd;
+    xd.setContent( doc.toString() );
+    KoXmlElement se = xd.documentElement().namedItem( "schedule" ).toElement();
+    XMLLoaderObject status;
+    status.setProjectTimeZone( QTimeZone::systemTimeZone() );
+    NodeSchedule loaded;
+    QVERIFY( loaded.loadXML( se, status ) );
+
+    // copying must give the same result as a save/load cycle
+    NodeSchedule copied;
+    copied.copyScheduleValues( s, status.projectTimeZone() );
+    QCOMPARE( copied.name(), loaded.name() );
+    QCOMPARE( copied.type(), loaded.type() );
+    QCOMPARE( copied.id(), loaded.id() );
+    QCOMPARE( copied.earlyStart, loaded.earlyStart );
+    QCOMPARE( copied.lateStart, loaded.lateStart );
+    QCOMPARE( copied.earlyFinish, loaded.earlyFinish );
+    QCOMPARE( copied.lateFinish, loaded.lateFinish );
+    QCOMPARE( copied.startTime, loaded.startTime );
+    QCOMPARE( copied.endTime, loaded.endTime );
+    QCOMPARE( copied.workStartTime, loaded.workStartTime );
+    QCOMPARE( copied.duration, loaded.duration );
+    QCOMPARE( copied.inCriticalPath, loaded.inCriticalPath );
+    QCOMPARE( copied.resourceOverbooked, loaded.resourceOverbooked );
+    QCOMPARE( copied.notScheduled, loaded.notScheduled );
+    QCOMPARE( copied.positiveFloat, loaded.positiveFloat );
+    QCOMPARE( copied.freeFloat, loaded.freeFloat );
+}
+
 } //namespace KPlato
 
 QTEST_GUILESS_MAIN( KPlato::ScheduleTester )
@@ -39,6 +39,7 @@ private Q_SLOTS:
     
     void available();
     void busy();
+    void copyScheduleValues();
 
 private:
     ResourceSchedule resourceSchedule;
@@ -3123,7 +3123,8 @@ KUndo2Command *NodeModel::setFinishedTime( Node *node, const QVariant &value, in
 NodeItemModel::NodeItemModel( QObject *parent )
     : ItemModelBase( parent ),
     m_node( 0 ),
-    m_projectshown( false )
+    m_projectshown( false ),
+    m_cacheId( -1 )
 {
     setReadOnly( NodeModel::NodeDescription, true );
 }
@@ -3154,6 +3155,7 @@ void NodeItemModel::slotNodeInserted( Node *node )
     Q_ASSERT( node->parentNode() == m_node );
     endInsertRows();
     m_node = 0;
+    clearValueCache();
     emit nodeInserted( node );
 }
 
@@ -3175,6 +3177,7 @@ void NodeItemModel::slotNodeRemoved( Node *node )
 #endif
     endRemoveRows();
     m_node = 0;
+    clearValueCache();
 }
 
 void NodeItemModel::slotNodeToBeMoved( Node *node, int pos, Node *newParent, int newPos )
@@ -3188,12 +3191,14 @@ void NodeItemModel::slotNodeMoved( Node *node )
     Q_UNUSED( node );
     //debugPlan<<node->parentNode()->name()<<node->parentNode()->indexOf( node );
     endMoveRows();
+    clearValueCache();
 }
 
 void NodeItemModel::slotLayoutChanged()
 {
     //debugPlan<<node->name();
     emit layoutAboutToBeChanged();
+    clearValueCache();
     emit layoutChanged();
 }
 
@@ -3201,7 +3206,110 @@ void NodeItemModel::slotProjectCalculated(ScheduleManager *sm)
 {
     debugPlan<<m_manager<<sm;
     if ( sm && sm == m_manager ) {
-        slotLayoutChanged();
+        // the rows are the same, only the values have changed
+        clearValueCache();
+        allDataChanged();
+    }
+}
+
+void NodeItemModel::slotScheduleManagerChanged( ScheduleManager *sm )
+{
+    // scheduler plugins calculate in a thread and do not emit projectCalculated()
+    if ( sm && sm == m_manager ) {
+        clearValueCache();
+        allDataChanged();
+    }
+}
+
+void NodeItemModel::slotScheduleChanged( MainSchedule *sch )
+{
+    if ( sch && m_manager && sch == m_manager->expected() ) {
+        clearValueCache();
+        allDataChanged();
+    }
+}
+
+void NodeItemModel::slotResourceChanged()
+{
+    // names and rates are used by assignments and costs
+    clearValueCache();
+    allDataChanged();
+}
+
+bool NodeItemModel::isCachedValue( int column, int role )
+{
+    if ( role != Qt::DisplayRole && role != Qt::ToolTipRole && role != NodeModel::SortableRole ) {
+        return false;
+    }
+    switch ( column ) {
+        case NodeModel::NodeStartTime:
+        case NodeModel::NodeEndTime:
+        case NodeModel::NodeEarlyStart:
+        case NodeModel::NodeEarlyFinish:
+        case NodeModel::NodeLateStart:
+        case NodeModel::NodeLateFinish:
+        case NodeModel::NodePositiveFloat:
+        case NodeModel::NodeFreeFloat:
+        case NodeModel::NodeNegativeFloat:
+        case NodeModel::NodeStartFloat:
+        case NodeModel::NodeFinishFloat:
+        case NodeModel::NodeAssignments:
+        case NodeModel::NodeDuration:
+        case NodeModel::NodeVarianceDuration:
+        case NodeModel::NodeOptimisticDuration:
+        case NodeModel::NodePessimisticDuration:
+        case NodeModel::NodeStatus:
+        case NodeModel::NodeCompleted:
+        case NodeModel::NodePlannedEffort:
+        case NodeModel::NodeActualEffort:
+        case NodeModel::NodeRemainingEffort:
+        case NodeModel::NodePlannedCost:
+        case NodeModel::NodeActualCost:
+        case NodeModel::NodeSchedulingStatus:
+        case NodeModel::NodeBCWS:
+        case NodeModel::NodeBCWP:
+        case NodeModel::NodeACWP:
+        case NodeModel::NodePerformanceIndex:
+        case NodeModel::NodeCritical:
+        case NodeModel::NodeCriticalPath:
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+void NodeItemModel::clearValueCache()
+{
+    m_valueCache.clear();
+}
+
+void NodeItemModel::nodeValuesChanged( Node *node )
+{
+    // summary tasks and the project aggregate the values of their children
+    for ( Node *n = node; n; n = n->parentNode() ) {
+        m_valueCache.remove( n );
+        if ( n->type() == Node::Type_Project ) {
+            if ( m_projectshown ) {
+                emit dataChanged( createIndex( 0, 0, n ), createIndex( 0, columnCount()-1, n ) );
+            }
+            continue;
+        }
+        int row = n->parentNode()->findChildNode( n );
+        Q_ASSERT( row >= 0 );
+        emit dataChanged( createIndex( row, 0, n ), createIndex( row, columnCount()-1, n ) );
+    }
+}
+
+void NodeItemModel::allDataChanged( const QModelIndex &parent )
+{
+    const int rows = rowCount( parent );
+    if ( rows == 0 ) {
+        return;
+    }
+    emit dataChanged( index( 0, 0, parent ), index( rows - 1, columnCount() - 1, parent ) );
+    for ( int row = 0; row < rows; ++row ) {
+        allDataChanged( index( row, 0, parent ) );
     }
 }
 
@@ -3240,10 +3348,14 @@ void NodeItemModel::setProject( Project *project )
         disconnect( m_project, SIGNAL(nodeAdded(Node*)), this, SLOT(slotNodeInserted(Node*)) );
         disconnect( m_project, SIGNAL(nodeRemoved(Node*)), this, SLOT(slotNodeRemoved(Node*)) );
         disconnect( m_project, SIGNAL(projectCalculated(ScheduleManager*)), this, SLOT(slotProjectCalculated(ScheduleManager*)));
+        disconnect( m_project, SIGNAL(scheduleManagerChanged(ScheduleManager*)), this, SLOT(slotScheduleManagerChanged(ScheduleManager*)) );
+        disconnect( m_project, SIGNAL(scheduleChanged(MainSchedule*)), this, SLOT(slotScheduleChanged(MainSchedule*)) );
+        disconnect( m_project, SIGNAL(resourceChanged(Resource*)), this, SLOT(slotResourceChanged()) );
     }
     m_project = project;
     debugPlan<<this<<m_project<<"->"<<project;
     m_nodemodel.setProject( project );
+    clearValueCache();
     if ( project ) {
         connect(m_project, SIGNAL(aboutToBeDeleted()), this, SLOT(projectDeleted()));
         connect( m_project, SIGNAL(localeChanged()), this, SLOT(slotLayoutChanged()) );
@@ -3258,25 +3370,24 @@ void NodeItemModel::setProject( Project *project )
         connect( m_project, SIGNAL(nodeAdded(Node*)), this, SLOT(slotNodeInserted(Node*)) );
         connect( m_project, SIGNAL(nodeRemoved(Node*)), this, SLOT(slotNodeRemoved(Node*)) );
         connect( m_project, SIGNAL(projectCalculated(ScheduleManager*)), this, SLOT(slotProjectCalculated(ScheduleManager*)));
+        connect( m_project, SIGNAL(scheduleManagerChanged(ScheduleManager*)), this, SLOT(slotScheduleManagerChanged(ScheduleManager*)) );
+        connect( m_project, SIGNAL(scheduleChanged(MainSchedule*)), this, SLOT(slotScheduleChanged(MainSchedule*)) );
+        connect( m_project, SIGNAL(resourceChanged(Resource*)), this, SLOT(slotResourceChanged()) );
     }
     endResetModel();
 }
 
 void NodeItemModel::setScheduleManager( ScheduleManager *sm )
 {
-    beginResetModel();
     if (sm == m_nodemodel.manager()) {
-        endResetModel();
         return;
     }
-    if ( m_nodemodel.manager() ) {
-    }
     m_nodemodel.setManager( sm );
     ItemModelBase::setScheduleManager( sm );
-    if ( sm ) {
-    }
     debugPlan<<this<<sm;
-    endResetModel();
+    // the rows do not depend on the schedule, so there is no need to reset the model
+    clearValueCache();
+    allDataChanged();
 }
 
 Qt::ItemFlags NodeItemModel::flags( const QModelIndex &index ) const
@@ -3669,6 +3780,22 @@ QVariant NodeItemModel::data( const QModelIndex &index, int role ) const
         return n ? QVariant::fromValue( static_cast<QObject*>( n ) ) : QVariant();
     }
     QVariant result;
+    // values read while a schedule is calculated are not final
+    if ( n != 0 && isCachedValue( index.column(), role ) && ! ( m_manager && m_manager->scheduling() ) ) {
+        if ( m_cacheId != id() ) {
+            m_valueCache.clear();
+            m_cacheId = id();
+        }
+        QHash<QPair<int, int>, QVariant> &values = m_valueCache[ n ];
+        const QPair<int, int> key( index.column(), role );
+        QHash<QPair<int, int>, QVariant>::const_iterator it = values.constFind( key );
+        if ( it != values.constEnd() ) {
+            return it.value();
+        }
+        result = m_nodemodel.data( n, index.column(), role );
+        values.insert( key, result );
+        return result;
+    }
     if ( n != 0 ) {
         result = m_nodemodel.data( n, index.column(), role );
         //debugPlan<<n->name()<<": "<<index.column()<<", "<<role<<result;
@@ -4189,16 +4316,10 @@ Node *NodeItemModel::node( const QModelIndex &index ) const
 
 void NodeItemModel::slotNodeChanged( Node *node )
 {
-    if ( node == 0 || ( ! m_projectshown && node->type() == Node::Type_Project ) ) {
-        return;
-    }
-    if ( node->type() == Node::Type_Project ) {
-        emit dataChanged( createIndex( 0, 0, node ), createIndex( 0, columnCount()-1, node ) );
+    if ( node == 0 ) {
         return;
     }
-    int row = node->parentNode()->findChildNode( node );
-    Q_ASSERT( row >= 0 );
-    emit dataChanged( createIndex( row, 0, node ), createIndex( row, columnCount()-1, node ) );
+    nodeValuesChanged( node );
 }
 
 QModelIndex NodeItemModel::insertTask( Node *node, Node *after )
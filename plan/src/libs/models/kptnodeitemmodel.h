@@ -25,7 +25,9 @@
 #include "kptworkpackagemodel.h"
 
 #include <QDate>
+#include <QHash>
 #include <QMetaEnum>
+#include <QPair>
 #include <QSortFilterProxyModel>
 #include <QUrl>
 
@@ -353,8 +355,19 @@ protected Q_SLOTS:
 
     virtual void slotLayoutChanged();
     virtual void slotProjectCalculated( ScheduleManager *sm );
+    void slotScheduleManagerChanged( ScheduleManager *sm );
+    void slotScheduleChanged( MainSchedule *sch );
+    void slotResourceChanged();
 
 protected:
+    /// Returns true if @p role of the calculated @p column is kept in the value cache
+    static bool isCachedValue( int column, int role );
+    void clearValueCache();
+    /// Removes @p node and its parents from the value cache and emits dataChanged() for them
+    void nodeValuesChanged( Node *node );
+    /// Emits dataChanged() for all the rows below @p parent
+    void allDataChanged( const QModelIndex &parent = QModelIndex() );
+
     virtual bool setType( Node *node, const QVariant &value, int role );
     bool setCompletion( Node *node, const QVariant &value, int role );
     bool setAllocation( Node *node, const QVariant &value, int role );
@@ -369,6 +382,9 @@ protected:
     Node *m_node; // for sanety check
     NodeModel m_nodemodel;
     bool m_projectshown;
+    /// The values of the calculated columns per node, valid for schedule m_cacheId
+    mutable QHash<const Node*, QHash<QPair<int, int>, QVariant> > m_valueCache;
+    mutable long m_cacheId;
 };
 
 //--------------------------------------
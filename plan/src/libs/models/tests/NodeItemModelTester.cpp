@@ -0,0 +1,169 @@
+/* This file is part of the KDE project
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+   Boston, MA 02110-1301, USA.
+*/
+#include "NodeItemModelTester.h"
+
+#include "kptdatetime.h"
+#include "kptnode.h"
+#include "kpttask.h"
+#include "kptschedule.h"
+#include "kptschedulerplugin.h"
+
+#include <QModelIndex>
+#include <QSignalSpy>
+
+#include <QTest>
+
+namespace KPlato
+{
+
+// Calculates a copy of the project the way the scheduler plugins do
+class TestSchedulerThread : public SchedulerThread
+{
+public:
+    TestSchedulerThread( Project *project, ScheduleManager *sm )
+        : SchedulerThread( project, sm, 0 )
+    {}
+
+protected:
+    void run()
+    {
+        m_project = new Project();
+        loadProject( m_project, m_pdoc );
+        m_manager = m_project->scheduleManager( m_mainmanagerId );
+        m_project->calculate( m_manager->expected() );
+    }
+};
+
+class TestSchedulerPlugin : public SchedulerPlugin
+{
+public:
+    TestSchedulerPlugin() : SchedulerPlugin( 0 ), model( 0 ), node( 0 ) {}
+
+    void calculate( Project &project, ScheduleManager *sm, bool nothread = false )
+    {
+        Q_UNUSED( nothread );
+        sm->setScheduling( true );
+        TestSchedulerThread job( &project, sm );
+        if ( model ) {
+            // views repaint while the job runs
+            model->data( model->index( node, NodeModel::NodeEndTime ) );
+        }
+        job.doRun();
+        updateProject( job.project(), job.manager(), &project, sm );
+        sm->setScheduling( false );
+    }
+
+    NodeItemModel *model;
+    Node *node;
+};
+
+void NodeItemModelTester::initTestCase()
+{
+    m_project = new Project();
+    m_project->setName( "P1" );
+    m_project->setId( m_project->uniqueNodeId() );
+    m_project->registerNodeId( m_project );
+    DateTime targetstart = DateTime( QDate::currentDate(), QTime(0,0,0) );
+    DateTime targetend = DateTime( targetstart.addDays( 10 ) );
+    m_project->setConstraintStartTime( targetstart );
+    m_project->setConstraintEndTime( targetend);
+
+    m_summary = m_project->createTask();
+    m_summary->setName( "S1" );
+    m_project->addTask( m_summary, m_project );
+
+    m_task = m_project->createTask();
+    m_task->setName( "T1" );
+    m_project->addSubTask( m_task, m_summary );
+    m_task->estimate()->setUnit( Duration::Unit_d );
+    m_task->estimate()->setExpectedEstimate( 1.0 );
+    m_task->estimate()->setType( Estimate::Type_Duration );
+
+    m_model.setProject( m_project );
+}
+
+void NodeItemModelTester::cleanupTestCase()
+{
+    m_model.setProject( 0 );
+    delete m_project;
+}
+
+void NodeItemModelTester::cachedValues()
+{
+    ScheduleManager *sm = m_project->createScheduleManager( "Test Plan" );
+    m_project->addScheduleManager( sm );
+    sm->createSchedules();
+    m_project->calculate( *sm );
+
+    QSignalSpy resetSpy( &m_model, SIGNAL(modelReset()) );
+    QSignalSpy changedSpy( &m_model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)) );
+    m_model.setScheduleManager( sm );
+    QCOMPARE( resetSpy.count(), 0 );
+    QVERIFY( changedSpy.count() > 0 );
+
+    QModelIndex summary = m_model.index( m_summary, NodeModel::NodeEndTime );
+    QModelIndex task = m_model.index( m_task, NodeModel::NodeEndTime );
+    QVariant summaryEnd = m_model.data( summary );
+    QVariant taskEnd = m_model.data( task );
+    QVERIFY( ! taskEnd.toString().isEmpty() );
+    QCOMPARE( m_model.data( task ), taskEnd );
+
+    // a change of a task also updates the summary task it belongs to
+    changedSpy.clear();
+    m_task->estimate()->setExpectedEstimate( 2.0 );
+    bool summaryChanged = false;
+    foreach ( const QList<QVariant> &args, changedSpy ) {
+        if ( args.at( 0 ).value<QModelIndex>().internalPointer() == m_summary ) {
+            summaryChanged = true;
+        }
+    }
+    QVERIFY( summaryChanged );
+
+    // recalculating gives the new values, without a model reset
+    changedSpy.clear();
+    sm->createSchedules();
+    m_project->calculate( *sm );
+    QCOMPARE( resetSpy.count(), 0 );
+    QVERIFY( changedSpy.count() > 0 );
+    QVERIFY( m_model.data( task ) != taskEnd );
+    QVERIFY( m_model.data( summary ) != summaryEnd );
+}
+
+void NodeItemModelTester::cachedValuesSchedulerPlugin()
+{
+    ScheduleManager *sm = m_project->createScheduleManager( "Plugin Plan" );
+    m_project->addScheduleManager( sm );
+    m_model.setScheduleManager( sm );
+
+    // an unscheduled manager has no values
+    QModelIndex task = m_model.index( m_task, NodeModel::NodeEndTime );
+    QVERIFY( m_model.data( task ).toString().isEmpty() );
+
+    TestSchedulerPlugin plugin;
+    plugin.model = &m_model;
+    plugin.node = m_task;
+    QSignalSpy changedSpy( &m_model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)) );
+    plugin.calculate( *m_project, sm );
+    QVERIFY( changedSpy.count() > 0 );
+    QVERIFY( ! m_model.data( task ).toString().isEmpty() );
+    QCOMPARE( m_model.data( task ), m_model.data( task ) );
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN( KPlato::NodeItemModelTester )
@@ -240,6 +240,20 @@ void ScheduleEditor::updateActionsEnabled( const QModelIndex &index )
     slotEnableActions();
 }
 
+// The schedules that can be calculated without asking for a time to re-calculate from
+static QList<ScheduleManager*> calculableManagers( const Project *project )
+{
+    QList<ScheduleManager*> lst;
+    if ( project ) {
+        foreach ( ScheduleManager *sm, project->scheduleManagers() ) {
+            if ( ! sm->scheduling() && sm->childCount() == 0 && ! sm->isBaselined() ) {
+                lst << sm;
+            }
+        }
+    }
+    return lst;
+}
+
 void ScheduleEditor::slotEnableActions()
 {
     if ( ! isReadWrite() ) {
@@ -247,10 +261,12 @@ void ScheduleEditor::slotEnableActions()
         actionAddSubSchedule->setEnabled( false );
         actionDeleteSelection->setEnabled( false );
         actionCalculateSchedule->setEnabled( false );
+        actionCalculateAllSchedules->setEnabled( false );
         actionBaselineSchedule->setEnabled( false );
         actionMoveLeft->setEnabled( false );
         return;
     }
+    actionCalculateAllSchedules->setEnabled( ! calculableManagers( project() ).isEmpty() );
     QModelIndexList lst = m_view->selectedRows();
     if ( lst.isEmpty() ) {
         actionAddSchedule->setEnabled( true );
@@ -317,6 +333,12 @@ void ScheduleEditor::setupGui()
     connect( actionCalculateSchedule, SIGNAL(triggered(bool)), SLOT(slotCalculateSchedule()) );
     addAction( name, actionCalculateSchedule );
 
+    actionCalculateAllSchedules  = new QAction(koIcon("view-time-schedule-calculus"), i18n("Calculate All"), this);
+    actionCalculateAllSchedules->setToolTip( i18nc( "@info:tooltip", "Calculate all schedules that have no sub-schedules" ) );
+    actionCollection()->addAction("calculate_all_schedules", actionCalculateAllSchedules );
+    connect( actionCalculateAllSchedules, SIGNAL(triggered(bool)), SLOT(slotCalculateAllSchedules()) );
+    addAction( name, actionCalculateAllSchedules );
+
     actionBaselineSchedule  = new QAction(koIcon("view-time-schedule-baselined-add"), i18n("Baseline"), this);
 //    actionCollection()->setDefaultShortcut(actionBaselineSchedule, Qt::CTRL + Qt::Key_B);
     actionCollection()->addAction("schedule_baseline", actionBaselineSchedule );
@@ -369,6 +391,14 @@ void ScheduleEditor::slotCalculateSchedule()
     emit calculateSchedule( m_view->project(), sm );
 }
 
+void ScheduleEditor::slotCalculateAllSchedules()
+{
+    const QList<ScheduleManager*> lst = calculableManagers( project() );
+    if ( ! lst.isEmpty() ) {
+        emit calculateSchedules( project(), lst );
+    }
+}
+
 void ScheduleEditor::slotAddSchedule()
 {
     //debugPlan;
@@ -95,6 +95,7 @@ public:
     
 Q_SIGNALS:
     void calculateSchedule( Project*, ScheduleManager* );
+    void calculateSchedules( Project*, const QList<ScheduleManager*>& );
     void baselineSchedule( Project*, ScheduleManager* );
     void addScheduleManager( Project* );
     void deleteScheduleManager( Project*, ScheduleManager* );
@@ -124,6 +125,7 @@ private Q_SLOTS:
     void slotEnableActions();
 
     void slotCalculateSchedule();
+    void slotCalculateAllSchedules();
     void slotBaselineSchedule();
     void slotAddSchedule();
     void slotAddSubSchedule();
@@ -135,6 +137,7 @@ private:
     SchedulingRange *m_schedulingRange;
 
     QAction *actionCalculateSchedule;
+    QAction *actionCalculateAllSchedules;
     QAction *actionBaselineSchedule;
     QAction *actionAddSchedule;
     QAction *actionAddSubSchedule;
@@ -509,7 +509,11 @@ struct rcps_solver* rcps_solver_new() {
 	// XXX look at error code, perhaps use an if to not use the lock if there is
 	// only one thread
 	//pthread_init();
-	assert(pthread_mutex_init(&ret->lock, NULL) == 0);
+	{
+		int result = pthread_mutex_init(&ret->lock, NULL);
+		assert(result == 0);
+		(void)result;
+	}
 #endif
 	return ret;
 }
@@ -517,7 +521,7 @@ struct rcps_solver* rcps_solver_new() {
 void rcps_solver_free(struct rcps_solver *s) {
 #ifdef HAVE_PTHREAD	
 	// XXX look at error code
-	assert(pthread_mutex_destroy(&s->lock) == 0);
+	pthread_mutex_destroy(&s->lock);
 #endif
 	free(s);
 }
@@ -711,22 +715,11 @@ struct rcps_population *new_population(struct rcps_solver *s,
 int run_alg(struct rcps_solver *s, struct rcps_problem *p) { 
 	/* run the algorithm */
 	int end = 0;
-	int count = 0;
 	int tcount = 0;
 	int lcount = 0;
-	struct rcps_fitness last_fitness;
-	int last_overuse = 1;
-	int breakoff_count = 0;
-	int desperate = 0;
-
-	last_fitness.group = FITNESS_MAX_GROUP;
-	last_fitness.weight = 0;
 
 	fflush(stderr);
 
-	// make this configurable
-	breakoff_count = 100000 / s->jobs;
-
 #ifdef HAVE_PTHREAD	
 	// XXX look at error code
 	pthread_mutex_lock(&s->lock);
@@ -809,18 +802,18 @@ int run_alg(struct rcps_solver *s, struct rcps_problem *p) {
 		best_overuse = son_overuse < daughter_overuse ?
 			son_overuse : daughter_overuse;
 		// check if we want to stop
-		if (rcps_fitness_cmp(&f1, &last_fitness) < 0) {
-			last_fitness = f1;
-			last_overuse = best_overuse;
-			count = 0;
+		if (rcps_fitness_cmp(&f1, &s->last_fitness) < 0) {
+			s->last_fitness = f1;
+			s->last_overuse = best_overuse;
+			s->stale_count = 0;
 		}
-		count++;
+		s->stale_count++;
 		tcount++;
-		if (count >= breakoff_count) {
-			if ((last_overuse > 0) && (!desperate)) {
+		if (s->stale_count >= s->breakoff_count) {
+			if ((s->last_overuse > 0) && (!s->desperate)) {
 				// we are going into desperate mode
-				desperate = 1;
-				breakoff_count *= 10;
+				s->desperate = 1;
+				s->breakoff_count *= 10;
 				// XXX threading problem: do not do this because is affects
 				// other threads too! intead us desperate accordingly above
 /*				s->population->size *= 5;
@@ -832,13 +825,15 @@ int run_alg(struct rcps_solver *s, struct rcps_problem *p) {
 				end = 1;
 			}
 		}
-		// XXX if we use multiple threads, communicate to the others as well!
 		if (s->progress_callback) {
 			if (tcount >= (lcount + s->cb_steps)) {
-				end |= s->progress_callback(tcount, last_fitness, s->cb_arg);
+				end |= s->progress_callback(tcount, s->last_fitness, s->cb_arg);
 				lcount = tcount;
 			}
 		}
+		// tell the other threads to stop as well
+		s->end |= end;
+		end = s->end;
 	} while (!end);
 #ifdef HAVE_PTHREAD	
 	// XXX look at error code
@@ -857,9 +852,9 @@ void *threadfunc(void *a) {
 	struct thread_arg *args = (struct thread_arg*)a;
 	int tcount = run_alg(args->s, args->p);
 	// XXX can be moved to run_alg
-	assert(pthread_mutex_lock(&args->s->lock) == 0);
+	pthread_mutex_lock(&args->s->lock);
 	args->s->reproductions += tcount;
-	assert(pthread_mutex_unlock(&args->s->lock) == 0);
+	pthread_mutex_unlock(&args->s->lock);
 	return NULL;
 }
 #endif
@@ -950,6 +945,16 @@ void rcps_solver_solve(struct rcps_solver *s, struct rcps_problem *p) {
 	/* initialize the population */
 	s->population = new_population(s, p);
 
+	/* the stop criterion */
+	s->last_fitness.group = FITNESS_MAX_GROUP;
+	s->last_fitness.weight = 0;
+	s->last_overuse = 1;
+	s->stale_count = 0;
+	// make this configurable
+	s->breakoff_count = 100000;
+	s->desperate = 0;
+	s->end = 0;
+
 	/* here we run the algorithm */
 #ifdef HAVE_PTHREAD
 	if (s->jobs <= 1) {
@@ -972,6 +977,7 @@ void rcps_solver_solve(struct rcps_solver *s, struct rcps_problem *p) {
 			int result = pthread_join(threads[i], NULL);
 			assert(result == 0);
 		}
+		free(threads);
 	}
 #else
 	s->reproductions = run_alg(s, p);
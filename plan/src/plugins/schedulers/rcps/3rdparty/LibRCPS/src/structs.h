@@ -132,6 +132,15 @@ struct rcps_solver {
 	int warnings;
 	// the actual population;
 	struct rcps_population *population;
+	// the stop criterion, shared by all threads so that it does not depend
+	// on their number: stop after breakoff_count reproductions without a
+	// better individual
+	struct rcps_fitness last_fitness;
+	int last_overuse;
+	int stale_count;
+	int breakoff_count;
+	int desperate;
+	int end;
 	// progress callback and data
 	int (*progress_callback)(int generations, struct rcps_fitness fitness, void *arg);
 	void *cb_arg;
@@ -33,6 +33,7 @@
 #include <KLocalizedString>
 
 #include <QApplication>
+#include <QThread>
 
 #ifndef PLAN_NOPLUGIN
 KPLATO_SCHEDULERPLUGIN_EXPORT(KPlatoRCPSPlugin, "planrcpsscheduler.json")
@@ -44,6 +45,8 @@ KPlatoRCPSPlugin::KPlatoRCPSPlugin( QObject * parent, const QVariantList & )
     : KPlato::SchedulerPlugin(parent)
 {
     debugPlan<<rcps_version();
+    // the solver breeds its population from several threads
+    setThreadCount( QThread::idealThreadCount() );
     m_granularities << (long unsigned int) 1 * 60 * 1000
                     << (long unsigned int) 15 * 60 * 1000
                     << (long unsigned int) 30 * 60 * 1000
@@ -86,6 +89,8 @@ void KPlatoRCPSPlugin::calculate( KPlato::Project &project, KPlato::ScheduleMana
     sm->setScheduling( true );
 
     KPlatoRCPSScheduler *job = new KPlatoRCPSScheduler( &project, sm, currentGranularity() );
+    job->setThreadCount( threadCount() );
+    job->setTimeBudget( timeBudget() );
     m_jobs << job;
     connect(job, SIGNAL(jobFinished(SchedulerThread*)), SLOT(slotFinished(SchedulerThread*)));
 
@@ -100,7 +105,7 @@ void KPlatoRCPSPlugin::calculate( KPlato::Project &project, KPlato::ScheduleMana
     if ( nothread ) {
         job->doRun();
     } else {
-        job->start();
+        startJob( job );
     }
 }
 
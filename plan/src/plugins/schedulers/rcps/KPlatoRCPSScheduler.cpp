@@ -28,6 +28,7 @@
 
 #include <librcps.h>
 
+#include <QDomDocument>
 #include <QString>
 #include <QTimer>
 #include <QMutexLocker>
@@ -58,7 +59,7 @@
 class ProgressInfo
 {
 public:
-    explicit ProgressInfo() : init( true ), base( 0 ), progress( 0 )
+    explicit ProgressInfo() : init( true ), base( 0 ), progress( 0 ), timeout( false )
     {
         fitness.group = 0;
         fitness.weight = 0;
@@ -66,6 +67,7 @@ public:
     bool init;
     int base;
     int progress;
+    bool timeout;
     struct rcps_fitness fitness;
 };
 
@@ -80,7 +82,10 @@ KPlatoRCPSScheduler::KPlatoRCPSScheduler( Project *project, ScheduleManager *sm,
     m_problem( 0 ),
     m_timeunit( granularity / 1000 ),
     m_offsetFromTime_t( 0 ),
-    m_progressinfo( new ProgressInfo() )
+    m_progressinfo( new ProgressInfo() ),
+    m_solverThreadCount( 1 ),
+    m_timeBudget( 0 ),
+    m_solveThread( 0 )
 {
     connect(this, SIGNAL(sigCalculationStarted(Project*,ScheduleManager*)), project, SIGNAL(sigCalculationStarted(Project*,ScheduleManager*)));
     emit sigCalculationStarted( project, sm );
@@ -96,6 +101,11 @@ KPlatoRCPSScheduler::~KPlatoRCPSScheduler()
     rcps_problem_free( m_problem );
 }
 
+void KPlatoRCPSScheduler::setTimeBudget( int msecs )
+{
+    m_timeBudget = qMax( 0, msecs );
+}
+
 int KPlatoRCPSScheduler::progress_callback( int generations, struct rcps_fitness fitness, void *arg )
 {
     if ( arg == 0 ) {
@@ -117,6 +127,14 @@ int KPlatoRCPSScheduler::progress( int generations, struct rcps_fitness fitness
         debugPlan<<"KPlatoRCPSScheduler::progress:"<<"stop";
         return -1;
     }
+    // the solver threads call this one at a time, each of them must be told to stop
+    if ( m_timeBudget > 0 && m_solveTimer.elapsed() > m_timeBudget ) {
+        if ( ! m_progressinfo->timeout ) {
+            m_progressinfo->timeout = true;
+            m_schedule->logInfo( i18n( "Scheduling stopped after %1 generations, time limit reached", generations ), 1 );
+        }
+        return 1;
+    }
 //     std::cout << "Progress after: " << generations << " generations\n";
     if ( m_progressinfo->init ) {
         if ( generations == 0 ) {
@@ -127,7 +145,8 @@ int KPlatoRCPSScheduler::progress( int generations, struct rcps_fitness fitness
 //             std::cout << "Population generated: "<< generations << "\n";
         }
     } else {
-        m_progressinfo->progress = PROGRESS_INIT_VALUE + generations;
+        // generations are counted per solver thread
+        m_progressinfo->progress = PROGRESS_INIT_VALUE + generations * m_solverThreadCount;
     }
     // detect change in fitness
     if ( rcps_fitness_cmp( &m_progressinfo->fitness, &fitness ) != 0 ) {
@@ -162,45 +181,106 @@ int KPlatoRCPSScheduler::duration( int direction, int time, int nominal_duration
     if ( m_haltScheduling || m_manager == 0 ) {
         return nominal_duration;
     }
-    ++(info->calls);
-    if ( info->cache.contains( QPair<int, int>( time, direction ) ) ) {
-        return info->cache[ QPair<int, int>( time, direction ) ];
+    const qint64 key = ( (qint64)time << 1 ) | direction;
+    {
+        QMutexLocker locker( &m_durationCacheMutex );
+        ++(info->calls);
+        QHash<qint64, int>::const_iterator it = info->cache.constFind( key );
+        if ( it != info->cache.constEnd() ) {
+            return it.value();
+        }
     }
     if ( m_manager->recalculate() && info->task->completion().isFinished() ) {
         return 0;
     }
+    Task *task = info->task;
+    QList<ResourceRequest*> requests = info->requests;
+    if ( QThread::currentThreadId() != m_solveThread ) {
+        // the calendars and resources cache their working intervals, so other
+        // threads calculate in their own copy of the project
+        task = threadTask( threadProject(), info, requests );
+        if ( task == 0 ) {
+            return nominal_duration;
+        }
+    }
     int dur = 0;
-    if ( info->task->constraint() == Node::FixedInterval ) {
+    if ( task->constraint() == Node::FixedInterval ) {
         // duration may depend on daylight saving so we need to calculate
         // NOTE: dur may not be correct if time != info->task->constraintStartTime, let's see what happends...
-        dur = ( info->task->constraintEndTime() - info->task->constraintStartTime() ).seconds() / m_timeunit;
-        info->task->schedule()->logDebug( QString( "Fixed interval: Time=%1, duration=%2 ( %3, %4 )" ).arg( time ).arg( dur ).arg( fromRcpsTime( time ).toString() ).arg( Duration( (qint64)(dur) * m_timeunit * 1000 ).toDouble( Duration::Unit_h ) ) );
+        dur = ( task->constraintEndTime() - task->constraintStartTime() ).seconds() / m_timeunit;
     } else if ( info->estimatetype == Estimate::Type_Effort ) {
-        if ( info->requests.isEmpty() ) {
+        if ( requests.isEmpty() ) {
             dur = info->estimate.seconds() / m_timeunit;
         } else {
-            dur = info->task->requests().duration(
-                        info->requests,
+            dur = task->requests().duration(
+                        requests,
                         fromRcpsTime( time ),
                         info->estimate,
                         0, /*no schedule*/
                         m_backward ? ! direction : direction
                     ).seconds() / m_timeunit;
-            //debugPlan<<info->task->name()<< QString( "duration_callback effort: backward=%5, direction=%6 (direction=%7); Time=%1, duration=%2 ( %3, %4 )" ).arg( time ).arg( dur ).arg( fromRcpsTime( time ).toString() ).arg( Duration( (qint64)(dur) * m_timeunit * 1000 ).toDouble( Duration::Unit_h ) ).arg( m_backward ).arg( direction ).arg( m_backward ? !direction : direction );
         }
     } else {
-        dur = info->task->length( 
+        dur = task->length(
                     fromRcpsTime( time ),
                     info->estimate,
                     0, /*no schedule*/
                     m_backward ? ! direction : direction
                 ).seconds() / m_timeunit;
     }
-    info->cache[ QPair<int, int>( time, direction ) ] = dur;
-    info->task->schedule()->logDebug( QString( "duration_callback: Time=%1, duration=%2 ( %3, %4 )" ).arg( time ).arg( dur ).arg( fromRcpsTime( time ).toString() ).arg( Duration( (qint64)(dur) * m_timeunit * 1000 ).toDouble( Duration::Unit_h ) ) );
+    QMutexLocker cachelocker( &m_durationCacheMutex );
+    info->cache.insert( key, dur );
     return dur;
 }
 
+KPlatoRCPSScheduler::thread_project *KPlatoRCPSScheduler::threadProject()
+{
+    const Qt::HANDLE id = QThread::currentThreadId();
+    {
+        QMutexLocker locker( &m_threadProjectMutex );
+        thread_project *tp = m_threadProjects.value( id );
+        if ( tp ) {
+            return tp;
+        }
+    }
+    // load outside the lock so the threads can do it in parallel
+    KoXmlDocument doc;
+    doc.setContent( m_threadProjectXml );
+    thread_project *tp = new thread_project;
+    tp->project = new Project();
+    loadProject( tp->project, doc );
+
+    QMutexLocker locker( &m_threadProjectMutex );
+    m_threadProjects.insert( id, tp );
+    return tp;
+}
+
+Task *KPlatoRCPSScheduler::threadTask( thread_project *tp, const duration_info *info, QList<ResourceRequest*> &requests )
+{
+    QHash<const duration_info*, QPair<Task*, QList<ResourceRequest*> > >::const_iterator it = tp->tasks.constFind( info );
+    if ( it != tp->tasks.constEnd() ) {
+        requests = it.value().second;
+        return it.value().first;
+    }
+    Task *task = dynamic_cast<Task*>( tp->project->findNode( info->task->id() ) );
+    if ( task == 0 ) {
+        errorPlan<<"Could not find task in the project copy:"<<info->task->name();
+        return 0;
+    }
+    requests.clear();
+    const QList<ResourceRequest*> lst = task->requests().resourceRequests();
+    foreach ( ResourceRequest *rr, info->requests ) {
+        foreach ( ResourceRequest *r, lst ) {
+            if ( r->resource()->id() == rr->resource()->id() ) {
+                requests << r;
+                break;
+            }
+        }
+    }
+    tp->tasks.insert( info, qMakePair( task, requests ) );
+    return task;
+}
+
 int KPlatoRCPSScheduler::weight_callback( int time, int duration, struct rcps_fitness *nominal_weight, void* weight_arg, void* fitness_arg )
 {
     //debugPlan<<"kplato_weight:"<<time<<nominal_weight<<arg;
@@ -245,7 +325,6 @@ int KPlatoRCPSScheduler::fitness( struct rcps_fitness *fit, KPlatoRCPSScheduler:
         fit->group = GROUP_CONSTRAINT;
         for ( ; it.key() == GROUP_CONSTRAINT && it != info->map.constEnd(); ++it ) {
             fit->weight += it.value().first;
-            QString s = it.value().second ? it.value().second->name() : "End node";
 //             std::cout << s.toLocal8Bit().data() << ": group=" << it.key() << " weight=" << it.value().first << "\n";
 //             m_schedule->logDebug( QString( "%3: %1 %2" ).arg( it.key() ).arg( it.value().first ).arg( it.value().second->name() ) );
         }
@@ -258,7 +337,6 @@ int KPlatoRCPSScheduler::fitness( struct rcps_fitness *fit, KPlatoRCPSScheduler:
         fit->group = GROUP_TARGETTIME;
         for ( ; it.key() == GROUP_TARGETTIME && it != info->map.constEnd(); ++it ) {
             fit->weight += it.value().first;
-            QString s = it.value().second ? it.value().second->name() : "End node";
 //             std::cout << s.toLocal8Bit().data() << ": group=" << it.key() << " weight=" << it.value().first << "\n";
 //             m_schedule->logDebug( QString( "%3: %1 %2" ).arg( it.key() ).arg( it.value().first ).arg( it.value().second->name() ) );
         }
@@ -268,7 +346,6 @@ int KPlatoRCPSScheduler::fitness( struct rcps_fitness *fit, KPlatoRCPSScheduler:
     fit->group = 0;
     for ( it = info->map.constBegin(); it != info->map.constEnd(); ++it ) {
         fit->weight += it.value().first;
-        QString s = it.value().second ? it.value().second->name() : "End node";
 //         std::cout << s.toLocal8Bit().data() << ": group=" << it.key() << " weight=" << it.value().first << "\n";
 //        m_schedule->logDebug( QString( "%3: %1 %2" ).arg( it.key() ).arg( it.value().first ).arg( it.value().second->name() ) );
     }
@@ -288,8 +365,8 @@ int KPlatoRCPSScheduler::weight( int time, int duration, struct rcps_fitness *no
     f.group = 0;
     f.weight = time;
     if ( info->isEndJob ) {
-        if ( info->finish == 0 ) {
-            info->finish = time;
+        // the weight info is shared by all solver threads
+        if ( info->finish.testAndSetRelaxed( 0, time ) ) {
 /*            const char *s = QString( "First  : %1 %2 %3 End job" ).arg( time, 10 ).arg( duration, 10 ).arg( w, 10 ).toLatin1();
             std::cout<<s<<"\n";*/
         }
@@ -492,10 +569,29 @@ void KPlatoRCPSScheduler::solve()
     Q_ASSERT( check() == 0 );
 
     rcps_solver_setparam( s, SOLVER_PARAM_POPSIZE, 1000 );
-
+    // ignored if librcps is built without thread support
+    rcps_solver_setparam( s, SOLVER_PARAM_JOBS, threadCount() );
+    m_solverThreadCount = rcps_solver_getparam( s, SOLVER_PARAM_JOBS );
+    m_schedule->logDebug( QString( "Solve using %1 threads, time limit: %2 ms" ).arg( m_solverThreadCount ).arg( m_timeBudget ), 1 );
+
+    m_solveThread = QThread::currentThreadId();
+    if ( m_solverThreadCount > 1 ) {
+        QDomDocument doc( "kplato" );
+        saveProject( m_project, doc );
+        m_threadProjectXml = doc.toString();
+    }
+    m_solveTimer.start();
     rcps_solver_solve( s, m_problem );
     result = rcps_solver_getwarnings( s );
     rcps_solver_free( s );
+
+    // the solver threads have finished
+    foreach ( thread_project *tp, m_threadProjects ) {
+        delete tp->project;
+        delete tp;
+    }
+    m_threadProjects.clear();
+    m_threadProjectXml.clear();
 }
 
 int KPlatoRCPSScheduler::kplatoToRCPS()
@@ -1038,7 +1134,7 @@ void KPlatoRCPSScheduler::addTasks()
     info->task = 0;
     info->targettime = toRcpsTime( m_targettime );
     info->isEndJob = true;
-    info->finish = 0;
+    info->finish.store( 0 );
 
     rcps_mode_set_weight_cbarg( mode, info );
     m_weight_info_list[ m_jobend ] = info;
@@ -1204,7 +1300,7 @@ void KPlatoRCPSScheduler::addRequest( rcps_job *job, Task *task )
     wi->task = task;
     wi->targettime = 0;
     wi->isEndJob = false;
-    wi->finish = 0;
+    wi->finish.store( 0 );
 
     rcps_mode_set_weight_cbarg( mode, wi );
     m_weight_info_list[ job ] = wi;
@@ -28,7 +28,11 @@
 #include <QThread>
 #include <QObject>
 #include <QMap>
+#include <QHash>
 #include <QList>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QElapsedTimer>
 
 class ProgressInfo;
 
@@ -59,8 +63,8 @@ private:
         Duration estimate;
         int estimatetype;
         QList<ResourceRequest*> requests;
-        // QPair< time, direction >, duration
-        QMap<QPair<int, int>, int> cache;
+        // ( time << 1 ) | direction, duration
+        QHash<qint64, int> cache;
         qint64 calls;
     };
 
@@ -70,7 +74,7 @@ private:
         Task *task;
         int targettime;
         bool isEndJob;
-        int finish;
+        QAtomicInt finish;
     };
 
     struct fitness_info
@@ -80,12 +84,23 @@ private:
         QList<Task*> jobs;
     };
 
+    /// A copy of the project used to calculate durations in one solver thread
+    struct thread_project
+    {
+        Project *project;
+        // the task and requests of a duration_info in this copy
+        QHash<const duration_info*, QPair<Task*, QList<ResourceRequest*> > > tasks;
+    };
+
 public:
     KPlatoRCPSScheduler( Project *project, ScheduleManager *sm, ulong granularity, QObject *parent = 0 );
     ~KPlatoRCPSScheduler();
 
     int check();
 
+    /// Stop solving after @p msecs milliseconds and use the best solution found. 0 means no limit.
+    void setTimeBudget( int msecs );
+
     int result;
 
     static int progress_callback( int generations, struct rcps_fitness fitness, void* arg );
@@ -141,6 +156,10 @@ protected:
 
 private:
     int toRcpsTime( const DateTime &time ) const;
+    /// The copy of the project used by the current solver thread, created on first use
+    thread_project *threadProject();
+    /// The task of @p info in the project copy @p tp, and its requests in @p requests
+    Task *threadTask( thread_project *tp, const duration_info *info, QList<ResourceRequest*> &requests );
     DateTime fromRcpsTime( int time ) const;
 
 private:
@@ -164,6 +183,18 @@ private:
 
     ProgressInfo *m_progressinfo;
     struct fitness_info fitness_init_arg;
+
+    /// The number of threads the solver uses, 1 if librcps is built without thread support
+    int m_solverThreadCount;
+    int m_timeBudget;
+    QElapsedTimer m_solveTimer;
+    // the solver calls the duration callback from all its threads
+    QMutex m_durationCacheMutex;
+    // the project is not thread safe, the other solver threads use their own copy
+    Qt::HANDLE m_solveThread;
+    QString m_threadProjectXml;
+    QMutex m_threadProjectMutex;
+    QHash<Qt::HANDLE, thread_project*> m_threadProjects;
 };
 
 #endif // KPLATORCPSPSCHEDULER_H
@@ -664,6 +664,60 @@ void ProjectTester::startNotEarlier()
     QCOMPARE( t->endTime(), t->startTime() + Duration( 0, 1, 0 ) );
 }
 
+void ProjectTester::solverThreads()
+{
+    Project project;
+    project.setName( "P1" );
+    project.setId( project.uniqueNodeId() );
+    project.registerNodeId( &project );
+    DateTime targetstart = DateTime( QDate( 2012, 2, 1 ), QTime(0,0,0) );
+    project.setConstraintStartTime( targetstart );
+    project.setConstraintEndTime( DateTime( targetstart.addDays( 14 ) ) );
+    createCalendar( project );
+
+    ResourceGroup *g = createWorkResources( project, 1 );
+    Resource *r1 = g->resourceAt( 0 );
+
+    QList<Task*> tasks;
+    for ( int i = 0; i < 4; ++i ) {
+        Task *t = project.createTask();
+        t->setName( QString( "T%1" ).arg( i + 1 ) );
+        project.addTask( t, &project );
+        t->estimate()->setUnit( Duration::Unit_d );
+        t->estimate()->setExpectedEstimate( 1.0 );
+        t->estimate()->setType( Estimate::Type_Effort );
+        createRequest( t, r1 );
+        tasks << t;
+    }
+
+    ScheduleManager *sm = project.createScheduleManager( "Threads" );
+    project.addScheduleManager( sm );
+    sm->createSchedules();
+
+    QString s = "Several solver threads with a time budget --------";
+    qDebug()<<endl<<"Testing:"<<s;
+    {
+        KPlatoRCPSPlugin rcps( 0, QVariantList() );
+        // the settings are available to users of any scheduler plugin
+        SchedulerPlugin *plugin = &rcps;
+        plugin->setThreadCount( 4 );
+        plugin->setTimeBudget( 100 );
+        QCOMPARE( rcps.threadCount(), 4 );
+        QCOMPARE( rcps.timeBudget(), 100 );
+        plugin->calculate( project, sm, true/*nothread*/ );
+    }
+    Debug::printSchedulingLog( *sm, s );
+
+    // the tasks share one resource, so they must not overlap
+    for ( int i = 0; i < tasks.count(); ++i ) {
+        QVERIFY( tasks.at( i )->startTime().isValid() );
+        QCOMPARE( tasks.at( i )->endTime(), tasks.at( i )->startTime() + Duration( 0, 8, 0 ) );
+        for ( int j = i + 1; j < tasks.count(); ++j ) {
+            QVERIFY( tasks.at( i )->endTime() <= tasks.at( j )->startTime() || tasks.at( j )->endTime() <= tasks.at( i )->startTime() );
+        }
+    }
+}
+
 } //namespace KPlato
 
 QTEST_GUILESS_MAIN( KPlato::ProjectTester )
@@ -43,6 +43,8 @@ private Q_SLOTS:
     void mustStartOn();
     void startNotEarlier();
 
+    void solverThreads();
+
 private:
     Project *m_project;
     Calendar *m_calendar;
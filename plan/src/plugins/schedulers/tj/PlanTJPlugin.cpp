@@ -94,7 +94,7 @@ void PlanTJPlugin::calculate( KPlato::Project &project, KPlato::ScheduleManager
     if ( nothread ) {
         job->doRun();
     } else {
-        job->start();
+        startJob( job );
     }
 }
 
@@ -17,7 +17,10 @@
 #include "Project.h"
 
 #include <stdlib.h>
+#include <QHash>
 #include <QList>
+#include <QMap>
+#include <QVector>
 #include <QString>
 #include <QStringList>
 #include <QDebug>
@@ -94,7 +97,9 @@ Project::Project() :
 //     reports(),
 //     interactiveReports(),
     sourceFiles(),
-    breakFlag(false)
+    breakFlag(false),
+    changedTasks(),
+    collectChangedTasks(false)
 {
     qDebug()<<"Project:"<<this;
     /* Pick some reasonable initial number since we don't know the
@@ -821,6 +826,86 @@ Project::finishScenario(int sc)
     }
 }
 
+/* The leaf tasks that are ready to be scheduled, kept in the order of the
+ * sorted leaf task list. Instead of checking all leaf tasks after a task has
+ * been scheduled, only the tasks that were ready before and the tasks that
+ * changed meanwhile are checked again. */
+class ReadyTaskQueue
+{
+public:
+    explicit ReadyTaskQueue(const TaskList &leafTasks)
+        : leafTasks(leafTasks), done(leafTasks.count(), false), doneTasks(0)
+    {
+        for (int i = 0; i < leafTasks.count(); ++i)
+            index.insert(static_cast<Task*>(leafTasks.at(i)), i);
+    }
+
+    /// Checks all leaf tasks again.
+    void rescan()
+    {
+        ready.clear();
+        doneTasks = 0;
+        for (int i = 0; i < leafTasks.count(); ++i) {
+            Task *t = static_cast<Task*>(leafTasks.at(i));
+            done[i] = t->isSchedulingDone();
+            if (done[i])
+                ++doneTasks;
+            if (t->isReadyForScheduling())
+                ready.insert(i, t);
+        }
+    }
+
+    /// Checks the task again, tasks that are not leaf tasks are ignored.
+    void update(Task *t)
+    {
+        QHash<Task*, int>::const_iterator it = index.constFind(t);
+        if (it == index.constEnd())
+            return;
+        const int i = it.value();
+        if (t->isSchedulingDone() != done[i]) {
+            done[i] = !done[i];
+            doneTasks += done[i] ? 1 : -1;
+        }
+        if (t->isReadyForScheduling())
+            ready.insert(i, t);
+        else
+            ready.remove(i);
+    }
+
+    /// Replaces the ready tasks by @p tasks.
+    void setTasks(const TaskList &tasks)
+    {
+        ready.clear();
+        foreach (CoreAttributes *t, tasks)
+            ready.insert(index.value(static_cast<Task*>(t)), static_cast<Task*>(t));
+    }
+
+    TaskList tasks() const
+    {
+        TaskList list;
+        foreach (Task *t, ready)
+            list.append(t);
+        return list;
+    }
+
+    bool isEmpty() const { return ready.isEmpty(); }
+    int doneCount() const { return doneTasks; }
+
+private:
+    const TaskList &leafTasks;
+    QHash<Task*, int> index;
+    QVector<bool> done;
+    QMap<int, Task*> ready;
+    int doneTasks;
+};
+
+void
+Project::taskChanged(Task *task)
+{
+    if (collectChangedTasks && !task->hasSubs())
+        changedTasks.append(task);
+}
+
 TaskList Project::tasksReadyToBeScheduled(int sc, const TaskList& allLeafTasks)
 {
     TaskList workItems;
@@ -953,16 +1038,25 @@ Project::schedule(int sc)
     allLeafTasks.setSorting(CoreAttributesList::SequenceUp, 2);
     allLeafTasks.sort();
     maxProgress = allLeafTasks.count();
-    int sortedTasks = 0;
-    foreach (CoreAttributes *t, allLeafTasks) {
-        if (static_cast<Task*>(t)->isSchedulingDone())
-            sortedTasks++;
-    }
     /* The workItems list contains all tasks that are ready to be scheduled at
      * any given iteration. When a tasks has been scheduled completely, this
      * list needs to be updated again as some tasks may now have become ready
-     * to be scheduled. */
-    TaskList workItems = tasksReadyToBeScheduled(sc, allLeafTasks);
+     * to be scheduled. Only the tasks changed by scheduling the task can have
+     * become ready, so the tasks report their changes while scheduling. */
+    ReadyTaskQueue readyTasks(allLeafTasks);
+    changedTasks.clear();
+    collectChangedTasks = true;
+    /* When no task is ready, tasksReadyToBeScheduled() forces some tasks to
+     * be ready and can change other tasks on the way, so after that all
+     * tasks are checked again the next time. */
+    readyTasks.rescan();
+    bool rescan = readyTasks.isEmpty();
+    if (rescan) {
+        readyTasks.setTasks(tasksReadyToBeScheduled(sc, allLeafTasks));
+        changedTasks.clear();
+    }
+    int sortedTasks = readyTasks.doneCount();
+    TaskList workItems = readyTasks.tasks();
 
     bool done;
     /* While the scheduling process progresses, the list contains more and
@@ -1055,13 +1149,24 @@ Project::schedule(int sc)
             // Schedule this task for the current time slot.
             if (static_cast<Task*>(t)->schedule(sc, slot, scheduleGranularity))
             {
-                workItems = tasksReadyToBeScheduled(sc, allLeafTasks);
-                int oldSortedTasks = sortedTasks;
-                sortedTasks = 0;
-                foreach (CoreAttributes *t, allLeafTasks) {
-                    if (static_cast<Task*>(t)->isSchedulingDone())
-                        sortedTasks++;
+                if (rescan) {
+                    readyTasks.rescan();
+                } else {
+                    foreach (CoreAttributes *ready, readyTasks.tasks())
+                        readyTasks.update(static_cast<Task*>(ready));
+                    foreach (Task *changed, changedTasks)
+                        readyTasks.update(changed);
+                    readyTasks.update(static_cast<Task*>(t));
+                }
+                changedTasks.clear();
+                rescan = readyTasks.isEmpty();
+                if (rescan) {
+                    readyTasks.setTasks(tasksReadyToBeScheduled(sc, allLeafTasks));
+                    changedTasks.clear();
                 }
+                workItems = readyTasks.tasks();
+                int oldSortedTasks = sortedTasks;
+                sortedTasks = readyTasks.doneCount();
                 // Update the progress bar after every 10th completed tasks.
                 if (oldSortedTasks / 10 != sortedTasks / 10)
                 {
@@ -1072,6 +1177,8 @@ Project::schedule(int sc)
             }
         }
     } while (!done && !breakFlag);
+    collectChangedTasks = false;
+    changedTasks.clear();
 
     if (breakFlag)
     {
@@ -799,6 +799,14 @@ private:
     TaskList tasksReadyToBeScheduled(int sc, const TaskList &leafTasks);
     bool schedule(int sc);
 
+    friend class Task;
+    /**
+     * Called by a task when its start or end is set. While scheduling the
+     * changed leaf tasks are collected, as only these can have become ready
+     * to be scheduled.
+     */
+    void taskChanged(Task *task);
+
     bool checkSchedule(int sc) const;
 
     /// The start date of the project
@@ -939,6 +947,10 @@ private:
 
     // This flag is raised to abort the scheduling.
     bool breakFlag;
+
+    // The leaf tasks changed since the scheduler last looked at them.
+    QList<Task*> changedTasks;
+    bool collectChangedTasks;
 } ;
 
 } // namespace TJ
@@ -17,6 +17,8 @@
 
 #include <assert.h>
 
+#include <QtAlgorithms>
+
 #include "ResourceTreeIterator.h"
 
 #include "Project.h"
@@ -61,7 +63,10 @@ Resource::Resource(Project* p, const QString& i, const QString& n,
     specifiedBookings(new SbBooking**[p->getMaxScenarios()]),
     scoreboards(new SbBooking**[p->getMaxScenarios()]),
     scenarios(new ResourceScenario[p->getMaxScenarios()]),
-    allocationProbability(new double[p->getMaxScenarios()])
+    allocationProbability(new double[p->getMaxScenarios()]),
+    bookedSlotMap(),
+    workSlotMap(),
+    slotMapScoreboard(0)
 {
 //     vacations.setAutoDelete(true);
 //     shifts.setAutoDelete(true);
@@ -282,6 +287,7 @@ void
 Resource::initScoreboard()
 {
     scoreboard = new SbBooking*[sbSize];
+    slotMapScoreboard = 0;
 
     // First mark all scoreboard slots as unavailable (1).
     for (uint i = 0; i < sbSize; i++)
@@ -321,6 +327,47 @@ Resource::initScoreboard()
     }
 }
 
+void
+Resource::updateSlotMaps()
+{
+    if (slotMapScoreboard == scoreboard)
+        return;
+
+    const int words = (sbSize + 63) / 64;
+    bookedSlotMap.fill(0, words);
+    workSlotMap.fill(0, words);
+    for (uint i = 0; i < sbSize; ++i)
+    {
+        const quint64 bit = Q_UINT64_C(1) << (i % 64);
+        if (scoreboard[i] >= (SbBooking*) 4)
+        {
+            bookedSlotMap[i / 64] |= bit;
+            workSlotMap[i / 64] |= bit;
+        }
+        else if (scoreboard[i] == (SbBooking*) 0)
+            workSlotMap[i / 64] |= bit;
+    }
+    slotMapScoreboard = scoreboard;
+}
+
+uint
+Resource::countSlots(const QVector<quint64>& map, uint startIdx, uint endIdx) const
+{
+    // Mask out the slots before startIdx in the first and after endIdx in
+    // the last word.
+    const uint startWord = startIdx / 64;
+    const uint endWord = endIdx / 64;
+    const quint64 startMask = ~Q_UINT64_C(0) << (startIdx % 64);
+    const quint64 endMask = ~Q_UINT64_C(0) >> (63 - endIdx % 64);
+    if (startWord == endWord)
+        return qPopulationCount(map[startWord] & startMask & endMask);
+
+    uint count = qPopulationCount(map[startWord] & startMask);
+    for (uint w = startWord + 1; w < endWord; ++w)
+        count += qPopulationCount(map[w]);
+    return count + qPopulationCount(map[endWord] & endMask);
+}
+
 uint
 Resource::sbIndex(time_t date) const
 {
@@ -388,18 +435,10 @@ Resource::isAvailable(time_t date)
 //         TJMH.debugMessage(QString("Resource is available today (%1) ").arg(time2ISO(date)), this);
         return 0;
     }
+    updateSlotMaps();
     if (limits && limits->getDailyUnits() > 0) {
-        int bookedSlots = 1;
-        int workSlots = 0;
-        for (uint i = DayStartIndex[sbIdx]; i <= DayEndIndex[sbIdx]; i++) {
-            SbBooking* b = scoreboard[i];
-            if (b == (SbBooking*) 0) {
-                ++workSlots;
-            } else if (b >= (SbBooking*) 4) {
-                ++workSlots;
-                ++bookedSlots;
-            }
-        }
+        int bookedSlots = 1 + countSlots(bookedSlotMap, DayStartIndex[sbIdx], DayEndIndex[sbIdx]);
+        int workSlots = countSlots(workSlotMap, DayStartIndex[sbIdx], DayEndIndex[sbIdx]);
         if ( workSlots > 0 ) {
             workSlots = (workSlots * limits->getDailyUnits()) / 100;
             if (workSlots == 0) {
@@ -417,16 +456,7 @@ Resource::isAvailable(time_t date)
     else if ((limits && limits->getDailyMax() > 0))
     {
         // Now check that the resource is not overloaded on this day.
-        uint bookedSlots = 1;
-
-        for (uint i = DayStartIndex[sbIdx]; i <= DayEndIndex[sbIdx]; i++)
-        {
-            SbBooking* b = scoreboard[i];
-            if (b < (SbBooking*) 4)
-                continue;
-
-            bookedSlots++;
-        }
+        uint bookedSlots = 1 + countSlots(bookedSlotMap, DayStartIndex[sbIdx], DayEndIndex[sbIdx]);
 
         if (limits && limits->getDailyMax() > 0 &&
             bookedSlots > limits->getDailyMax())
@@ -441,16 +471,7 @@ Resource::isAvailable(time_t date)
     if ((limits && limits->getWeeklyMax() > 0))
     {
         // Now check that the resource is not overloaded on this week.
-        uint bookedSlots = 1;
-
-        for (uint i = WeekStartIndex[sbIdx]; i <= WeekEndIndex[sbIdx]; i++)
-        {
-            SbBooking* b = scoreboard[i];
-            if (b < (SbBooking*) 4)
-                continue;
-
-            bookedSlots++;
-        }
+        uint bookedSlots = 1 + countSlots(bookedSlotMap, WeekStartIndex[sbIdx], WeekEndIndex[sbIdx]);
 
         if (limits && limits->getWeeklyMax() > 0 &&
             bookedSlots > limits->getWeeklyMax())
@@ -463,16 +484,7 @@ Resource::isAvailable(time_t date)
     if ((limits && limits->getMonthlyMax() > 0))
     {
         // Now check that the resource is not overloaded on this month.
-        uint bookedSlots = 1;
-
-        for (uint i = MonthStartIndex[sbIdx]; i <= MonthEndIndex[sbIdx]; i++)
-        {
-            SbBooking* b = scoreboard[i];
-            if (b < (SbBooking*) 4)
-                continue;
-
-            bookedSlots++;
-        }
+        uint bookedSlots = 1 + countSlots(bookedSlotMap, MonthStartIndex[sbIdx], MonthEndIndex[sbIdx]);
 
         if (limits && limits->getMonthlyMax() > 0 &&
             bookedSlots > limits->getMonthlyMax())
@@ -502,6 +514,8 @@ Resource::bookSlot(uint idx, SbBooking* nb)
         delete nb;
         return false;
     }
+    if (slotMapScoreboard == scoreboard)
+        bookedSlotMap[idx / 64] |= Q_UINT64_C(1) << (idx % 64);
 
     SbBooking* b;
     // Try to merge the booking with the booking in the previous slot.
@@ -1253,6 +1267,7 @@ Resource::copyBookings(int sc, SbBooking*** src, SbBooking*** dst)
     /* This function copies a set of bookings the specified scenario. If the
      * destination set already contains bookings it is cleared first.
      */
+    slotMapScoreboard = 0;
     if (dst[sc])
         for (uint i = 0; i < sbSize; i++)
             if (dst[sc][i] >= (SbBooking*) 4)
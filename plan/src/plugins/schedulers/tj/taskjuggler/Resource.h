@@ -18,6 +18,8 @@
 
 #include "ResourceScenario.h"
 
+#include <QVector>
+
 class QDomDocument;
 class QDomElement;
 
@@ -212,6 +214,9 @@ private:
         const;
     void updateSlotMarks(int sc);
 
+    void updateSlotMaps();
+    uint countSlots(const QVector<quint64>& map, uint startIdx, uint endIdx) const;
+
     uint sbIndex(time_t date) const;
 
     time_t index2start(uint idx) const;
@@ -272,6 +277,17 @@ private:
      * account.
      */
     double* allocationProbability;
+
+    /**
+     * Bit maps of the scoreboard slots that are booked and of the slots
+     * that are working time (available or booked). The usage limits need
+     * the number of these slots for a whole day, week or month, and the
+     * maps allow counting them a word at a time.
+     */
+    QVector<quint64> bookedSlotMap;
+    QVector<quint64> workSlotMap;
+    /// The scoreboard the slot maps have been built for.
+    SbBooking** slotMapScoreboard;
 } ;
 
 } // namespace TJ
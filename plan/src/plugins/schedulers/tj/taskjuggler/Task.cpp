@@ -497,6 +497,7 @@ void
 Task::propagateStart(int sc, time_t date)
 {
     start = date;
+    project->taskChanged(this);
 
     if (DEBUGTS(11))
         qDebug()<<"PS1: Setting start of"<<this<<"to"<<time2tjp(start);
@@ -563,6 +564,7 @@ void
 Task::propagateEnd(int sc, time_t date)
 {
     end = date;
+    project->taskChanged(this);
 
     if (DEBUGTS(11))
         qDebug()<<"PE1: Setting end of"<<name<<"to"<<time2tjp(end);
@@ -0,0 +1,150 @@
+/* This file is part of the KDE project
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+   Boston, MA 02110-1301, USA.
+*/
+
+#include "CalculateAllTester.h"
+
+#include "PlanTJPlugin.h"
+
+#include "kptcalendar.h"
+#include "kptdatetime.h"
+#include "kptproject.h"
+#include "kpttask.h"
+#include "kptschedule.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+namespace KPlato
+{
+
+static bool calculationFinished( const QSignalSpy &spy, ScheduleManager *sm )
+{
+    foreach ( const QList<QVariant> &args, spy ) {
+        if ( args.value( 1 ).value<ScheduleManager*>() == sm ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CalculateAllTester::init()
+{
+    m_project = new Project();
+    m_project->setName( "P1" );
+    m_project->setId( m_project->uniqueNodeId() );
+    m_project->registerNodeId( m_project );
+    m_project->setConstraintStartTime( DateTime( QDate( 2012, 2, 1 ), QTime( 0, 0, 0 ) ) );
+    m_project->setConstraintEndTime( m_project->constraintStartTime().addDays( 7 ) );
+
+    Calendar *c = new Calendar();
+    c->setDefault( true );
+    QTime t1( 9, 0, 0 );
+    QTime t2 ( 17, 0, 0 );
+    int length = t1.msecsTo( t2 );
+    for ( int i = 1; i <= 7; ++i ) {
+        CalendarDay *d = c->weekday( i );
+        d->setState( CalendarDay::Working );
+        d->addInterval( t1, length );
+    }
+    m_project->addCalendar( c );
+
+    m_task = m_project->createTask();
+    m_task->setName( "T1" );
+    m_project->addTask( m_task, m_project );
+    m_task->estimate()->setUnit( Duration::Unit_d );
+    m_task->estimate()->setExpectedEstimate( 1.0 );
+    m_task->estimate()->setType( Estimate::Type_Duration );
+}
+
+void CalculateAllTester::cleanup()
+{
+    delete m_project;
+}
+
+void CalculateAllTester::calculateAll()
+{
+    PlanTJPlugin tj( 0, QVariantList() );
+    QMap<QString, SchedulerPlugin*> plugins;
+    plugins.insert( "tj", &tj );
+    m_project->setSchedulerPlugins( plugins );
+
+    ScheduleManager *sm1 = m_project->createScheduleManager( "sm1" );
+    m_project->addScheduleManager( sm1 );
+    ScheduleManager *sm2 = m_project->createScheduleManager( "sm2" );
+    m_project->addScheduleManager( sm2 );
+    ScheduleManager *child = m_project->createScheduleManager( "child" );
+    m_project->addScheduleManager( child, sm1 );
+
+    // one job at a time, so sm2 is queued and child waits for sm1
+    tj.setMaxJobs( 1 );
+    QSignalSpy spy( &tj, SIGNAL(sigCalculationFinished(Project*,ScheduleManager*)) );
+    tj.calculateAll( *m_project, QList<ScheduleManager*>() << child << sm2 << sm1 );
+
+    QTRY_COMPARE_WITH_TIMEOUT( spy.count(), 3, 20000 );
+    // the sub-schedule is calculated after its parent
+    int sm1Index = -1;
+    int childIndex = -1;
+    for ( int i = 0; i < spy.count(); ++i ) {
+        ScheduleManager *sm = spy.at( i ).value( 1 ).value<ScheduleManager*>();
+        if ( sm == sm1 ) {
+            sm1Index = i;
+        } else if ( sm == child ) {
+            childIndex = i;
+        }
+    }
+    QVERIFY( sm1Index >= 0 );
+    QVERIFY( childIndex > sm1Index );
+
+    foreach ( ScheduleManager *sm, QList<ScheduleManager*>() << sm1 << sm2 << child ) {
+        QCOMPARE( sm->calculationResult(), (int)ScheduleManager::CalculationDone );
+        QVERIFY( ! sm->scheduling() );
+        QCOMPARE( m_task->startTime( sm->scheduleId() ), m_project->startTime( sm->scheduleId() ) );
+        QCOMPARE( m_task->endTime( sm->scheduleId() ), m_task->startTime( sm->scheduleId() ) + Duration( 1, 0, 0 ) );
+    }
+}
+
+void CalculateAllTester::haltParent()
+{
+    PlanTJPlugin tj( 0, QVariantList() );
+    QMap<QString, SchedulerPlugin*> plugins;
+    plugins.insert( "tj", &tj );
+    m_project->setSchedulerPlugins( plugins );
+
+    ScheduleManager *sm1 = m_project->createScheduleManager( "sm1" );
+    m_project->addScheduleManager( sm1 );
+    ScheduleManager *sm2 = m_project->createScheduleManager( "sm2" );
+    m_project->addScheduleManager( sm2 );
+    ScheduleManager *child = m_project->createScheduleManager( "child" );
+    m_project->addScheduleManager( child, sm1 );
+
+    tj.setMaxJobs( 1 );
+    QSignalSpy spy( &tj, SIGNAL(sigCalculationFinished(Project*,ScheduleManager*)) );
+    tj.calculateAll( *m_project, QList<ScheduleManager*>() << sm1 << child << sm2 );
+    tj.haltCalculation( sm1 );
+    QCOMPARE( sm1->calculationResult(), (int)ScheduleManager::CalculationCanceled );
+
+    // sm2 is still calculated, the sub-schedule of the halted schedule is not
+    QTRY_VERIFY_WITH_TIMEOUT( calculationFinished( spy, sm2 ), 20000 );
+    QTest::qWait( 100 );
+    QVERIFY( ! calculationFinished( spy, child ) );
+    QVERIFY( ! child->scheduling() );
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN( KPlato::CalculateAllTester )
@@ -25,6 +25,13 @@
 #include <colorprofiles/LcmsColorProfileContainer.h>
 #include <KoColorSpaceAbstract.h>
 
+#include <QColor>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QSharedPointer>
+#include <QThreadStorage>
+
 class LcmsColorProfileContainer;
 
 class KoLcmsInfo
@@ -151,13 +158,103 @@ class LcmsColorSpace : public KoColorSpaceAbstract<_CSTraits>, public KoLcmsInfo
         cmsHTRANSFORM cmsAlphaTransform;
     };
 
+    /**
+     * State of the QColor conversions of one thread, so the conversions need no locking.
+     * The transforms to and from the RGB profiles other than the default sRGB one are
+     * created on first use, and the last converted colors are remembered since the
+     * same few colors tend to be converted over and over again by the user interface.
+     */
+    struct QColorConverter {
+        enum { MemoSize = 8 };
+        /// the number of transforms kept for RGB profiles other than the default one
+        enum { MaxTransforms = 8 };
+
+        /// a remembered conversion between a QColor and a pixel, the most recently used come first
+        struct Conversion {
+            cmsHTRANSFORM transform;
+            QRgb rgba;
+            quint8 pixel[_CSTraits::pixelSize];
+        };
+
+        QColorConverter() : fromQColorCount(0), toQColorCount(0) {}
+
+        ~QColorConverter()
+        {
+            clearTransforms();
+        }
+
+        /// Frees the transforms of the RGB profiles and forgets the conversions done with them
+        void clearTransforms()
+        {
+            foreach (cmsHTRANSFORM transform, fromRGB) {
+                cmsDeleteTransform(transform);
+            }
+            foreach (cmsHTRANSFORM transform, toRGB) {
+                cmsDeleteTransform(transform);
+            }
+            fromRGB.clear();
+            toRGB.clear();
+            fromQColorCount = 0;
+            toQColorCount = 0;
+        }
+
+        /// Moves the entry at @p index to the front and returns it
+        static Conversion &use(Conversion *conversions, int index)
+        {
+            if (index > 0) {
+                const Conversion conversion = conversions[index];
+                memmove(conversions + 1, conversions, index * sizeof(Conversion));
+                conversions[0] = conversion;
+            }
+            return conversions[0];
+        }
+
+        /// Makes room for a new conversion at the front, dropping the least recently used one
+        static Conversion &add(Conversion *conversions, int &count)
+        {
+            if (count < MemoSize) {
+                ++count;
+            }
+            return use(conversions, count - 1);
+        }
+
+        // keyed by the unique id of the RGB profile, profiles are not shared between color spaces
+        QHash<QByteArray, cmsHTRANSFORM> fromRGB;
+        QHash<QByteArray, cmsHTRANSFORM> toRGB;
+        QVector<quint8> rgbBuffer; // BGR pixels for the batched conversions
+        Conversion fromQColorMemo[MemoSize];
+        int fromQColorCount;
+        Conversion toQColorMemo[MemoSize];
+        int toQColorCount;
+    };
+
     struct Private {
-        mutable quint8 *qcolordata; // A small buffer for conversion from and to qcolor.
-        KoLcmsDefaultTransformations *defaultTransformations;
+        ~Private()
+        {
+            // QThreadStorage does not free the data of the threads still running when it is
+            // destroyed, so the converters of other threads are freed here
+            qcolorConverters.setLocalData(QSharedPointer<QColorConverter>());
+            qDeleteAll(converters);
+        }
 
-        mutable cmsHPROFILE   lastRGBProfile;  // Last used profile to transform to/from RGB
-        mutable cmsHTRANSFORM lastToRGB;       // Last used transform to transform to RGB
-        mutable cmsHTRANSFORM lastFromRGB;     // Last used transform to transform from RGB
+        /// frees a converter when its thread finishes
+        struct ConverterDeleter {
+            explicit ConverterDeleter(Private *d) : d(d) {}
+            void operator()(QColorConverter *converter) const
+            {
+                {
+                    QMutexLocker locker(&d->convertersMutex);
+                    d->converters.remove(converter);
+                }
+                delete converter;
+            }
+            Private *d;
+        };
+
+        KoLcmsDefaultTransformations *defaultTransformations;
+        QThreadStorage<QSharedPointer<QColorConverter> > qcolorConverters;
+        QSet<QColorConverter *> converters; // the converters of all threads
+        QMutex convertersMutex;
         LcmsColorProfileContainer *profile;
         KoColorProfile *colorProfile;
     };
@@ -178,27 +275,18 @@ protected:
         d->profile = asLcmsProfile(p);
         Q_ASSERT(d->profile);
         d->colorProfile = p;
-        d->qcolordata = 0;
-        d->lastRGBProfile = 0;
-        d->lastToRGB = 0;
-        d->lastFromRGB = 0;
         d->defaultTransformations = 0;
     }
 
     virtual ~LcmsColorSpace()
     {
         delete d->colorProfile;
-        delete[] d->qcolordata;
         delete d->defaultTransformations;
         delete d;
     }
 
     void init()
     {
-        // Default pixel buffer for QColor conversion
-        d->qcolordata = new quint8[3];
-        Q_CHECK_PTR(d->qcolordata);
-
         Q_ASSERT(d->profile);
 
         if (KoLcmsDefaultTransformations::s_RGBProfile == 0) {
@@ -245,52 +333,93 @@ public:
 
     virtual void fromQColor(const QColor &color, quint8 *dst, const KoColorProfile *koprofile = 0) const
     {
-        d->qcolordata[2] = color.red();
-        d->qcolordata[1] = color.green();
-        d->qcolordata[0] = color.blue();
-
-        LcmsColorProfileContainer *profile = asLcmsProfile(koprofile);
-        if (profile == 0) {
-            // Default sRGB
-            Q_ASSERT(d->defaultTransformations && d->defaultTransformations->fromRGB);
-
-            cmsDoTransform(d->defaultTransformations->fromRGB, d->qcolordata, dst, 1);
-        } else {
-            if (d->lastFromRGB == 0 || (d->lastFromRGB != 0 && d->lastRGBProfile != profile->lcmsProfile())) {
-                d->lastFromRGB = cmsCreateTransform(profile->lcmsProfile(),
-                                                    TYPE_BGR_8,
-                                                    d->profile->lcmsProfile(),
-                                                    this->colorSpaceType(),
-                                                    KoColorConversionTransformation::internalRenderingIntent(),
-                                                    KoColorConversionTransformation::internalConversionFlags());
-                d->lastRGBProfile = profile->lcmsProfile();
-
+        QColorConverter *converter = qcolorConverter();
+        const cmsHTRANSFORM transform = fromRGBTransform(converter, asLcmsProfile(koprofile));
+        const QRgb rgba = color.rgba();
+
+        for (int i = 0; i < converter->fromQColorCount; ++i) {
+            const typename QColorConverter::Conversion &conversion = converter->fromQColorMemo[i];
+            if (conversion.rgba == rgba && conversion.transform == transform) {
+                memcpy(dst, QColorConverter::use(converter->fromQColorMemo, i).pixel, _CSTraits::pixelSize);
+                return;
             }
-            cmsDoTransform(d->lastFromRGB, d->qcolordata, dst, 1);
         }
 
-        this->setOpacity(dst, (quint8)(color.alpha()), 1);
+        quint8 bgr[3];
+        bgr[2] = qRed(rgba);
+        bgr[1] = qGreen(rgba);
+        bgr[0] = qBlue(rgba);
+        cmsDoTransform(transform, bgr, dst, 1);
+        this->setOpacity(dst, quint8(qAlpha(rgba)), 1);
+
+        typename QColorConverter::Conversion &conversion = QColorConverter::add(converter->fromQColorMemo, converter->fromQColorCount);
+        conversion.transform = transform;
+        conversion.rgba = rgba;
+        memcpy(conversion.pixel, dst, _CSTraits::pixelSize);
     }
 
     virtual void toQColor(const quint8 *src, QColor *c, const KoColorProfile *koprofile = 0) const
     {
-        LcmsColorProfileContainer *profile = asLcmsProfile(koprofile);
-        if (profile == 0) {
-            // Default sRGB transform
-            Q_ASSERT(d->defaultTransformations && d->defaultTransformations->toRGB);
-            cmsDoTransform(d->defaultTransformations->toRGB, const_cast <quint8 *>(src), d->qcolordata, 1);
-        } else {
-            if (d->lastToRGB == 0 || (d->lastToRGB != 0 && d->lastRGBProfile != profile->lcmsProfile())) {
-                d->lastToRGB = cmsCreateTransform(d->profile->lcmsProfile(), this->colorSpaceType(),
-                                                  profile->lcmsProfile(), TYPE_BGR_8,
-                                                  KoColorConversionTransformation::internalRenderingIntent(),
-                                                  KoColorConversionTransformation::internalConversionFlags());
-                d->lastRGBProfile = profile->lcmsProfile();
+        QColorConverter *converter = qcolorConverter();
+        const cmsHTRANSFORM transform = toRGBTransform(converter, asLcmsProfile(koprofile));
+
+        for (int i = 0; i < converter->toQColorCount; ++i) {
+            const typename QColorConverter::Conversion &conversion = converter->toQColorMemo[i];
+            if (conversion.transform == transform && memcmp(conversion.pixel, src, _CSTraits::pixelSize) == 0) {
+                c->setRgba(QColorConverter::use(converter->toQColorMemo, i).rgba);
+                return;
             }
-            cmsDoTransform(d->lastToRGB, const_cast <quint8 *>(src), d->qcolordata, 1);
         }
-        c->setRgb(d->qcolordata[2], d->qcolordata[1], d->qcolordata[0]);
-        c->setAlpha(this->opacityU8(src));
+
+        quint8 bgr[3];
+        cmsDoTransform(transform, const_cast<quint8 *>(src), bgr, 1);
+        const QRgb rgba = qRgba(bgr[2], bgr[1], bgr[0], this->opacityU8(src));
+        c->setRgba(rgba);
+
+        typename QColorConverter::Conversion &conversion = QColorConverter::add(converter->toQColorMemo, converter->toQColorCount);
+        conversion.transform = transform;
+        conversion.rgba = rgba;
+        memcpy(conversion.pixel, src, _CSTraits::pixelSize);
+    }
+
+    virtual void fromQColors(const QVector<QColor> &colors, quint8 *dst, const KoColorProfile *koprofile = 0) const
+    {
+        if (colors.isEmpty()) {
+            return;
+        }
+        QColorConverter *converter = qcolorConverter();
+        converter->rgbBuffer.resize(3 * colors.size());
+        quint8 *bgr = converter->rgbBuffer.data();
+        foreach (const QColor &color, colors) {
+            const QRgb rgba = color.rgba();
+            bgr[2] = qRed(rgba);
+            bgr[1] = qGreen(rgba);
+            bgr[0] = qBlue(rgba);
+            bgr += 3;
+        }
+        cmsDoTransform(fromRGBTransform(converter, asLcmsProfile(koprofile)), converter->rgbBuffer.data(), dst, colors.size());
+
+        foreach (const QColor &color, colors) {
+            this->setOpacity(dst, quint8(color.alpha()), 1);
+            dst += _CSTraits::pixelSize;
+        }
+    }
+
+    virtual void toQColors(const quint8 *src, QColor *colors, quint32 nPixels, const KoColorProfile *koprofile = 0) const
+    {
+        if (nPixels == 0) {
+            return;
+        }
+        QColorConverter *converter = qcolorConverter();
+        converter->rgbBuffer.resize(3 * nPixels);
+        cmsDoTransform(toRGBTransform(converter, asLcmsProfile(koprofile)), const_cast<quint8 *>(src), converter->rgbBuffer.data(), nPixels);
+
+        const quint8 *bgr = converter->rgbBuffer.constData();
+        for (quint32 i = 0; i < nPixels; ++i) {
+            colors[i].setRgb(bgr[2], bgr[1], bgr[0], this->opacityU8(src));
+            bgr += 3;
+            src += _CSTraits::pixelSize;
+        }
     }
 
     virtual KoColorTransformation *createBrightnessContrastAdjustment(const quint16 *transferValues) const
@@ -420,6 +549,67 @@ public:
 
 private:
 
+    QColorConverter *qcolorConverter() const
+    {
+        if (!d->qcolorConverters.hasLocalData()) {
+            QColorConverter *converter = new QColorConverter;
+            {
+                QMutexLocker locker(&d->convertersMutex);
+                d->converters.insert(converter);
+            }
+            d->qcolorConverters.setLocalData(QSharedPointer<QColorConverter>(converter, typename Private::ConverterDeleter(d)));
+        }
+        return d->qcolorConverters.localData().data();
+    }
+
+    /// the cached transform from @p rgbProfile, the default sRGB one if it is 0
+    cmsHTRANSFORM fromRGBTransform(QColorConverter *converter, LcmsColorProfileContainer *rgbProfile) const
+    {
+        if (!rgbProfile) {
+            Q_ASSERT(d->defaultTransformations && d->defaultTransformations->fromRGB);
+            return d->defaultTransformations->fromRGB;
+        }
+        const QByteArray key = rgbProfile->uniqueId();
+        cmsHTRANSFORM transform = converter->fromRGB.value(key);
+        if (!transform) {
+            if (converter->fromRGB.size() >= QColorConverter::MaxTransforms) {
+                converter->clearTransforms();
+            }
+            transform = cmsCreateTransform(rgbProfile->lcmsProfile(),
+                                           TYPE_BGR_8,
+                                           d->profile->lcmsProfile(),
+                                           this->colorSpaceType(),
+                                           KoColorConversionTransformation::internalRenderingIntent(),
+                                           KoColorConversionTransformation::internalConversionFlags());
+            converter->fromRGB.insert(key, transform);
+        }
+        return transform;
+    }
+
+    /// the cached transform to @p rgbProfile, the default sRGB one if it is 0
+    cmsHTRANSFORM toRGBTransform(QColorConverter *converter, LcmsColorProfileContainer *rgbProfile) const
+    {
+        if (!rgbProfile) {
+            Q_ASSERT(d->defaultTransformations && d->defaultTransformations->toRGB);
+            return d->defaultTransformations->toRGB;
+        }
+        const QByteArray key = rgbProfile->uniqueId();
+        cmsHTRANSFORM transform = converter->toRGB.value(key);
+        if (!transform) {
+            if (converter->toRGB.size() >= QColorConverter::MaxTransforms) {
+                converter->clearTransforms();
+            }
+            transform = cmsCreateTransform(d->profile->lcmsProfile(),
+                                           this->colorSpaceType(),
+                                           rgbProfile->lcmsProfile(),
+                                           TYPE_BGR_8,
+                                           KoColorConversionTransformation::internalRenderingIntent(),
+                                           KoColorConversionTransformation::internalConversionFlags());
+            converter->toRGB.insert(key, transform);
+        }
+        return transform;
+    }
+
     inline LcmsColorProfileContainer *lcmsProfile() const
     {
         return d->profile;
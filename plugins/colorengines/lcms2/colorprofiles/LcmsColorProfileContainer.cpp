@@ -26,6 +26,7 @@
 
 #include <cfloat>
 #include <cmath>
+#include <QCryptographicHash>
 #include <QTransform>
 #include <QGenericMatrix>
 
@@ -39,6 +40,7 @@ public:
         , suitableForOutput(false) { }
 
     cmsHPROFILE profile;
+    QByteArray uniqueId;
     cmsColorSpaceSignature colorSpaceSignature;
     cmsProfileClassSignature deviceClass;
     QString productDescription;
@@ -132,6 +134,13 @@ bool LcmsColorProfileContainer::init()
 #endif
 
     if (d->profile) {
+        cmsUInt8Number profileId[16];
+        cmsGetHeaderProfileID(d->profile, profileId);
+        d->uniqueId = QByteArray(reinterpret_cast<const char *>(profileId), sizeof(profileId));
+        if (d->uniqueId.count('\0') == d->uniqueId.size()) {
+            d->uniqueId = QCryptographicHash::hash(d->data->rawData(), QCryptographicHash::Md5);
+        }
+
         wchar_t buffer[_BUFFER_SIZE_];
         d->colorSpaceSignature = cmsGetColorSpace(d->profile);
         d->deviceClass = cmsGetDeviceClass(d->profile);
@@ -247,6 +256,11 @@ cmsHPROFILE LcmsColorProfileContainer::lcmsProfile() const
     return d->profile;
 }
 
+QByteArray LcmsColorProfileContainer::uniqueId() const
+{
+    return d->uniqueId;
+}
+
 cmsColorSpaceSignature LcmsColorProfileContainer::colorSpaceSignature() const
 {
     return d->colorSpaceSignature;
@@ -75,6 +75,11 @@ public:
      * @return the structure to use with LCMS functions
      */
     cmsHPROFILE lcmsProfile() const;
+    /**
+     * @return the ICC profile ID, or the MD5 checksum of the profile data if the
+     *         profile has no ID. Equal profiles have equal ids.
+     */
+    QByteArray uniqueId() const;
 
     virtual bool valid() const;
     virtual float version() const;
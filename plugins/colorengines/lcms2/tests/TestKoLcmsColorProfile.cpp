@@ -6,7 +6,9 @@
 
 #include <KoColor.h>
 
+#include <QAtomicInt>
 #include <QTest>
+#include <QThread>
 
 #include <lcms2.h>
 #include <cmath>
@@ -170,4 +172,87 @@ void TestKoLcmsColorProfile::testConversion()
 
 }
 
+namespace {
+// converts the colors over and over again and counts the results that differ from the expected ones
+class QColorConversionThread : public QThread
+{
+public:
+    QColorConversionThread(const KoColorSpace *cs, const KoColorProfile *profile, const QVector<QColor> &colors,
+                           const QVector<quint16> &pixels, const QVector<QColor> &roundTrip, QAtomicInt *failures)
+        : cs(cs), profile(profile), colors(colors), pixels(pixels), roundTrip(roundTrip), failures(failures) {}
+
+    void run()
+    {
+        QVector<quint16> batch(pixels.size());
+        for (int round = 0; round < 200; ++round) {
+            for (int i = 0; i < colors.size(); ++i) {
+                quint16 pixel[4];
+                cs->fromQColor(colors[i], reinterpret_cast<quint8 *>(pixel), profile);
+                if (memcmp(pixel, pixels.constData() + 4 * i, sizeof(pixel)) != 0) {
+                    failures->ref();
+                }
+                QColor color;
+                cs->toQColor(reinterpret_cast<const quint8 *>(pixel), &color, profile);
+                if (color.rgba() != roundTrip[i].rgba()) {
+                    failures->ref();
+                }
+            }
+            cs->fromQColors(colors, reinterpret_cast<quint8 *>(batch.data()), profile);
+            if (batch != pixels) {
+                failures->ref();
+            }
+        }
+    }
+
+private:
+    const KoColorSpace *cs;
+    const KoColorProfile *profile;
+    QVector<QColor> colors;
+    QVector<quint16> pixels;
+    QVector<QColor> roundTrip;
+    QAtomicInt *failures;
+};
+}
+
+void TestKoLcmsColorProfile::testThreadedQColorConversion()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb16("sRGB built-in");
+    QVERIFY(cs);
+    const KoColorSpace *linearRgb = KoColorSpaceRegistry::instance()->rgb16("scRGB (linear)");
+    QVERIFY(linearRgb);
+
+    QVector<QColor> colors;
+    for (int i = 0; i < 32; ++i) {
+        colors << QColor(i * 8, 255 - i * 8, (i * 37) % 256, 255);
+    }
+
+    // the default profile and a profile whose transforms are cached per thread
+    QList<const KoColorProfile *> profiles;
+    profiles << 0 << linearRgb->profile();
+    foreach (const KoColorProfile *profile, profiles) {
+        QVector<quint16> pixels(4 * colors.size());
+        for (int i = 0; i < colors.size(); ++i) {
+            cs->fromQColor(colors[i], reinterpret_cast<quint8 *>(pixels.data() + 4 * i), profile);
+        }
+        QVector<QColor> roundTrip(colors.size());
+        for (int i = 0; i < colors.size(); ++i) {
+            cs->toQColor(reinterpret_cast<const quint8 *>(pixels.constData() + 4 * i), &roundTrip[i], profile);
+        }
+
+        QAtomicInt failures;
+        QList<QColorConversionThread *> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads << new QColorConversionThread(cs, profile, colors, pixels, roundTrip, &failures);
+        }
+        foreach (QColorConversionThread *thread, threads) {
+            thread->start();
+        }
+        foreach (QColorConversionThread *thread, threads) {
+            QVERIFY(thread->wait());
+        }
+        qDeleteAll(threads);
+        QCOMPARE(failures.load(), 0);
+    }
+}
+
 QTEST_MAIN(TestKoLcmsColorProfile)
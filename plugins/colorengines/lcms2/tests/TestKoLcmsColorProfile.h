@@ -11,6 +11,7 @@ class TestKoLcmsColorProfile : public QObject
     void testProfileCreationFromChromaticities();
 private Q_SLOTS:
     void testConversion();
+    void testThreadedQColorConversion();
 };
 
 #endif
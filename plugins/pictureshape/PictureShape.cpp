@@ -68,8 +68,17 @@ QString generate_key(qint64 key, const QSize & size)
 _Private::PixmapScaler::PixmapScaler(PictureShape *pictureShape, const QSize &pixmapSize):
     m_size(pixmapSize)
 {
-    m_image = pictureShape->imageData()->image();
-    m_imageKey = pictureShape->imageData()->key();
+    KoImageData *imageData = pictureShape->imageData();
+    if (imageData->hasCachedImage()) {
+        m_image = imageData->image();
+    } else {
+        // decode in run()
+        m_fileName = imageData->imageFileName(&m_format);
+        if (m_fileName.isEmpty()) {
+            m_image = imageData->image();
+        }
+    }
+    m_imageKey = imageData->key();
     connect(this, SIGNAL(finished(QString,QImage)), &pictureShape->m_proxy, SLOT(setImage(QString,QImage)));
 }
 
@@ -77,14 +86,20 @@ void _Private::PixmapScaler::run()
 {
     QString key = generate_key(m_imageKey, m_size);
 
-    m_image = m_image.scaled(
-        m_size.width(),
-        m_size.height(),
-        Qt::IgnoreAspectRatio,
-        Qt::SmoothTransformation
-    );
+    if (m_image.isNull()) {
+        m_image = KoImageData::scaledImage(m_fileName, m_format, m_size);
+    } else {
+        m_image = m_image.scaled(
+            m_size.width(),
+            m_size.height(),
+            Qt::IgnoreAspectRatio,
+            Qt::SmoothTransformation
+        );
+    }
 
-    emit finished(key, m_image);
+    if (!m_image.isNull()) {
+        emit finished(key, m_image);
+    }
 }
 
 // ----------------------------------------------------------------- //
@@ -285,7 +300,7 @@ void PictureShape::paint(QPainter &painter, const KoViewConverter &converter,
     paintBorder(painter, converter);
     painter.restore();
 
-    QSize pixmapSize = calcOptimalPixmapSize(viewRect.size(), imageData()->image().size());
+    QSize pixmapSize = calcOptimalPixmapSize(viewRect.size(), imageData()->pixelSize());
 
     // Normalize the clipping rect if it isn't already done.
     m_clippingRect.normalize(imageData()->imageSize());
@@ -385,7 +400,7 @@ void PictureShape::waitUntilReady(const KoViewConverter &converter, bool asynchr
         m_printQualityImage = image.scaled(pixels, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
     }
     else {
-        QSize pixmapSize = calcOptimalPixmapSize(converter.documentToView(QRectF(QPointF(0,0), size())).size(), imageData->image().size());
+        QSize pixmapSize = calcOptimalPixmapSize(converter.documentToView(QRectF(QPointF(0,0), size())).size(), imageData->pixelSize());
         QString key(generate_key(imageData->key(), pixmapSize));
         if (QPixmapCache::find(key) == 0) {
             QPixmap pixmap = imageData->pixmap(pixmapSize);
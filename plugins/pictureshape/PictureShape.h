@@ -29,6 +29,7 @@
 
 #include <KoTosContainer.h>
 #include <KoFrameShape.h>
+#include <KoImageData.h>
 #include <SvgShape.h>
 
 #include "ClippingRect.h"
@@ -64,7 +65,9 @@ namespace _Private
     /**
      * This class will scale an image to a given size.
      * Instances of this class can be executed in a thread pool
-     * therefore the scaling process can be done in the background
+     * therefore the scaling process can be done in the background.
+     * If the image is not loaded yet it is decoded directly at the
+     * given size in the background too.
      */
     class PixmapScaler: public QObject, public QRunnable
     {
@@ -79,6 +82,10 @@ namespace _Private
     private:
         QSize m_size;
         QImage m_image;
+        // used to decode the image if it is not loaded, the image data itself
+        // must not be touched outside the gui thread
+        QString m_fileName;
+        QByteArray m_format;
         quint64 m_imageKey;
     };
 
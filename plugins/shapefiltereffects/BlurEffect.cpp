@@ -26,250 +26,121 @@
 #include <klocalizedstring.h>
 #include <QColor>
 #include <QImage>
+#include <QThreadStorage>
+#include <QVector>
 
-// Stack Blur Algorithm by Mario Klingemann <mario@quasimondo.com>
-// fixed to handle alpha channel correctly by Zack Rusin
-void fastbluralpha(QImage &img, int radius)
-{
-    if (radius < 1) {
-        return;
-    }
+#include <algorithm>
 
-    QRgb *pix = (QRgb*)img.bits();
-    int w   = img.width();
-    int h   = img.height();
-    int wm  = w - 1;
-    int hm  = h - 1;
-    int wh  = w * h;
-    int div = radius + radius + 1;
-
-    int *r = new int[wh];
-    int *g = new int[wh];
-    int *b = new int[wh];
-    int *a = new int[wh];
-    int rsum, gsum, bsum, asum, x, y, i, yp, yi, yw;
-    QRgb p;
-    int *vmin = new int[qMax(w, h)];
-
-    int divsum = (div + 1) >> 1;
-    divsum *= divsum;
-    int *dv = new int[256*divsum];
-    for (i = 0; i < 256*divsum; ++i) {
-        dv[i] = (i / divsum);
-    }
+#include "ParallelRows.h"
 
-    yw = yi = 0;
+namespace {
 
-    int **stack = new int*[div];
-    for (int i = 0; i < div; ++i) {
-        stack[i] = new int[4];
-    }
+/// number of neighbouring columns blurred together in the vertical pass
+const int ColumnBand = 32;
 
+/// per thread buffers reused by all blur calls
+struct BlurScratch
+{
+    QVector<uchar> stack;
+    QVector<int> sums;
+};
 
-    int stackpointer;
-    int stackstart;
-    int *sir;
-    int rbs;
-    int r1 = radius + 1;
-    int routsum, goutsum, boutsum, aoutsum;
-    int rinsum, ginsum, binsum, ainsum;
-
-    for (y = 0; y < h; ++y) {
-        rinsum = ginsum = binsum = ainsum
-                                   = routsum = goutsum = boutsum = aoutsum
-                                                                   = rsum = gsum = bsum = asum = 0;
-        for (i = - radius; i <= radius; ++i) {
-            p = pix[yi+qMin(wm, qMax(i, 0))];
-            sir = stack[i+radius];
-            sir[0] = qRed(p);
-            sir[1] = qGreen(p);
-            sir[2] = qBlue(p);
-            sir[3] = qAlpha(p);
-
-            rbs = r1 - abs(i);
-            rsum += sir[0] * rbs;
-            gsum += sir[1] * rbs;
-            bsum += sir[2] * rbs;
-            asum += sir[3] * rbs;
-
-            if (i > 0) {
-                rinsum += sir[0];
-                ginsum += sir[1];
-                binsum += sir[2];
-                ainsum += sir[3];
-            } else {
-                routsum += sir[0];
-                goutsum += sir[1];
-                boutsum += sir[2];
-                aoutsum += sir[3];
-            }
-        }
-        stackpointer = radius;
-
-        for (x = 0; x < w; ++x) {
-
-            r[yi] = dv[rsum];
-            g[yi] = dv[gsum];
-            b[yi] = dv[bsum];
-            a[yi] = dv[asum];
-
-            rsum -= routsum;
-            gsum -= goutsum;
-            bsum -= boutsum;
-            asum -= aoutsum;
-
-            stackstart = stackpointer - radius + div;
-            sir = stack[stackstart%div];
-
-            routsum -= sir[0];
-            goutsum -= sir[1];
-            boutsum -= sir[2];
-            aoutsum -= sir[3];
-
-            if (y == 0) {
-                vmin[x] = qMin(x + radius + 1, wm);
-            }
-            p = pix[yw+vmin[x]];
-
-            sir[0] = qRed(p);
-            sir[1] = qGreen(p);
-            sir[2] = qBlue(p);
-            sir[3] = qAlpha(p);
-
-            rinsum += sir[0];
-            ginsum += sir[1];
-            binsum += sir[2];
-            ainsum += sir[3];
-
-            rsum += rinsum;
-            gsum += ginsum;
-            bsum += binsum;
-            asum += ainsum;
-
-            stackpointer = (stackpointer + 1) % div;
-            sir = stack[(stackpointer)%div];
-
-            routsum += sir[0];
-            goutsum += sir[1];
-            boutsum += sir[2];
-            aoutsum += sir[3];
-
-            rinsum -= sir[0];
-            ginsum -= sir[1];
-            binsum -= sir[2];
-            ainsum -= sir[3];
-
-            ++yi;
+QThreadStorage<BlurScratch*> blurScratch;
+
+/**
+ * Stack blurs lines of pixels in place.
+ *
+ * The lines are stored next to each other, @p lanes is the number of bytes of all lines
+ * at one position and @p stride the distance in bytes between two positions of a line.
+ * All lanes are processed with the same operations, so the inner loops are vectorized
+ * by the compiler.
+ */
+void stackBlurLines(uchar *data, int lanes, int stride, int length, int radius)
+{
+    if (!blurScratch.hasLocalData())
+        blurScratch.setLocalData(new BlurScratch);
+    BlurScratch *scratch = blurScratch.localData();
+
+    const int div = 2 * radius + 1;
+    if (scratch->stack.size() < div * lanes)
+        scratch->stack.resize(div * lanes);
+    if (scratch->sums.size() < 3 * lanes)
+        scratch->sums.resize(3 * lanes);
+
+    uchar *stack = scratch->stack.data();
+    int *sum = scratch->sums.data();
+    int *sumIn = sum + lanes;
+    int *sumOut = sumIn + lanes;
+    // the sum of the weights, adding a half keeps the division exact
+    const double inverse = 1.0 / ((radius + 1) * (radius + 1));
+    const int last = length - 1;
+
+    std::fill(sum, sum + 3 * lanes, 0);
+    for (int i = -radius; i <= radius; ++i) {
+        const uchar *p = data + qBound(0, i, last) * stride;
+        uchar *s = stack + (i + radius) * lanes;
+        const int weight = radius + 1 - qAbs(i);
+        for (int k = 0; k < lanes; ++k) {
+            s[k] = p[k];
+            sum[k] += p[k] * weight;
         }
-        yw += w;
+        int *side = i > 0 ? sumIn : sumOut;
+        for (int k = 0; k < lanes; ++k)
+            side[k] += p[k];
     }
-    for (x = 0; x < w; ++x) {
-        rinsum = ginsum = binsum = ainsum
-                                   = routsum = goutsum = boutsum = aoutsum
-                                                                   = rsum = gsum = bsum = asum = 0;
-
-        yp = - radius * w;
-
-        for (i = -radius; i <= radius; ++i) {
-            yi = qMax(0, yp) + x;
-
-            sir = stack[i+radius];
-
-            sir[0] = r[yi];
-            sir[1] = g[yi];
-            sir[2] = b[yi];
-            sir[3] = a[yi];
-
-            rbs = r1 - abs(i);
-
-            rsum += r[yi] * rbs;
-            gsum += g[yi] * rbs;
-            bsum += b[yi] * rbs;
-            asum += a[yi] * rbs;
-
-            if (i > 0) {
-                rinsum += sir[0];
-                ginsum += sir[1];
-                binsum += sir[2];
-                ainsum += sir[3];
-            } else {
-                routsum += sir[0];
-                goutsum += sir[1];
-                boutsum += sir[2];
-                aoutsum += sir[3];
-            }
-
-            if (i < hm) {
-                yp += w;
-            }
-        }
-
-        yi = x;
-        stackpointer = radius;
-
-        for (y = 0; y < h; ++y) {
-            pix[yi] = qRgba(dv[rsum], dv[gsum], dv[bsum], dv[asum]);
-
-            rsum -= routsum;
-            gsum -= goutsum;
-            bsum -= boutsum;
-            asum -= aoutsum;
-
-            stackstart = stackpointer - radius + div;
-            sir = stack[stackstart%div];
 
-            routsum -= sir[0];
-            goutsum -= sir[1];
-            boutsum -= sir[2];
-            aoutsum -= sir[3];
-
-            if (x == 0) {
-                vmin[y] = qMin(y + r1, hm) * w;
-            }
-            p = x + vmin[y];
-
-            sir[0] = r[p];
-            sir[1] = g[p];
-            sir[2] = b[p];
-            sir[3] = a[p];
-
-            rinsum += sir[0];
-            ginsum += sir[1];
-            binsum += sir[2];
-            ainsum += sir[3];
-
-            rsum += rinsum;
-            gsum += ginsum;
-            bsum += binsum;
-            asum += ainsum;
-
-            stackpointer = (stackpointer + 1) % div;
-            sir = stack[stackpointer];
-
-            routsum += sir[0];
-            goutsum += sir[1];
-            boutsum += sir[2];
-            aoutsum += sir[3];
-
-            rinsum -= sir[0];
-            ginsum -= sir[1];
-            binsum -= sir[2];
-            ainsum -= sir[3];
+    int stackPointer = radius;
+    for (int x = 0; x < length; ++x) {
+        // the incoming pixel is read before the output overwrites it at the end of the line
+        const uchar *in = data + qMin(x + radius + 1, last) * stride;
+        uchar *out = data + x * stride;
+        uchar *oldest = stack + ((stackPointer + radius + 1) % div) * lanes;
+        for (int k = 0; k < lanes; ++k) {
+            const int value = in[k];
+            out[k] = static_cast<uchar>((sum[k] + 0.5) * inverse);
+            sum[k] -= sumOut[k];
+            sumOut[k] -= oldest[k];
+            oldest[k] = value;
+            sumIn[k] += value;
+            sum[k] += sumIn[k];
+        }
 
-            yi += w;
+        stackPointer = (stackPointer + 1) % div;
+        const uchar *center = stack + stackPointer * lanes;
+        for (int k = 0; k < lanes; ++k) {
+            sumOut[k] += center[k];
+            sumIn[k] -= center[k];
         }
     }
-    delete [] r;
-    delete [] g;
-    delete [] b;
-    delete [] a;
-    delete [] vmin;
-    delete [] dv;
-
-    for (int i = 0; i < div; ++i) {
-        delete [] stack[i];
+}
+
+}
+
+// Stack Blur Algorithm by Mario Klingemann <mario@quasimondo.com>
+// The channels are blurred independently, so the image has to be premultiplied
+// for the alpha channel to be handled correctly.
+void fastbluralpha(QImage &img, int radius)
+{
+    if (radius < 1) {
+        return;
     }
-    delete [] stack;
+
+    const int w = img.width();
+    const int h = img.height();
+    const int stride = img.bytesPerLine();
+    // detach before the threads start writing
+    uchar *bits = img.bits();
+
+    ParallelRows::process(0, h, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y)
+            stackBlurLines(bits + y * stride, 4, 4, w, radius);
+    });
+
+    // blurring a band of columns at once walks the image row by row
+    ParallelRows::process(0, w, [&](int begin, int end) {
+        for (int x = begin; x < end; x += ColumnBand)
+            stackBlurLines(bits + 4 * x, 4 * qMin(ColumnBand, end - x), stride, h, radius);
+    });
 }
 
 BlurEffect::BlurEffect()
@@ -31,6 +31,8 @@
 
 #include <cmath>
 
+#include "ParallelRows.h"
+
 ConvolveMatrixEffect::ConvolveMatrixEffect()
         : KoFilterEffect(ConvolveMatrixEffectId, i18n("Convolve Matrix"))
 {
@@ -124,6 +126,67 @@ void ConvolveMatrixEffect::enablePreserveAlpha(bool on)
     m_preserveAlpha = on;
 }
 
+namespace {
+
+/**
+ * Maps the source coordinate @p i to the range [0, size) according to the edge mode.
+ * @return -1 if the coordinate is outside and does not contribute
+ */
+inline int edgeIndex(int i, int size, ConvolveMatrixEffect::EdgeMode edgeMode)
+{
+    if (i >= 0 && i < size)
+        return i;
+    switch (edgeMode) {
+    case ConvolveMatrixEffect::Duplicate:
+        return i >= size ? size-1 : 0;
+    case ConvolveMatrixEffect::Wrap:
+        return (i % size + size) % size;
+    case ConvolveMatrixEffect::None:
+        break;
+    }
+    // zero for all color channels
+    return -1;
+}
+
+/**
+ * Checks if the kernel is the outer product of a column and a row vector,
+ * in which case the convolution can be done in two one-dimensional passes.
+ */
+bool separateKernel(const QVector<qreal> &kernel, int rx, int ry,
+                    QVector<qreal> &rowKernel, QVector<qreal> &columnKernel)
+{
+    int pivot = -1;
+    qreal pivotValue = 0.0;
+    for (int i = 0; i < kernel.count(); ++i) {
+        if (qAbs(kernel[i]) > qAbs(pivotValue)) {
+            pivot = i;
+            pivotValue = kernel[i];
+        }
+    }
+    if (pivot < 0)
+        return false;
+
+    const int px = pivot % rx;
+    const int py = pivot / rx;
+    rowKernel.resize(rx);
+    columnKernel.resize(ry);
+    for (int x = 0; x < rx; ++x)
+        rowKernel[x] = kernel[py*rx + x];
+    for (int y = 0; y < ry; ++y)
+        columnKernel[y] = kernel[y*rx + px] / pivotValue;
+
+    const qreal epsilon = 1e-6 * qAbs(pivotValue);
+    for (int y = 0; y < ry; ++y) {
+        for (int x = 0; x < rx; ++x) {
+            if (qAbs(kernel[y*rx + x] - columnKernel[y] * rowKernel[x]) > epsilon)
+                return false;
+        }
+    }
+    return true;
+}
+
+}
+
 QImage ConvolveMatrixEffect::processImage(const QImage &image, const KoFilterEffectRenderContext &context) const
 {
     QImage result = image;
@@ -139,17 +202,6 @@ QImage ConvolveMatrixEffect::processImage(const QImage &image, const KoFilterEff
     const int w = result.width();
     const int h = result.height();
 
-    // setup mask
-    const int maskSize = rx*ry;
-    QVector<QPoint> offset(maskSize);
-    int index = 0;
-    for (int y = 0; y < ry; ++y) {
-        for (int x = 0; x < rx; ++x) {
-            offset[index] = QPoint(x-tx, y-ty);
-            index++;
-        }
-    }
-
     qreal divisor = m_divisor;
     // if no divisor given, it is the sum of all kernel values
     // if sum of kernel values is zero, divisor is set to 1
@@ -161,9 +213,8 @@ QImage ConvolveMatrixEffect::processImage(const QImage &image, const KoFilterEff
             divisor = 1.0;
     }
 
-    int dstPixel, srcPixel;
-    qreal sumA, sumR, sumG, sumB;
     const QRgb * src = (const QRgb*)image.constBits();
+    // detach before the threads start writing
     QRgb * dst = (QRgb*)result.bits();
 
     const QRect roi = context.filterRegion().toRect();
@@ -171,68 +222,110 @@ QImage ConvolveMatrixEffect::processImage(const QImage &image, const KoFilterEff
     const int maxX = roi.right();
     const int minY = roi.top();
     const int maxY = roi.bottom();
+    if (maxX < minX || maxY < minY)
+        return result;
 
-    int srcRow, srcCol;
-    for (int row = minY; row <= maxY; ++row) {
-        for (int col = minX; col <= maxX; ++col) {
-            dstPixel = row * w + col;
-            sumA = sumR = sumG = sumB = 0;
-            for (int i = 0; i < maskSize; ++i) {
-                srcRow = row + offset[i].y();
-                srcCol = col + offset[i].x();
-                // handle top and bottom edge
-                if (srcRow < 0 || srcRow >= h ) {
-                    switch(m_edgeMode) {
-                        case Duplicate:
-                            srcRow = srcRow >= h ? h-1 : 0;
-                            break;
-                        case Wrap:
-                            srcRow = (srcRow+h)%h;
-                            break;
-                        case None:
-                            // zero for all color channels
+    const EdgeMode edgeMode = m_edgeMode;
+    const bool preserveAlpha = m_preserveAlpha;
+    const qreal bias = m_bias;
+
+    QVector<qreal> rowKernel, columnKernel;
+    if (rx > 1 && ry > 1 && separateKernel(m_kernel, rx, ry, rowKernel, columnKernel)) {
+        // convolve the rows first, for all rows the column pass needs
+        const int roiWidth = maxX - minX + 1;
+        const int firstRow = edgeMode == Wrap ? 0 : qMax(0, minY - ty);
+        const int lastRow = edgeMode == Wrap ? h-1 : qMin(h-1, maxY + ry-1 - ty);
+        QVector<float> rowSums(4 * roiWidth * (lastRow - firstRow + 1));
+        float *tmp = rowSums.data();
+
+        ParallelRows::process(firstRow, lastRow + 1, [&](int begin, int end) {
+            for (int row = begin; row < end; ++row) {
+                float *t = tmp + 4 * roiWidth * (row - firstRow);
+                const QRgb *srcLine = src + row * w;
+                for (int col = minX; col <= maxX; ++col, t += 4) {
+                    qreal sumA = 0, sumR = 0, sumG = 0, sumB = 0;
+                    for (int x = 0; x < rx; ++x) {
+                        const int srcCol = edgeIndex(col + x - tx, w, edgeMode);
+                        if (srcCol < 0)
                             continue;
-                            break;
+                        const QRgb &s = srcLine[srcCol];
+                        const qreal k = rowKernel[x];
+                        sumA += qAlpha(s) * k;
+                        sumR += qRed(s) * k;
+                        sumG += qGreen(s) * k;
+                        sumB += qBlue(s) * k;
                     }
+                    t[0] = sumR;
+                    t[1] = sumG;
+                    t[2] = sumB;
+                    t[3] = sumA;
                 }
-                // handle left and right edge
-                if (srcCol < 0 || srcCol >= w) {
-                    switch(m_edgeMode) {
-                        case Duplicate:
-                            srcCol = srcCol >= w ? w-1 : 0;
-                            break;
-                        case Wrap:
-                            srcCol = (srcCol+w)%w;
-                            break;
-                        case None:
-                            // zero for all color channels
+            }
+        });
+
+        ParallelRows::process(minY, maxY + 1, [&](int begin, int end) {
+            for (int row = begin; row < end; ++row) {
+                for (int col = 0; col < roiWidth; ++col) {
+                    qreal sumA = 0, sumR = 0, sumG = 0, sumB = 0;
+                    for (int y = 0; y < ry; ++y) {
+                        const int srcRow = edgeIndex(row + y - ty, h, edgeMode);
+                        if (srcRow < 0)
                             continue;
-                            break;
+                        const float *t = tmp + 4 * (roiWidth * (srcRow - firstRow) + col);
+                        const qreal k = columnKernel[y];
+                        sumR += t[0] * k;
+                        sumG += t[1] * k;
+                        sumB += t[2] * k;
+                        sumA += t[3] * k;
                     }
+                    QRgb &d = dst[row * w + minX + col];
+                    d = qRgba(qBound(0, static_cast<int>(sumR / divisor + bias), 255),
+                              qBound(0, static_cast<int>(sumG / divisor + bias), 255),
+                              qBound(0, static_cast<int>(sumB / divisor + bias), 255),
+                              preserveAlpha ? qAlpha(d) : qBound(0, static_cast<int>(sumA / divisor + bias), 255));
                 }
-                srcPixel = srcRow * w + srcCol;
-                const QRgb &s = src[srcPixel];
-                const qreal &k = m_kernel[i];
-                if (!m_preserveAlpha)
-                    sumA += qAlpha(s) * k;
-                sumR += qRed(s) * k;
-                sumG += qGreen(s) * k;
-                sumB += qBlue(s) * k;
-            }
-            if (m_preserveAlpha) {
-                dst[dstPixel] = qRgba( qBound(0, static_cast<int>(sumR / divisor + m_bias), 255),
-                                       qBound(0, static_cast<int>(sumG / divisor + m_bias), 255),
-                                       qBound(0, static_cast<int>(sumB / divisor + m_bias), 255),
-                                       qAlpha(dst[dstPixel]));
-            } else {
-                dst[dstPixel] = qRgba( qBound(0, static_cast<int>(sumR / divisor + m_bias), 255),
-                                       qBound(0, static_cast<int>(sumG / divisor + m_bias), 255),
-                                       qBound(0, static_cast<int>(sumB / divisor + m_bias), 255),
-                                       qBound(0, static_cast<int>(sumA / divisor + m_bias), 255));
             }
+        });
+        return result;
+    }
+
+    // setup mask
+    const int maskSize = rx*ry;
+    QVector<QPoint> offset(maskSize);
+    int index = 0;
+    for (int y = 0; y < ry; ++y) {
+        for (int x = 0; x < rx; ++x) {
+            offset[index] = QPoint(x-tx, y-ty);
+            index++;
         }
     }
 
+    ParallelRows::process(minY, maxY + 1, [&](int begin, int end) {
+        for (int row = begin; row < end; ++row) {
+            for (int col = minX; col <= maxX; ++col) {
+                const int dstPixel = row * w + col;
+                qreal sumA = 0, sumR = 0, sumG = 0, sumB = 0;
+                for (int i = 0; i < maskSize; ++i) {
+                    const int srcRow = edgeIndex(row + offset[i].y(), h, edgeMode);
+                    const int srcCol = edgeIndex(col + offset[i].x(), w, edgeMode);
+                    if (srcRow < 0 || srcCol < 0)
+                        continue;
+                    const QRgb &s = src[srcRow * w + srcCol];
+                    const qreal &k = m_kernel[i];
+                    if (!preserveAlpha)
+                        sumA += qAlpha(s) * k;
+                    sumR += qRed(s) * k;
+                    sumG += qGreen(s) * k;
+                    sumB += qBlue(s) * k;
+                }
+                dst[dstPixel] = qRgba(qBound(0, static_cast<int>(sumR / divisor + bias), 255),
+                                      qBound(0, static_cast<int>(sumG / divisor + bias), 255),
+                                      qBound(0, static_cast<int>(sumB / divisor + bias), 255),
+                                      preserveAlpha ? qAlpha(dst[dstPixel]) : qBound(0, static_cast<int>(sumA / divisor + bias), 255));
+            }
+        }
+    });
+
     return result;
 }
 
@@ -26,7 +26,11 @@
 #include <klocalizedstring.h>
 #include <QRect>
 #include <QImage>
+#include <QVector>
 #include <cmath>
+#include <cstring>
+
+#include "ParallelRows.h"
 
 MorphologyEffect::MorphologyEffect()
         : KoFilterEffect(MorphologyEffectId, i18n("Morphology"))
@@ -54,6 +58,106 @@ void MorphologyEffect::setMorphologyOperator(Operator op)
     m_operator = op;
 }
 
+namespace {
+
+struct ErodeOp {
+    static inline uchar apply(uchar a, uchar b) { return qMin(a, b); }
+};
+
+struct DilateOp {
+    static inline uchar apply(uchar a, uchar b) { return qMax(a, b); }
+};
+
+/**
+ * Computes the minimum/maximum over a sliding window of @p window elements
+ * with the van Herk/Gil-Werman algorithm, which needs three comparisons per
+ * element regardless of the window size.
+ *
+ * The input consists of @p count elements of @p elementSize bytes, which are
+ * @p srcStride bytes apart. count - window + 1 elements are written to @p dst.
+ * An element can be a single pixel or a whole row of pixels, in which case
+ * the inner loops run over contiguous memory and get vectorized.
+ * @p prefix and @p suffix are scratch buffers of count * elementSize bytes.
+ */
+template<typename Op>
+void slidingWindow(const uchar *src, int srcStride, uchar *dst, int dstStride,
+                   int count, int window, int elementSize, uchar *prefix, uchar *suffix)
+{
+    // prefix: accumulated from the start of each block of window elements
+    for (int i = 0; i < count; ++i) {
+        const uchar *s = src + i * srcStride;
+        uchar *p = prefix + i * elementSize;
+        if (i % window == 0) {
+            memcpy(p, s, elementSize);
+        } else {
+            const uchar *pp = p - elementSize;
+            for (int c = 0; c < elementSize; ++c)
+                p[c] = Op::apply(pp[c], s[c]);
+        }
+    }
+    // suffix: accumulated from the end of each block of window elements
+    for (int i = count - 1; i >= 0; --i) {
+        const uchar *s = src + i * srcStride;
+        uchar *p = suffix + i * elementSize;
+        if (i == count - 1 || (i + 1) % window == 0) {
+            memcpy(p, s, elementSize);
+        } else {
+            const uchar *pn = p + elementSize;
+            for (int c = 0; c < elementSize; ++c)
+                p[c] = Op::apply(pn[c], s[c]);
+        }
+    }
+    // each window spans at most two blocks
+    for (int i = 0; i + window <= count; ++i) {
+        const uchar *sf = suffix + i * elementSize;
+        const uchar *pf = prefix + (i + window - 1) * elementSize;
+        uchar *d = dst + i * dstStride;
+        for (int c = 0; c < elementSize; ++c)
+            d[c] = Op::apply(sf[c], pf[c]);
+    }
+}
+
+/**
+ * Applies the rectangular morphology operator in two separable passes,
+ * first horizontally into a temporary buffer, then vertically into dst.
+ */
+template<typename Op>
+void morphology(const QImage &src, QImage &dst, const QRect &rect, int rx, int ry)
+{
+    const int dstStride = dst.bytesPerLine();
+    // detach before the threads start writing
+    uchar *dstBits = dst.bits() + rect.top() * dstStride + 4 * rect.left();
+    const int rectBytes = 4 * rect.width();
+    const int firstRow = rect.top() - ry;
+    const int rowCount = rect.height() + 2 * ry;
+
+    // horizontal pass over all rows needed by the vertical pass
+    QVector<uchar> horizontal(rowCount * rectBytes);
+    uchar *tmp = horizontal.data();
+    ParallelRows::process(0, rowCount, [&](int begin, int end) {
+        const int count = rect.width() + 2 * rx;
+        QVector<uchar> prefix(4 * count);
+        QVector<uchar> suffix(4 * count);
+        for (int row = begin; row < end; ++row) {
+            const uchar *s = src.constScanLine(firstRow + row) + 4 * (rect.left() - rx);
+            slidingWindow<Op>(s, 4, tmp + row * rectBytes, 4, count, 2 * rx + 1, 4,
+                              prefix.data(), suffix.data());
+        }
+    });
+
+    // vertical pass, whole row segments are processed as one element
+    ParallelRows::process(0, rect.width(), [&](int begin, int end) {
+        const int elementSize = 4 * (end - begin);
+        QVector<uchar> prefix(rowCount * elementSize);
+        QVector<uchar> suffix(rowCount * elementSize);
+        slidingWindow<Op>(tmp + 4 * begin, rectBytes,
+                          dstBits + 4 * begin, dstStride,
+                          rowCount, 2 * ry + 1, elementSize, prefix.data(), suffix.data());
+    });
+}
+
+}
+
 QImage MorphologyEffect::processImage(const QImage &image, const KoFilterEffectRenderContext &context) const
 {
     QImage result = image;
@@ -66,59 +170,21 @@ QImage MorphologyEffect::processImage(const QImage &image, const KoFilterEffectR
     const int w = result.width();
     const int h = result.height();
 
-    // setup mask
-    const int maskSize = (1+2*rx)*(1+2*ry);
-    int * mask = new int[maskSize];
-    int index = 0;
-    for (int y = -ry; y <= ry; ++y) {
-        for (int x = -rx; x <= rx; ++x) {
-            mask[index] = y*w+x;
-            index++;
-        }
-    }
-
-    int dstPixel, srcPixel;
-    uchar s0, s1, s2, s3;
-    const uchar * src = image.constBits();
-    uchar * dst = result.bits();
-
     const QRect roi = context.filterRegion().toRect();
     const int minX = qMax(rx, roi.left());
     const int maxX = qMin(w-rx, roi.right());
     const int minY = qMax(ry, roi.top());
     const int maxY = qMin(h-ry, roi.bottom());
-    const int defValue = m_operator == Erode ? 255 : 0;
-
-    uchar * d = 0;
-
-    for (int row = minY; row < maxY; ++row) {
-        for (int col = minX; col < maxX; ++col) {
-            dstPixel = row * w + col;
-            s0 = s1 = s2 = s3 = defValue;
-            for (int i = 0; i < maskSize; ++i) {
-                srcPixel = dstPixel+mask[i];
-                const uchar *s = &src[4*srcPixel];
-                if (m_operator == Erode ) {
-                    s0 = qMin(s0, s[0]);
-                    s1 = qMin(s1, s[1]);
-                    s2 = qMin(s2, s[2]);
-                    s3 = qMin(s3, s[3]);
-                } else {
-                    s0 = qMax(s0, s[0]);
-                    s1 = qMax(s1, s[1]);
-                    s2 = qMax(s2, s[2]);
-                    s3 = qMax(s3, s[3]);
-                }
-            }
-            d = &dst[4*dstPixel];
-            d[0] = s0;
-            d[1] = s1;
-            d[2] = s2;
-            d[3] = s3;
-        }
-    }
 
-    delete [] mask;
+    // pixels closer than the radius to the image border are left untouched
+    const QRect rect(QPoint(minX, minY), QPoint(maxX - 1, maxY - 1));
+    if (rect.isEmpty())
+        return result;
+
+    if (m_operator == Erode)
+        morphology<ErodeOp>(image, result, rect, rx, ry);
+    else
+        morphology<DilateOp>(image, result, rect, rx, ry);
 
     return result;
 }
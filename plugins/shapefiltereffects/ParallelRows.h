@@ -0,0 +1,125 @@
+/* This file is part of the KDE project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef PARALLELROWS_H
+#define PARALLELROWS_H
+
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+/**
+ * Helper to process independent rows (or columns) of an image on the
+ * global thread pool.
+ *
+ * The range is split into bands which are handed out to the pool threads
+ * and to the calling thread. The calling thread only waits for jobs the
+ * pool actually started, so this is safe to use from within a pool thread.
+ */
+namespace ParallelRows
+{
+
+/// the minimal number of rows processed as one band
+const int MinimalBandSize = 16;
+
+template<typename Function>
+class Work
+{
+public:
+    Work(Function function, int first, int last, int bandSize)
+        : m_function(function), m_first(first), m_last(last), m_bandSize(bandSize), m_nextBand(0)
+    {
+    }
+
+    void processBands()
+    {
+        forever {
+            const int start = m_first + m_nextBand.fetchAndAddOrdered(1) * m_bandSize;
+            if (start >= m_last)
+                break;
+            m_function(start, qMin(start + m_bandSize, m_last));
+        }
+    }
+
+    QSemaphore finished;
+
+private:
+    Function m_function;
+    const int m_first;
+    const int m_last;
+    const int m_bandSize;
+    QAtomicInt m_nextBand;
+};
+
+template<typename Function>
+class Job : public QRunnable
+{
+public:
+    explicit Job(Work<Function> *work) : m_work(work) {}
+
+    virtual void run()
+    {
+        m_work->processBands();
+        m_work->finished.release();
+    }
+
+private:
+    Work<Function> *m_work;
+};
+
+/**
+ * Calls @p function(begin, end) for consecutive sub ranges of [first, last)
+ * in parallel and returns when the whole range is processed.
+ * The function must only write data belonging to its own sub range.
+ */
+template<typename Function>
+void process(int first, int last, Function function)
+{
+    const int count = last - first;
+    if (count <= 0)
+        return;
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int threads = qMin(pool->maxThreadCount(), count / MinimalBandSize);
+    if (threads <= 1) {
+        function(first, last);
+        return;
+    }
+
+    // use a few bands per thread so threads that start late can catch up
+    const int bandSize = qMax(MinimalBandSize, count / (4 * threads));
+    Work<Function> work(function, first, last, bandSize);
+
+    int startedJobs = 0;
+    for (int i = 1; i < threads; ++i) {
+        Job<Function> *job = new Job<Function>(&work);
+        if (!pool->tryStart(job)) {
+            delete job;
+            break;
+        }
+        ++startedJobs;
+    }
+
+    work.processBands();
+    work.finished.acquire(startedJobs);
+}
+
+}
+
+#endif // PARALLELROWS_H
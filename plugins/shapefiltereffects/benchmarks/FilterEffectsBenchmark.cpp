@@ -0,0 +1,155 @@
+/* This file is part of the KDE project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "FilterEffectsBenchmark.h"
+
+#include "MorphologyEffect.h"
+#include "ConvolveMatrixEffect.h"
+#include "BlurEffect.h"
+
+#include <KoFilterEffectRenderContext.h>
+#include <KoViewConverter.h>
+
+#include <QImage>
+#include <QTest>
+
+#define IMAGE_SIZE 1000
+
+static QImage createSourceImage()
+{
+    QImage image(IMAGE_SIZE, IMAGE_SIZE, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            const int a = (x * y) % 256;
+            line[x] = qRgba((x % 256) * a / 255, (y % 256) * a / 255, ((x + y) % 256) * a / 255, a);
+        }
+    }
+    return image;
+}
+
+void FilterEffectsBenchmark::benchmarkMorphology_data()
+{
+    QTest::addColumn<int>("op");
+    QTest::addColumn<int>("radius");
+
+    QTest::newRow("erode r=2") << int(MorphologyEffect::Erode) << 2;
+    QTest::newRow("erode r=10") << int(MorphologyEffect::Erode) << 10;
+    QTest::newRow("erode r=50") << int(MorphologyEffect::Erode) << 50;
+    QTest::newRow("dilate r=2") << int(MorphologyEffect::Dilate) << 2;
+    QTest::newRow("dilate r=10") << int(MorphologyEffect::Dilate) << 10;
+    QTest::newRow("dilate r=50") << int(MorphologyEffect::Dilate) << 50;
+}
+
+void FilterEffectsBenchmark::benchmarkMorphology()
+{
+    QFETCH(int, op);
+    QFETCH(int, radius);
+
+    const QImage image = createSourceImage();
+    KoViewConverter converter;
+    KoFilterEffectRenderContext context(converter);
+    // the radius is given in bounding box units
+    context.setShapeBoundingBox(QRectF(0, 0, 1, 1));
+    context.setFilterRegion(image.rect());
+
+    MorphologyEffect effect;
+    effect.setMorphologyOperator(MorphologyEffect::Operator(op));
+    effect.setMorphologyRadius(QPointF(radius, radius));
+
+    QBENCHMARK {
+        effect.processImage(image, context);
+    }
+}
+
+void FilterEffectsBenchmark::benchmarkConvolveMatrix_data()
+{
+    QTest::addColumn<int>("order");
+    QTest::addColumn<bool>("separable");
+
+    QTest::newRow("3x3 separable") << 3 << true;
+    QTest::newRow("3x3") << 3 << false;
+    QTest::newRow("9x9 separable") << 9 << true;
+    QTest::newRow("9x9") << 9 << false;
+    QTest::newRow("15x15 separable") << 15 << true;
+    QTest::newRow("15x15") << 15 << false;
+}
+
+void FilterEffectsBenchmark::benchmarkConvolveMatrix()
+{
+    QFETCH(int, order);
+    QFETCH(bool, separable);
+
+    const QImage image = createSourceImage();
+    KoViewConverter converter;
+    KoFilterEffectRenderContext context(converter);
+    context.setShapeBoundingBox(QRectF(0, 0, 1, 1));
+    context.setFilterRegion(image.rect());
+
+    // a binomial kernel is separable, disturbing its center element makes it not
+    QVector<qreal> binomial(order, 0.0);
+    binomial[0] = 1.0;
+    for (int i = 1; i < order; ++i) {
+        for (int j = i; j > 0; --j)
+            binomial[j] += binomial[j - 1];
+    }
+    QVector<qreal> kernel(order * order);
+    for (int y = 0; y < order; ++y) {
+        for (int x = 0; x < order; ++x)
+            kernel[y * order + x] = binomial[x] * binomial[y];
+    }
+    if (!separable)
+        kernel[order * order / 2] += 1.0;
+
+    ConvolveMatrixEffect effect;
+    effect.setOrder(QPoint(order, order));
+    effect.setKernel(kernel);
+
+    QBENCHMARK {
+        effect.processImage(image, context);
+    }
+}
+
+void FilterEffectsBenchmark::benchmarkBlur_data()
+{
+    QTest::addColumn<qreal>("deviation");
+
+    QTest::newRow("r=2") << qreal(2);
+    QTest::newRow("r=10") << qreal(10);
+    QTest::newRow("r=50") << qreal(50);
+}
+
+void FilterEffectsBenchmark::benchmarkBlur()
+{
+    QFETCH(qreal, deviation);
+
+    const QImage image = createSourceImage();
+    KoViewConverter converter;
+    KoFilterEffectRenderContext context(converter);
+    context.setShapeBoundingBox(QRectF(0, 0, 1, 1));
+    context.setFilterRegion(image.rect());
+
+    BlurEffect effect;
+    effect.setDeviation(QPointF(deviation, deviation));
+
+    QBENCHMARK {
+        effect.processImage(image, context);
+    }
+}
+
+QTEST_MAIN(FilterEffectsBenchmark)
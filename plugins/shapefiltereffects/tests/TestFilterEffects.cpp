@@ -0,0 +1,727 @@
+/* This file is part of the KDE project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "TestFilterEffects.h"
+
+#include "MorphologyEffect.h"
+#include "ConvolveMatrixEffect.h"
+#include "BlurEffect.h"
+
+#include <KoFilterEffectRenderContext.h>
+#include <KoViewConverter.h>
+
+#include <QDebug>
+#include <QImage>
+#include <QTest>
+
+#include <cmath>
+
+Q_DECLARE_METATYPE(QVector<qreal>)
+
+/// returns an image with reproducible random premultiplied pixels
+static QImage createSourceImage(const QSize &size)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    quint32 seed = 1;
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            seed = seed * 1103515245 + 12345;
+            const int a = (seed >> 16) & 0xFF;
+            seed = seed * 1103515245 + 12345;
+            const quint32 c = seed >> 8;
+            line[x] = qRgba((c & 0xFF) * a / 255, ((c >> 8) & 0xFF) * a / 255, ((c >> 16) & 0xFF) * a / 255, a);
+        }
+    }
+    return image;
+}
+
+/// compares the channels of all pixels, allowing a difference of @p tolerance
+static bool compareImages(const QImage &result, const QImage &expected, int tolerance)
+{
+    if (result.size() != expected.size()) {
+        qWarning() << "image sizes differ:" << result.size() << expected.size();
+        return false;
+    }
+    for (int y = 0; y < result.height(); ++y) {
+        const QRgb *r = reinterpret_cast<const QRgb*>(result.constScanLine(y));
+        const QRgb *e = reinterpret_cast<const QRgb*>(expected.constScanLine(y));
+        for (int x = 0; x < result.width(); ++x) {
+            if (qAbs(qRed(r[x]) - qRed(e[x])) > tolerance ||
+                qAbs(qGreen(r[x]) - qGreen(e[x])) > tolerance ||
+                qAbs(qBlue(r[x]) - qBlue(e[x])) > tolerance ||
+                qAbs(qAlpha(r[x]) - qAlpha(e[x])) > tolerance) {
+
+                qWarning() << "pixel" << x << y << "differs:" << hex << r[x] << e[x];
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// the direct implementation of the morphology effect the sliding window replaced
+static QImage referenceMorphology(const QImage &image, const QRect &roi, int rx, int ry, bool erode)
+{
+    QImage result = image;
+
+    const int w = result.width();
+    const int h = result.height();
+
+    // setup mask
+    const int maskSize = (1+2*rx)*(1+2*ry);
+    int * mask = new int[maskSize];
+    int index = 0;
+    for (int y = -ry; y <= ry; ++y) {
+        for (int x = -rx; x <= rx; ++x) {
+            mask[index] = y*w+x;
+            index++;
+        }
+    }
+
+    int dstPixel, srcPixel;
+    uchar s0, s1, s2, s3;
+    const uchar * src = image.constBits();
+    uchar * dst = result.bits();
+
+    const int minX = qMax(rx, roi.left());
+    const int maxX = qMin(w-rx, roi.right());
+    const int minY = qMax(ry, roi.top());
+    const int maxY = qMin(h-ry, roi.bottom());
+    const int defValue = erode ? 255 : 0;
+
+    uchar * d = 0;
+
+    for (int row = minY; row < maxY; ++row) {
+        for (int col = minX; col < maxX; ++col) {
+            dstPixel = row * w + col;
+            s0 = s1 = s2 = s3 = defValue;
+            for (int i = 0; i < maskSize; ++i) {
+                srcPixel = dstPixel+mask[i];
+                const uchar *s = &src[4*srcPixel];
+                if (erode) {
+                    s0 = qMin(s0, s[0]);
+                    s1 = qMin(s1, s[1]);
+                    s2 = qMin(s2, s[2]);
+                    s3 = qMin(s3, s[3]);
+                } else {
+                    s0 = qMax(s0, s[0]);
+                    s1 = qMax(s1, s[1]);
+                    s2 = qMax(s2, s[2]);
+                    s3 = qMax(s3, s[3]);
+                }
+            }
+            d = &dst[4*dstPixel];
+            d[0] = s0;
+            d[1] = s1;
+            d[2] = s2;
+            d[3] = s3;
+        }
+    }
+
+    delete [] mask;
+
+    return result;
+}
+
+/**
+ * The direct implementation of the convolve matrix effect. The effect
+ * still uses it for kernels that are not separable.
+ * Like before, it only supports kernels smaller than twice the image
+ * size with the Wrap edge mode.
+ */
+static QImage referenceConvolveMatrix(const QImage &image, const QRect &roi, const QPoint &order,
+                                      const QVector<qreal> &kernel, qreal divisor, qreal bias,
+                                      const QPoint &target, ConvolveMatrixEffect::EdgeMode edgeMode,
+                                      bool preserveAlpha)
+{
+    QImage result = image;
+
+    const int rx = order.x();
+    const int ry = order.y();
+
+    const int tx = target.x() >= 0 && target.x() <= rx ? target.x() : rx >> 1;
+    const int ty = target.y() >= 0 && target.y() <= ry ? target.y() : ry >> 1;
+
+    const int w = result.width();
+    const int h = result.height();
+
+    // setup mask
+    const int maskSize = rx*ry;
+    QVector<QPoint> offset(maskSize);
+    int index = 0;
+    for (int y = 0; y < ry; ++y) {
+        for (int x = 0; x < rx; ++x) {
+            offset[index] = QPoint(x-tx, y-ty);
+            index++;
+        }
+    }
+
+    if (divisor == 0.0) {
+        foreach(qreal k, kernel) {
+            divisor += k;
+        }
+        if (divisor == 0.0)
+            divisor = 1.0;
+    }
+
+    int dstPixel, srcPixel;
+    qreal sumA, sumR, sumG, sumB;
+    const QRgb * src = (const QRgb*)image.constBits();
+    QRgb * dst = (QRgb*)result.bits();
+
+    const int minX = roi.left();
+    const int maxX = roi.right();
+    const int minY = roi.top();
+    const int maxY = roi.bottom();
+
+    int srcRow, srcCol;
+    for (int row = minY; row <= maxY; ++row) {
+        for (int col = minX; col <= maxX; ++col) {
+            dstPixel = row * w + col;
+            sumA = sumR = sumG = sumB = 0;
+            for (int i = 0; i < maskSize; ++i) {
+                srcRow = row + offset[i].y();
+                srcCol = col + offset[i].x();
+                // handle top and bottom edge
+                if (srcRow < 0 || srcRow >= h ) {
+                    switch(edgeMode) {
+                        case ConvolveMatrixEffect::Duplicate:
+                            srcRow = srcRow >= h ? h-1 : 0;
+                            break;
+                        case ConvolveMatrixEffect::Wrap:
+                            srcRow = (srcRow+h)%h;
+                            break;
+                        case ConvolveMatrixEffect::None:
+                            // zero for all color channels
+                            continue;
+                            break;
+                    }
+                }
+                // handle left and right edge
+                if (srcCol < 0 || srcCol >= w) {
+                    switch(edgeMode) {
+                        case ConvolveMatrixEffect::Duplicate:
+                            srcCol = srcCol >= w ? w-1 : 0;
+                            break;
+                        case ConvolveMatrixEffect::Wrap:
+                            srcCol = (srcCol+w)%w;
+                            break;
+                        case ConvolveMatrixEffect::None:
+                            // zero for all color channels
+                            continue;
+                            break;
+                    }
+                }
+                srcPixel = srcRow * w + srcCol;
+                const QRgb &s = src[srcPixel];
+                const qreal &k = kernel[i];
+                if (!preserveAlpha)
+                    sumA += qAlpha(s) * k;
+                sumR += qRed(s) * k;
+                sumG += qGreen(s) * k;
+                sumB += qBlue(s) * k;
+            }
+            if (preserveAlpha) {
+                dst[dstPixel] = qRgba( qBound(0, static_cast<int>(sumR / divisor + bias), 255),
+                                       qBound(0, static_cast<int>(sumG / divisor + bias), 255),
+                                       qBound(0, static_cast<int>(sumB / divisor + bias), 255),
+                                       qAlpha(dst[dstPixel]));
+            } else {
+                dst[dstPixel] = qRgba( qBound(0, static_cast<int>(sumR / divisor + bias), 255),
+                                       qBound(0, static_cast<int>(sumG / divisor + bias), 255),
+                                       qBound(0, static_cast<int>(sumB / divisor + bias), 255),
+                                       qBound(0, static_cast<int>(sumA / divisor + bias), 255));
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * The stack blur the blur effect used before it blurred in place, kept as reference.
+ *
+ * Stack Blur Algorithm by Mario Klingemann <mario@quasimondo.com>
+ * fixed to handle alpha channel correctly by Zack Rusin
+ */
+static void referenceBlur(QImage &img, int radius)
+{
+    if (radius < 1) {
+        return;
+    }
+
+    QRgb *pix = (QRgb*)img.bits();
+    int w   = img.width();
+    int h   = img.height();
+    int wm  = w - 1;
+    int hm  = h - 1;
+    int wh  = w * h;
+    int div = radius + radius + 1;
+
+    int *r = new int[wh];
+    int *g = new int[wh];
+    int *b = new int[wh];
+    int *a = new int[wh];
+    int rsum, gsum, bsum, asum, x, y, i, yp, yi, yw;
+    QRgb p;
+    int *vmin = new int[qMax(w, h)];
+
+    int divsum = (div + 1) >> 1;
+    divsum *= divsum;
+    int *dv = new int[256*divsum];
+    for (i = 0; i < 256*divsum; ++i) {
+        dv[i] = (i / divsum);
+    }
+
+    yw = yi = 0;
+
+    int **stack = new int*[div];
+    for (int i = 0; i < div; ++i) {
+        stack[i] = new int[4];
+    }
+
+
+    int stackpointer;
+    int stackstart;
+    int *sir;
+    int rbs;
+    int r1 = radius + 1;
+    int routsum, goutsum, boutsum, aoutsum;
+    int rinsum, ginsum, binsum, ainsum;
+
+    for (y = 0; y < h; ++y) {
+        rinsum = ginsum = binsum = ainsum
+                                   = routsum = goutsum = boutsum = aoutsum
+                                                                   = rsum = gsum = bsum = asum = 0;
+        for (i = - radius; i <= radius; ++i) {
+            p = pix[yi+qMin(wm, qMax(i, 0))];
+            sir = stack[i+radius];
+            sir[0] = qRed(p);
+            sir[1] = qGreen(p);
+            sir[2] = qBlue(p);
+            sir[3] = qAlpha(p);
+
+            rbs = r1 - abs(i);
+            rsum += sir[0] * rbs;
+            gsum += sir[1] * rbs;
+            bsum += sir[2] * rbs;
+            asum += sir[3] * rbs;
+
+            if (i > 0) {
+                rinsum += sir[0];
+                ginsum += sir[1];
+                binsum += sir[2];
+                ainsum += sir[3];
+            } else {
+                routsum += sir[0];
+                goutsum += sir[1];
+                boutsum += sir[2];
+                aoutsum += sir[3];
+            }
+        }
+        stackpointer = radius;
+
+        for (x = 0; x < w; ++x) {
+
+            r[yi] = dv[rsum];
+            g[yi] = dv[gsum];
+            b[yi] = dv[bsum];
+            a[yi] = dv[asum];
+
+            rsum -= routsum;
+            gsum -= goutsum;
+            bsum -= boutsum;
+            asum -= aoutsum;
+
+            stackstart = stackpointer - radius + div;
+            sir = stack[stackstart%div];
+
+            routsum -= sir[0];
+            goutsum -= sir[1];
+            boutsum -= sir[2];
+            aoutsum -= sir[3];
+
+            if (y == 0) {
+                vmin[x] = qMin(x + radius + 1, wm);
+            }
+            p = pix[yw+vmin[x]];
+
+            sir[0] = qRed(p);
+            sir[1] = qGreen(p);
+            sir[2] = qBlue(p);
+            sir[3] = qAlpha(p);
+
+            rinsum += sir[0];
+            ginsum += sir[1];
+            binsum += sir[2];
+            ainsum += sir[3];
+
+            rsum += rinsum;
+            gsum += ginsum;
+            bsum += binsum;
+            asum += ainsum;
+
+            stackpointer = (stackpointer + 1) % div;
+            sir = stack[(stackpointer)%div];
+
+            routsum += sir[0];
+            goutsum += sir[1];
+            boutsum += sir[2];
+            aoutsum += sir[3];
+
+            rinsum -= sir[0];
+            ginsum -= sir[1];
+            binsum -= sir[2];
+            ainsum -= sir[3];
+
+            ++yi;
+        }
+        yw += w;
+    }
+    for (x = 0; x < w; ++x) {
+        rinsum = ginsum = binsum = ainsum
+                                   = routsum = goutsum = boutsum = aoutsum
+                                                                   = rsum = gsum = bsum = asum = 0;
+
+        yp = - radius * w;
+
+        for (i = -radius; i <= radius; ++i) {
+            yi = qMax(0, yp) + x;
+
+            sir = stack[i+radius];
+
+            sir[0] = r[yi];
+            sir[1] = g[yi];
+            sir[2] = b[yi];
+            sir[3] = a[yi];
+
+            rbs = r1 - abs(i);
+
+            rsum += r[yi] * rbs;
+            gsum += g[yi] * rbs;
+            bsum += b[yi] * rbs;
+            asum += a[yi] * rbs;
+
+            if (i > 0) {
+                rinsum += sir[0];
+                ginsum += sir[1];
+                binsum += sir[2];
+                ainsum += sir[3];
+            } else {
+                routsum += sir[0];
+                goutsum += sir[1];
+                boutsum += sir[2];
+                aoutsum += sir[3];
+            }
+
+            if (i < hm) {
+                yp += w;
+            }
+        }
+
+        yi = x;
+        stackpointer = radius;
+
+        for (y = 0; y < h; ++y) {
+            pix[yi] = qRgba(dv[rsum], dv[gsum], dv[bsum], dv[asum]);
+
+            rsum -= routsum;
+            gsum -= goutsum;
+            bsum -= boutsum;
+            asum -= aoutsum;
+
+            stackstart = stackpointer - radius + div;
+            sir = stack[stackstart%div];
+
+            routsum -= sir[0];
+            goutsum -= sir[1];
+            boutsum -= sir[2];
+            aoutsum -= sir[3];
+
+            if (x == 0) {
+                vmin[y] = qMin(y + r1, hm) * w;
+            }
+            p = x + vmin[y];
+
+            sir[0] = r[p];
+            sir[1] = g[p];
+            sir[2] = b[p];
+            sir[3] = a[p];
+
+            rinsum += sir[0];
+            ginsum += sir[1];
+            binsum += sir[2];
+            ainsum += sir[3];
+
+            rsum += rinsum;
+            gsum += ginsum;
+            bsum += binsum;
+            asum += ainsum;
+
+            stackpointer = (stackpointer + 1) % div;
+            sir = stack[stackpointer];
+
+            routsum += sir[0];
+            goutsum += sir[1];
+            boutsum += sir[2];
+            aoutsum += sir[3];
+
+            rinsum -= sir[0];
+            ginsum -= sir[1];
+            binsum -= sir[2];
+            ainsum -= sir[3];
+
+            yi += w;
+        }
+    }
+    delete [] r;
+    delete [] g;
+    delete [] b;
+    delete [] a;
+    delete [] vmin;
+    delete [] dv;
+
+    for (int i = 0; i < div; ++i) {
+        delete [] stack[i];
+    }
+    delete [] stack;
+}
+
+
+void TestFilterEffects::testMorphology_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<QRect>("roi");
+    QTest::addColumn<int>("op");
+    QTest::addColumn<QPointF>("radius");
+
+    const int erode = MorphologyEffect::Erode;
+    const int dilate = MorphologyEffect::Dilate;
+    const QSize size(37, 23);
+    const QRect full(QPoint(0, 0), size);
+
+    QTest::newRow("erode 1x1") << size << full << erode << QPointF(1, 1);
+    QTest::newRow("dilate 1x1") << size << full << dilate << QPointF(1, 1);
+    QTest::newRow("erode 3x1") << size << full << erode << QPointF(3, 1);
+    QTest::newRow("dilate 1x4") << size << full << dilate << QPointF(1, 4);
+    QTest::newRow("erode 0x2") << size << full << erode << QPointF(0, 2);
+    QTest::newRow("dilate fractional") << size << full << dilate << QPointF(1.5, 2.2);
+    QTest::newRow("erode roi inside") << size << QRect(5, 3, 20, 12) << erode << QPointF(2, 2);
+    QTest::newRow("dilate roi overlapping") << size << QRect(-5, -4, 30, 20) << dilate << QPointF(2, 3);
+    QTest::newRow("erode window of the image width") << size << full << erode << QPointF(18, 1);
+    QTest::newRow("erode radius larger than image") << QSize(7, 5) << QRect(0, 0, 7, 5) << erode << QPointF(10, 10);
+    QTest::newRow("dilate radius larger than width") << QSize(7, 40) << QRect(0, 0, 7, 40) << dilate << QPointF(4, 1);
+    QTest::newRow("dilate radius larger than height") << QSize(40, 7) << QRect(0, 0, 40, 7) << dilate << QPointF(1, 4);
+    // large enough to be processed in bands on several threads
+    QTest::newRow("erode threaded") << QSize(131, 197) << QRect(0, 0, 131, 197) << erode << QPointF(5, 7);
+    QTest::newRow("dilate threaded") << QSize(131, 197) << QRect(0, 0, 131, 197) << dilate << QPointF(7, 5);
+}
+
+void TestFilterEffects::testMorphology()
+{
+    QFETCH(QSize, size);
+    QFETCH(QRect, roi);
+    QFETCH(int, op);
+    QFETCH(QPointF, radius);
+
+    const QImage image = createSourceImage(size);
+    KoViewConverter converter;
+    KoFilterEffectRenderContext context(converter);
+    // the radius is given in bounding box units
+    context.setShapeBoundingBox(QRectF(0, 0, 1, 1));
+    context.setFilterRegion(roi);
+
+    MorphologyEffect effect;
+    effect.setMorphologyOperator(MorphologyEffect::Operator(op));
+    effect.setMorphologyRadius(radius);
+
+    const QImage expected = referenceMorphology(image, roi,
+                                                static_cast<int>(ceil(radius.x())),
+                                                static_cast<int>(ceil(radius.y())),
+                                                op == MorphologyEffect::Erode);
+    // minimum and maximum are exact
+    QVERIFY(compareImages(effect.processImage(image, context), expected, 0));
+}
+
+/// returns the outer product of two rows of the pascal triangle, a separable kernel
+static QVector<qreal> binomialKernel(int rx, int ry)
+{
+    QVector<qreal> kernel(rx * ry);
+    for (int y = 0; y < ry; ++y) {
+        for (int x = 0; x < rx; ++x) {
+            // binomial coefficients
+            qreal bx = 1, by = 1;
+            for (int i = 0; i < x; ++i)
+                bx = bx * (rx - 1 - i) / (i + 1);
+            for (int i = 0; i < y; ++i)
+                by = by * (ry - 1 - i) / (i + 1);
+            kernel[y * rx + x] = bx * by;
+        }
+    }
+    return kernel;
+}
+
+void TestFilterEffects::testConvolveMatrix_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<QRect>("roi");
+    QTest::addColumn<QPoint>("order");
+    QTest::addColumn<QVector<qreal> >("kernel");
+    QTest::addColumn<qreal>("divisor");
+    QTest::addColumn<qreal>("bias");
+    QTest::addColumn<QPoint>("target");
+    QTest::addColumn<int>("edgeMode");
+    QTest::addColumn<bool>("preserveAlpha");
+    QTest::addColumn<int>("tolerance");
+
+    const QSize size(37, 23);
+    const QRect full(QPoint(0, 0), size);
+    const QPoint center(-1, -1);
+
+    // the separable path sums in a different order, so the truncation may differ by one
+    const int separable = 1;
+    const int direct = 0;
+
+    // Sobel operator: separable with negative elements, the sum is zero
+    QVector<qreal> sobel;
+    sobel << -1 << 0 << 1
+          << -2 << 0 << 2
+          << -1 << 0 << 1;
+    QVector<qreal> notSeparable = binomialKernel(3, 3);
+    notSeparable[4] += 1.0;
+
+    QList<QPair<QString, int> > edgeModes;
+    edgeModes << qMakePair(QString("duplicate"), int(ConvolveMatrixEffect::Duplicate))
+              << qMakePair(QString("wrap"), int(ConvolveMatrixEffect::Wrap))
+              << qMakePair(QString("none"), int(ConvolveMatrixEffect::None));
+
+    for (int i = 0; i < edgeModes.size(); ++i) {
+        const QString mode = edgeModes[i].first;
+        const int edgeMode = edgeModes[i].second;
+
+        QTest::newRow(QString("binomial 3x3 %1").arg(mode).toLatin1())
+            << size << full << QPoint(3, 3) << binomialKernel(3, 3) << 0.0 << 0.0
+            << center << edgeMode << false << separable;
+        QTest::newRow(QString("binomial 5x3 %1").arg(mode).toLatin1())
+            << size << full << QPoint(5, 3) << binomialKernel(5, 3) << 0.0 << 0.0
+            << center << edgeMode << false << separable;
+        QTest::newRow(QString("binomial 9x9 corner target %1").arg(mode).toLatin1())
+            << size << full << QPoint(9, 9) << binomialKernel(9, 9) << 0.0 << 0.0
+            << QPoint(0, 8) << edgeMode << false << separable;
+        QTest::newRow(QString("sobel bias %1").arg(mode).toLatin1())
+            << size << full << QPoint(3, 3) << sobel << 0.0 << 128.0
+            << center << edgeMode << false << separable;
+        QTest::newRow(QString("binomial preserve alpha %1").arg(mode).toLatin1())
+            << size << full << QPoint(3, 3) << binomialKernel(3, 3) << 8.0 << 0.0
+            << center << edgeMode << true << separable;
+        QTest::newRow(QString("binomial roi %1").arg(mode).toLatin1())
+            << size << QRect(5, 3, 20, 12) << QPoint(5, 5) << binomialKernel(5, 5) << 0.0 << 0.0
+            << center << edgeMode << false << separable;
+        QTest::newRow(QString("kernel larger than image %1").arg(mode).toLatin1())
+            << QSize(7, 5) << QRect(0, 0, 7, 5) << QPoint(9, 9) << binomialKernel(9, 9) << 0.0 << 0.0
+            << center << edgeMode << false << separable;
+        QTest::newRow(QString("not separable %1").arg(mode).toLatin1())
+            << size << full << QPoint(3, 3) << notSeparable << 0.0 << 0.0
+            << center << edgeMode << false << direct;
+    }
+
+    // large enough to be processed in bands on several threads
+    QTest::newRow("binomial threaded")
+        << QSize(131, 197) << QRect(0, 0, 131, 197) << QPoint(7, 7) << binomialKernel(7, 7) << 0.0 << 0.0
+        << center << int(ConvolveMatrixEffect::Duplicate) << false << separable;
+    QTest::newRow("not separable threaded")
+        << QSize(131, 197) << QRect(0, 0, 131, 197) << QPoint(3, 3) << notSeparable << 0.0 << 0.0
+        << center << int(ConvolveMatrixEffect::Duplicate) << false << direct;
+}
+
+void TestFilterEffects::testConvolveMatrix()
+{
+    QFETCH(QSize, size);
+    QFETCH(QRect, roi);
+    QFETCH(QPoint, order);
+    QFETCH(QVector<qreal>, kernel);
+    QFETCH(qreal, divisor);
+    QFETCH(qreal, bias);
+    QFETCH(QPoint, target);
+    QFETCH(int, edgeMode);
+    QFETCH(bool, preserveAlpha);
+    QFETCH(int, tolerance);
+
+    const QImage image = createSourceImage(size);
+    KoViewConverter converter;
+    KoFilterEffectRenderContext context(converter);
+    context.setShapeBoundingBox(QRectF(0, 0, 1, 1));
+    context.setFilterRegion(roi);
+
+    ConvolveMatrixEffect effect;
+    effect.setOrder(order);
+    effect.setKernel(kernel);
+    effect.setDivisor(divisor);
+    effect.setBias(bias);
+    effect.setTarget(target);
+    effect.setEdgeMode(ConvolveMatrixEffect::EdgeMode(edgeMode));
+    effect.enablePreserveAlpha(preserveAlpha);
+
+    const QImage expected = referenceConvolveMatrix(image, roi, order, kernel, divisor, bias, target,
+                                                    ConvolveMatrixEffect::EdgeMode(edgeMode), preserveAlpha);
+    QVERIFY(compareImages(effect.processImage(image, context), expected, tolerance));
+}
+
+void TestFilterEffects::testBlur_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<qreal>("deviation");
+
+    QTest::newRow("r=1") << QSize(37, 23) << qreal(1);
+    QTest::newRow("r=2") << QSize(37, 23) << qreal(2);
+    QTest::newRow("r=7 fractional") << QSize(37, 23) << qreal(7.6);
+    QTest::newRow("single pixel") << QSize(1, 1) << qreal(3);
+    QTest::newRow("single row") << QSize(41, 1) << qreal(3);
+    QTest::newRow("single column") << QSize(1, 41) << qreal(3);
+    // the vertical pass blurs bands of columns, leave a partial band
+    QTest::newRow("partial column band") << QSize(67, 29) << qreal(4);
+    QTest::newRow("radius larger than width") << QSize(15, 61) << qreal(20);
+    QTest::newRow("radius larger than height") << QSize(61, 15) << qreal(20);
+    QTest::newRow("radius larger than image") << QSize(37, 23) << qreal(100);
+    // large enough to be processed in bands on several threads
+    QTest::newRow("threaded r=5") << QSize(131, 197) << qreal(5);
+    QTest::newRow("threaded r=50") << QSize(131, 197) << qreal(50);
+}
+
+void TestFilterEffects::testBlur()
+{
+    QFETCH(QSize, size);
+    QFETCH(qreal, deviation);
+
+    const QImage image = createSourceImage(size);
+    KoViewConverter converter;
+    KoFilterEffectRenderContext context(converter);
+    context.setShapeBoundingBox(QRectF(0, 0, 1, 1));
+    context.setFilterRegion(image.rect());
+
+    BlurEffect effect;
+    effect.setDeviation(QPointF(deviation, deviation));
+
+    QImage expected = image;
+    referenceBlur(expected, static_cast<int>(deviation));
+    // the in place blur computes the same integer sums
+    QVERIFY(compareImages(effect.processImage(image, context), expected, 0));
+}
+
+QTEST_GUILESS_MAIN(TestFilterEffects)
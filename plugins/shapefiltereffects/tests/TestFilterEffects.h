@@ -0,0 +1,40 @@
+/* This file is part of the KDE project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef TESTFILTEREFFECTS_H
+#define TESTFILTEREFFECTS_H
+
+#include <QObject>
+
+/**
+ * Compares the optimized effects with the direct implementations
+ * they replaced, which are kept in the test as reference.
+ */
+class TestFilterEffects : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testMorphology_data();
+    void testMorphology();
+    void testConvolveMatrix_data();
+    void testConvolveMatrix();
+    void testBlur_data();
+    void testBlur();
+};
+
+#endif // TESTFILTEREFFECTS_H
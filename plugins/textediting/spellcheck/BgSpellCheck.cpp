@@ -27,11 +27,14 @@
 #include <QTextDocument>
 #include <QCoreApplication>
 #include <QTextBlock>
+#include <QTextBoundaryFinder>
 
 #define MaxCharsPerRun 1000
+#define MaxCachedWords 100000
 
 BgSpellCheck::BgSpellCheck(const Speller &speller, QObject *parent):
-    BackgroundChecker(speller, parent)
+    BackgroundChecker(speller, parent),
+    m_checkedWords(MaxCachedWords)
 {
     connect(this, SIGNAL(misspelling(QString,int)), this, SLOT(foundMisspelling(QString,int)));
     QString lang = speller.language();
@@ -41,7 +44,8 @@ BgSpellCheck::BgSpellCheck(const Speller &speller, QObject *parent):
 }
 
 BgSpellCheck::BgSpellCheck(QObject *parent)
-    : BackgroundChecker(parent)
+    : BackgroundChecker(parent),
+    m_checkedWords(MaxCachedWords)
 {
 }
 
@@ -79,7 +83,85 @@ void BgSpellCheck::startRun(QTextDocument *document, int startPosition, int endP
     }
 }
 
+static QVector<QPair<QString, int> > wordsOf(const QString &text)
+{
+    QVector<QPair<QString, int> > words;
+    QTextBoundaryFinder finder(QTextBoundaryFinder::Word, text);
+    int start = 0;
+    while (finder.toNextBoundary() >= 0) {
+        const int end = finder.position();
+        for (int i = start; i < end; ++i) {
+            if (text.at(i).isLetter()) {
+                words.append(qMakePair(text.mid(start, end - start), start));
+                break;
+            }
+        }
+        start = end;
+    }
+    return words;
+}
+
 QString BgSpellCheck::fetchMoreText()
+{
+    // words checked before with the same dictionary are not passed to sonnet again,
+    // they are blanked out of the text so the offsets sonnet reports stay valid.
+    // Texts without unchecked words are skipped completely.
+    while (true) {
+        QString text = nextText();
+        if (text.isNull())
+            return text;
+
+        m_currentWords.clear();
+        m_currentMisspellings.clear();
+        foreach (const Word &word, wordsOf(text)) {
+            const bool *misspelled = m_checkedWords.object(checkedWordKey(word.first));
+            if (!misspelled) {
+                m_currentWords.append(word);
+                continue;
+            }
+            if (*misspelled)
+                emit misspelledWord(word.first, m_currentPosition + word.second, true);
+            text.replace(word.second, word.first.length(), QString(word.first.length(), QLatin1Char(' ')));
+        }
+        if (!m_currentWords.isEmpty())
+            return text;
+    }
+}
+
+void BgSpellCheck::finishedCurrentFeed()
+{
+    foreach (const Word &misspelling, m_currentMisspellings) {
+        m_checkedWords.insert(checkedWordKey(misspelling.first), new bool(true));
+    }
+    foreach (const Word &word, m_currentWords) {
+        // sonnet tokenizes on its own, only words no misspelling touched are known to be right
+        bool touched = false;
+        foreach (const Word &misspelling, m_currentMisspellings) {
+            if (misspelling.second < word.second + word.first.length()
+                    && word.second < misspelling.second + misspelling.first.length()) {
+                touched = true;
+                break;
+            }
+        }
+        if (!touched)
+            m_checkedWords.insert(checkedWordKey(word.first), new bool(false));
+    }
+    m_currentWords.clear();
+    m_currentMisspellings.clear();
+    BackgroundChecker::finishedCurrentFeed();
+}
+
+void BgSpellCheck::clearCheckedTexts()
+{
+    m_checkedWords.clear();
+}
+
+QString BgSpellCheck::checkedWordKey(const QString &word) const
+{
+    return speller().language() + QLatin1Char('\n') + word;
+}
+
+QString BgSpellCheck::nextText()
 {
     m_currentPosition = m_nextPosition;
     if (m_currentPosition >= m_endPosition)
@@ -182,6 +264,7 @@ QString BgSpellCheck::fetchMoreText()
 void BgSpellCheck::foundMisspelling(const QString &word, int start)
 {
     // debugSpellCheck << "Mispelling: " << word << " : " << start;
+    m_currentMisspellings.append(qMakePair(word, start));
     emit misspelledWord(word, m_currentPosition + start, true);
     BackgroundChecker::continueChecking();
 }
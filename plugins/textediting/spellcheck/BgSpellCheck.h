@@ -24,7 +24,9 @@
 #include <sonnet/backgroundchecker.h>
 #include <sonnet/speller.h>
 
+#include <QCache>
 #include <QTextCursor>
+#include <QVector>
 
 using namespace Sonnet;
 
@@ -40,9 +42,14 @@ public:
     QString currentLanguage() const;
     QString currentCountry() const;
 
+    /// forget the results of earlier checks, needed when the dictionary changes
+    void clearCheckedTexts();
+
 protected:
     /// reimplemented
     virtual QString fetchMoreText();
+    /// reimplemented
+    virtual void finishedCurrentFeed();
 
 public Q_SLOTS:
     void setDefaultLanguage(const QString &language);
@@ -54,6 +61,12 @@ Q_SIGNALS:
     void misspelledWord(const QString &word, int startPosition, bool misspelled);
 
 private:
+    /// a word of a text and its offset in it
+    typedef QPair<QString, int> Word;
+
+    QString nextText();
+    QString checkedWordKey(const QString &word) const;
+
     QTextDocument *m_document;
 
     int m_currentPosition;
@@ -63,6 +76,11 @@ private:
     QString m_currentCountry;
     QString m_defaultLanguage;
     QString m_defaultCountry;
+
+    // whether a word checked before is misspelled, keyed by dictionary and word
+    QCache<QString, bool> m_checkedWords;
+    QVector<Word> m_currentWords; // the words of the current feed that are not cached
+    QVector<Word> m_currentMisspellings;
 };
 
 #endif
@@ -43,6 +43,10 @@
 #include <QTextCharFormat>
 #include <QAction>
 
+// queued sections of neighbouring blocks are merged up to this length so a run checks
+// many blocks at once instead of relayouting the document after every block
+#define MaxSectionLength 10000
+
 SpellCheck::SpellCheck()
     : m_document(0)
     , m_bgSpellCheck(0)
@@ -112,13 +116,25 @@ void SpellCheck::checkSection(QTextDocument *document, int startPosition, int en
         return;
     }
 
-    foreach (const SpellSections &ss, m_documentsQueue) {
+    for (int i = 0; i < m_documentsQueue.count(); ++i) {
+        SpellSections &ss = m_documentsQueue[i];
+        if (ss.document != document)
+            continue;
         if (ss.from <= startPosition && ss.to >= endPosition) {
             runQueue();
             m_spellCheckMenu->setVisible(true);
             return;
         }
-        // TODO also check if we should replace an existing queued item with a longer span
+        // sections touching each other, like consecutive blocks, are checked in one run
+        const int from = qMin(ss.from, startPosition);
+        const int to = qMax(ss.to, endPosition);
+        if (ss.from <= endPosition + 1 && startPosition <= ss.to + 1 && to - from <= MaxSectionLength) {
+            ss.from = from;
+            ss.to = to;
+            runQueue();
+            m_spellCheckMenu->setVisible(true);
+            return;
+        }
     }
 
     SpellSections ss(document, startPosition, endPosition);
@@ -184,11 +200,13 @@ void SpellCheck::setBackgroundSpellChecking(bool on)
 void SpellCheck::setSkipAllUppercaseWords(bool on)
 {
     m_speller.setAttribute(Speller::CheckUppercase, !on);
+    m_bgSpellCheck->clearCheckedTexts();
 }
 
 void SpellCheck::setSkipRunTogetherWords(bool on)
 {
     m_speller.setAttribute(Speller::SkipRunTogether, on);
+    m_bgSpellCheck->clearCheckedTexts();
 }
 
 bool SpellCheck::addWordToPersonal(const QString &word, int startPosition)
@@ -197,11 +215,15 @@ bool SpellCheck::addWordToPersonal(const QString &word, int startPosition)
     if (!block.isValid())
         return false;
 
+    // the results of earlier checks might contain the word
+    const bool added = m_bgSpellCheck->addWordToPersonal(word);
+    m_bgSpellCheck->clearCheckedTexts();
+
     KoTextBlockData blockData(block);
     blockData.setMarkupsLayoutValidity(KoTextBlockData::Misspell, false);
     checkSection(m_document, block.position(), block.position() + block.length() - 1);
     // TODO we should probably recheck the entire document so other occurrences are also removed, but then again we should recheck every document (footer,header etc) not sure how to do this
-    return m_bgSpellCheck->addWordToPersonal(word);
+    return added;
 }
 
 
@@ -239,9 +261,29 @@ class MyThread : public QThread { public: static void mySleep(unsigned long msec
 static_cast<MyThread*>(QThread::currentThread())->mySleep(400);
 #endif
 
-    QTextBlock block = m_activeSection.document->findBlock(startPosition);
-    KoTextBlockData blockData(block);
-    blockData.appendMarkup(KoTextBlockData::Misspell, startPosition - block.position(), startPosition - block.position() + word.trimmed().length());
+    // the markups are added in one go when the run is finished
+    m_misspellings.append(qMakePair(startPosition, startPosition + word.trimmed().length()));
+}
+
+void SpellCheck::applyMisspellings()
+{
+    if (m_activeSection.document.isNull()) {
+        m_misspellings.clear();
+        return;
+    }
+
+    // misspellings are found in document order, so most of them are in the same block as the previous one
+    QTextBlock block;
+    foreach (const QPair<int, int> &misspelling, m_misspellings) {
+        if (!block.isValid() || !block.contains(misspelling.first)) {
+            block = m_activeSection.document->findBlock(misspelling.first);
+            if (!block.isValid())
+                continue;
+        }
+        KoTextBlockData blockData(block);
+        blockData.appendMarkup(KoTextBlockData::Misspell, misspelling.first - block.position(), misspelling.second - block.position());
+    }
+    m_misspellings.clear();
 }
 
 void SpellCheck::documentChanged(int from, int charsRemoved, int charsAdded)
@@ -250,6 +292,10 @@ void SpellCheck::documentChanged(int from, int charsRemoved, int charsAdded)
     if (document == 0)
         return;
 
+    // the markups found so far still use the positions from before the change
+    if (document == m_activeSection.document)
+        applyMisspellings();
+
     // If a simple edit, we use the cursor position to determine where
     // the change occured. This makes it possible to handle cases
     // where formatting of a block has changed, eg. when dropcaps is used.
@@ -325,6 +371,7 @@ void SpellCheck::finishedRun()
 {
     Q_ASSERT(QThread::currentThread() == QApplication::instance()->thread());
     m_isChecking = false;
+    applyMisspellings();
 
     KoTextDocumentLayout *lay = qobject_cast<KoTextDocumentLayout*>(m_activeSection.document->documentLayout());
     lay->provider()->updateAll();
@@ -32,6 +32,7 @@
 #include <QQueue>
 #include <QTextLayout>
 #include <QTextStream>
+#include <QVector>
 
 class QTextDocument;
 class QTextStream;
@@ -89,6 +90,8 @@ private Q_SLOTS:
     void documentChanged(int from, int charsRemoved, int charsAdded);
 
 private:
+    void applyMisspellings();
+
     Sonnet::Speller m_speller;
     QPointer<QTextDocument> m_document;
     QString m_word;
@@ -111,6 +114,7 @@ private:
     QTextStream stream;
     SpellCheckMenu *m_spellCheckMenu;
     SpellSections m_activeSection; // the section we are currently doing a run on;
+    QVector<QPair<int, int> > m_misspellings; // found in the active section, not yet added as markup
     bool m_simpleEdit; //set when user is doing a simple edit, meaning we should not start spellchecking
     int m_cursorPosition; // simple edit cursor position
 };
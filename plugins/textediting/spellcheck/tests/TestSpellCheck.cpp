@@ -9,6 +9,7 @@
 #include <QTextCursor>
 #include <QTextCharFormat>
 
+#include <QSignalSpy>
 #include <QTest>
 
 class MySpellCheck : public BgSpellCheck
@@ -21,6 +22,12 @@ public:
     QString publicFetchMoreText() {
         return fetchMoreText();
     }
+    void publicFinishedCurrentFeed() {
+        finishedCurrentFeed();
+    }
+    void publicMisspelling(const QString &word, int start) {
+        emit misspelling(word, start);
+    }
     virtual void start() { }
 };
 
@@ -94,4 +101,44 @@ void TestSpellCheck::testFetchMoreText2()
     QCOMPARE(checker.publicFetchMoreText(), QString("Mostly Empty Parags."));
 }
 
+void TestSpellCheck::testCheckedTexts()
+{
+    MySpellCheck checker;
+    QSignalSpy spy(&checker, SIGNAL(misspelledWord(QString,int,bool)));
+    QTextDocument doc;
+    doc.setPlainText("some simple text\na second parag with more text\nsome simple text");
+    QTextBlock block = doc.begin();
+
+    checker.startRun(&doc, 0, doc.characterCount() - 1);
+    QCOMPARE(checker.publicFetchMoreText(), block.text());
+    checker.publicFinishedCurrentFeed();
+    QCOMPARE(checker.publicFetchMoreText(), block.next().text());
+    checker.publicMisspelling("parag", 9);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(1).toInt(), block.next().position() + 9);
+    checker.publicFinishedCurrentFeed();
+    QVERIFY(checker.publicFetchMoreText().isNull());
+
+    // all words were checked, the cached misspelling is reported without passing text to sonnet
+    spy.clear();
+    checker.startRun(&doc, 0, doc.characterCount() - 1);
+    QVERIFY(checker.publicFetchMoreText().isNull());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toString(), QString("parag"));
+    QCOMPARE(spy.at(0).at(1).toInt(), block.next().position() + 9);
+
+    // only the changed word is checked again
+    QTextCursor cursor(&doc);
+    cursor.setPosition(5);
+    cursor.setPosition(11, QTextCursor::KeepAnchor);
+    cursor.insertText("simpel");
+    checker.startRun(&doc, 0, block.length() - 1);
+    QCOMPARE(checker.publicFetchMoreText(), QString("     simpel     "));
+    checker.publicFinishedCurrentFeed();
+
+    checker.clearCheckedTexts();
+    checker.startRun(&doc, 0, doc.characterCount() - 1);
+    QCOMPARE(checker.publicFetchMoreText(), block.text());
+}
+
 QTEST_MAIN(TestSpellCheck)
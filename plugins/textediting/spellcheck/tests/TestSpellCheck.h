@@ -12,6 +12,7 @@ public:
 private Q_SLOTS:
     void testFetchMoreText();
     void testFetchMoreText2();
+    void testCheckedTexts();
 };
 
 #endif
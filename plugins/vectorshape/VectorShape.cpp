@@ -31,6 +31,7 @@
 #include <QPen>
 #include <QPainter>
 #include <QBuffer>
+#include <QCache>
 #include <QDataStream>
 #include <QMutexLocker>
 #include <QThreadPool>
@@ -65,15 +66,87 @@
 // Comment out to get unthreaded painting, which is good for debugging
 //#define VECTORSHAPE_PAINT_UNTHREADED
 
+// Memory budgets of the caches shared by all vector shapes
+#define MAX_DISPLAY_LIST_CACHE_SIZE (32*1024*1024)
+#define MAX_IMAGE_CACHE_SIZE (64*1024*1024)
+
+namespace {
+
+/**
+ * The parsed display lists and the rendered images of all vector shapes.
+ *
+ * Both are keyed by the contents, so shapes showing the same metafile parse
+ * it only once and share the rendered images. Display lists are kept as the
+ * raw QPicture data because playing a shared QPicture is not thread safe.
+ * The render threads access the caches too, hence the mutex.
+ */
+class VectorShapeCache
+{
+public:
+    VectorShapeCache()
+    {
+        displayLists.setMaxCost(MAX_DISPLAY_LIST_CACHE_SIZE);
+        images.setMaxCost(MAX_IMAGE_CACHE_SIZE);
+    }
+
+    QByteArray displayList(const QByteArray &key)
+    {
+        QMutexLocker locker(&mutex);
+        QByteArray *data = displayLists.object(key);
+        return data ? *data : QByteArray();
+    }
+
+    void insertDisplayList(const QByteArray &key, const QByteArray &data)
+    {
+        QMutexLocker locker(&mutex);
+        displayLists.insert(key, new QByteArray(data), data.size());
+    }
+
+    QImage image(const QByteArray &key)
+    {
+        QMutexLocker locker(&mutex);
+        QImage *image = images.object(key);
+        return image ? *image : QImage();
+    }
+
+    void insertImage(const QByteArray &key, const QImage &image)
+    {
+        QMutexLocker locker(&mutex);
+        images.insert(key, new QImage(image), image.byteCount());
+    }
+
+private:
+    QMutex mutex;
+    QCache<QByteArray, QByteArray> displayLists;
+    QCache<QByteArray, QImage> images;
+};
+
+Q_GLOBAL_STATIC(VectorShapeCache, s_cache)
+
+// The backends lay out the contents for the shape size, so the display
+// list depends on it in addition to the contents.
+QByteArray displayListKey(const QByteArray &contentKey, const QSizeF &size)
+{
+    return contentKey + QByteArray::number(size.width()) + 'x' + QByteArray::number(size.height());
+}
+
+QByteArray imageKey(const QByteArray &contentKey, const QSizeF &size, const QSize &boundingSize)
+{
+    return displayListKey(contentKey, size) + '@'
+        + QByteArray::number(boundingSize.width()) + 'x' + QByteArray::number(boundingSize.height());
+}
+
+}
+
 VectorShape::VectorShape()
     : KoFrameShape( KoXmlNS::draw, "image" )
     , m_type(VectorTypeNone)
+    , m_contentKey(contentKey(QByteArray()))
     , m_isRendering(false)
 {
     setShapeId(VectorShape_SHAPEID);
     // Default size of the shape.
     KoShape::setSize( QSizeF( CM_TO_POINT( 8 ), CM_TO_POINT( 5 ) ) );
-    m_cache.setMaxCost(3);
 }
 
 VectorShape::~VectorShape()
@@ -101,18 +174,26 @@ void VectorShape::setCompressedContents(const QByteArray &newContents, VectorTyp
 
     m_contents = newContents;
     m_type = vectorType;
-    m_cache.clear();
+    m_contentKey = contentKey(m_contents);
     update();
 }
 
+QByteArray VectorShape::contentKey(const QByteArray &compressedContents)
+{
+    // the size makes shapes with different contents of the same hash unlikely to collide
+    return QByteArray::number(qHash(compressedContents)) + '-' + QByteArray::number(compressedContents.size());
+}
+
 // ----------------------------------------------------------------
 //                             Painting
 
-RenderThread::RenderThread(const QByteArray &contents, VectorShape::VectorType type,
-                           const QSizeF &size, const QSize &boundingSize, qreal zoomX, qreal zoomY)
+RenderThread::RenderThread(const QByteArray &compressedContents, const QByteArray &contentKey,
+                           VectorShape::VectorType type, const QSizeF &size, const QSize &boundingSize,
+                           qreal zoomX, qreal zoomY, bool useCache)
     : QObject(), QRunnable(),
-      m_contents(contents), m_type(type),
-      m_size(size), m_boundingSize(boundingSize), m_zoomX(zoomX), m_zoomY(zoomY)
+      m_compressedContents(compressedContents), m_contentKey(contentKey), m_type(type),
+      m_size(size), m_boundingSize(boundingSize), m_zoomX(zoomX), m_zoomY(zoomY),
+      m_useCache(useCache)
 {
     setAutoDelete(true);
 }
@@ -123,19 +204,62 @@ RenderThread::~RenderThread()
 
 void RenderThread::run()
 {
-    QImage *image = new QImage(m_boundingSize, QImage::Format_ARGB32);
-    image->fill(0);
+    const QPicture picture = displayList();
+
+    m_image = QImage(m_boundingSize, QImage::Format_ARGB32);
+    m_image.fill(0);
     QPainter painter;
-    if (!painter.begin(image)) {
+    if (!painter.begin(&m_image)) {
         warnVector << "Failed to create image-cache";
-        delete image;
-        image = 0;
+        m_image = QImage();
     } else {
         painter.scale(m_zoomX, m_zoomY);
-        draw(painter);
+        painter.drawPicture(0, 0, picture);
         painter.end();
+        if (m_useCache) {
+            s_cache->insertImage(imageKey(m_contentKey, m_size, m_boundingSize), m_image);
+        }
+    }
+    emit finished(imageKey(m_contentKey, m_size, m_boundingSize), m_image);
+}
+
+QImage RenderThread::image() const
+{
+    return m_image;
+}
+
+QPicture RenderThread::displayList()
+{
+    const QByteArray key = displayListKey(m_contentKey, m_size);
+    QPicture picture;
+
+    const QByteArray data = m_useCache ? s_cache->displayList(key) : QByteArray();
+    if (!data.isEmpty()) {
+        // setData() copies, so each thread plays its own picture
+        picture.setData(data.constData(), data.size());
+        return picture;
+    }
+
+    // Only a cache miss pays for decompressing and parsing the metafile.
+    if (m_type != VectorShape::VectorTypeNone) {
+        m_contents = qUncompress(m_compressedContents);
+    }
+    // The WMF and EMF backends lay out text with the font metrics of the painter's
+    // device, which is the picture here. QPicture and the QImage it is played on
+    // both use the default resolution, so the text is laid out as if it was drawn
+    // on the image directly.
+    QPainter painter;
+    if (!painter.begin(&picture)) {
+        warnVector << "Failed to record the display list";
+        return picture;
     }
-    emit finished(m_boundingSize, image);
+    draw(painter);
+    painter.end();
+
+    if (m_useCache && picture.size() > 0) {
+        s_cache->insertDisplayList(key, QByteArray(picture.data(), picture.size()));
+    }
+    return picture;
 }
 
 void RenderThread::draw(QPainter &painter)
@@ -249,22 +373,20 @@ void VectorShape::paint(QPainter &painter, const KoViewConverter &converter, KoS
     bool asynchronous = QFontDatabase::supportsThreadedFontRendering();
 #endif
 
-    QImage *cache = render(converter, asynchronous, useCache);
-    if (cache) { // paint cached image
-        Q_ASSERT(!cache->isNull());
+    const QImage cache = render(converter, asynchronous, useCache);
+    if (!cache.isNull()) { // paint cached image
         QVector<QRect> clipRects = painter.clipRegion().rects();
         foreach (const QRect &rc, clipRects) {
-            painter.drawImage(rc.topLeft(), *cache, rc);
+            painter.drawImage(rc.topLeft(), cache, rc);
         }
     }
 }
 
-void VectorShape::renderFinished(const QSize &boundingSize, QImage *image)
+void VectorShape::renderFinished(const QByteArray &imageKey, const QImage &image)
 {
-    if (image) {
-        m_cache.insert(boundingSize.height(), image);
-        update();
-    }
+    m_image = image;
+    m_imageKey = imageKey;
+    update();
     m_isRendering = false;
 }
 
@@ -369,6 +491,7 @@ bool VectorShape::loadOdfFrameElement(const KoXmlElement & element,
 
     // Compress for biiiig memory savings.
     m_contents = qCompress(m_contents);
+    m_contentKey = contentKey(m_contents);
 
     return true;
 }
@@ -378,28 +501,35 @@ void VectorShape::waitUntilReady(const KoViewConverter &converter, bool asynchro
     render(converter, asynchronous, true);
 }
 
-QImage* VectorShape::render(const KoViewConverter &converter, bool asynchronous, bool useCache) const
+QImage VectorShape::render(const KoViewConverter &converter, bool asynchronous, bool useCache) const
 {
     QRectF rect = converter.documentToView(boundingRect());
-    int id = rect.size().toSize().height();
-    QImage *cache = useCache ? m_cache[id] : 0;
+    const QSize boundingSize = rect.size().toSize();
+    const QByteArray key = imageKey(m_contentKey, size(), boundingSize);
+    if (useCache && key == m_imageKey && !m_image.isNull()) {
+        return m_image;
+    }
+    // another shape with the same contents may have rendered it already
+    QImage cache = useCache ? s_cache->image(key) : QImage();
+    if (!cache.isNull()) {
+        m_image = cache;
+        m_imageKey = key;
+    }
 
-    if (!cache || cache->isNull()) { // recreate the cached image
-        cache = 0;
+    if (cache.isNull()) { // recreate the cached image
         if (!m_isRendering) {
             m_isRendering = true;
             qreal zoomX, zoomY;
             converter.zoom(&zoomX, &zoomY);
             QMutexLocker locker(&m_mutex);
-            const QByteArray uncompressedContents =
-                m_type != VectorShape::VectorTypeNone ? qUncompress(m_contents) : QByteArray();
-            RenderThread *t = new RenderThread(uncompressedContents, m_type, size(), rect.size().toSize(), zoomX, zoomY);
-            connect(t, SIGNAL(finished(QSize,QImage*)), this, SLOT(renderFinished(QSize,QImage*)));
+            RenderThread *t = new RenderThread(m_contents, m_contentKey, m_type, size(), boundingSize, zoomX, zoomY, useCache);
+            connect(t, SIGNAL(finished(QByteArray,QImage)), this, SLOT(renderFinished(QByteArray,QImage)));
             if (asynchronous) { // render and paint the image threaded
                 QThreadPool::globalInstance()->start(t);
             } else { // non-threaded rendering and painting of the image
                 t->run();
-                cache = m_cache[id];
+                cache = t->image();
+                delete t;
             }
         }
     }
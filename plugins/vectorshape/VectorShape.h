@@ -26,7 +26,8 @@
 
 // Qt
 #include <QByteArray>
-#include <QCache>
+#include <QImage>
+#include <QPicture>
 #include <QSize>
 #include <QRunnable>
 #include <QMutex>
@@ -82,7 +83,7 @@ public:
     static VectorShape::VectorType vectorType(const QByteArray &contents);
 
 private Q_SLOTS:
-    void renderFinished(const QSize &boundingSize, QImage *image);
+    void renderFinished(const QByteArray &imageKey, const QImage &image);
 
 private:
     static bool isWmf(const QByteArray &bytes);
@@ -93,11 +94,16 @@ private:
     // Member variables
     mutable VectorType  m_type;
     mutable QByteArray  m_contents;
+    /// identifies the contents in the display list and image caches shared by all vector shapes
+    QByteArray m_contentKey;
     mutable bool m_isRendering;
     mutable QMutex m_mutex;
-    QCache<int, QImage> m_cache;
+    /// the image painted last, the shared cache may have dropped it already
+    mutable QImage m_image;
+    mutable QByteArray m_imageKey;
 
-    QImage* render(const KoViewConverter &converter, bool asynchronous, bool useCache) const;
+    static QByteArray contentKey(const QByteArray &compressedContents);
+    QImage render(const KoViewConverter &converter, bool asynchronous, bool useCache) const;
 };
 
 
@@ -105,13 +111,18 @@ class RenderThread : public QObject, public QRunnable
 {
     Q_OBJECT
 public:
-    RenderThread(const QByteArray &contents, VectorShape::VectorType type,
-                 const QSizeF &size, const QSize &boundingSize, qreal zoomX, qreal zoomY);
+    RenderThread(const QByteArray &compressedContents, const QByteArray &contentKey, VectorShape::VectorType type,
+                 const QSizeF &size, const QSize &boundingSize, qreal zoomX, qreal zoomY, bool useCache);
     virtual ~RenderThread();
     virtual void run();
+
+    /// the rendered image, valid after run() returned
+    QImage image() const;
 Q_SIGNALS:
-    void finished(const QSize &boundingSize, QImage *image);
+    void finished(const QByteArray &imageKey, const QImage &image);
 private:
+    /// Parses the contents once into a display list which can be replayed at any zoom
+    QPicture displayList();
     void draw(QPainter &painter);
     void drawNull(QPainter &painter) const;
     void drawWmf(QPainter &painter) const;
@@ -119,11 +130,15 @@ private:
     void drawSvm(QPainter &painter) const;
     void drawSvg(QPainter &painter) const;
 private:
-    const QByteArray m_contents;
+    const QByteArray m_compressedContents;
+    const QByteArray m_contentKey;
+    QByteArray m_contents;
     VectorShape::VectorType m_type;
     QSizeF m_size;
     QSize m_boundingSize;
     qreal m_zoomX, m_zoomY;
+    bool m_useCache;
+    QImage m_image;
 };
 
 #endif
@@ -0,0 +1,199 @@
+/* This file is part of the KDE project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "TestVectorShape.h"
+
+#include "VectorShape.h"
+
+#include <KoUnit.h>
+
+#include "WmfPainterBackend.h"
+#include "EmfParser.h"
+#include "EmfOutputPainterStrategy.h"
+#include "SvmParser.h"
+#include "SvmPainterBackend.h"
+
+#include <QFile>
+#include <QFontMetrics>
+#include <QImage>
+#include <QPainter>
+#include <QPicture>
+#include <QSvgRenderer>
+#include <QTest>
+
+#include <math.h>
+
+static const char svgContents[] =
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"200\" height=\"100\">"
+    "<rect x=\"10\" y=\"10\" width=\"120\" height=\"60\" fill=\"#4080c0\" stroke=\"black\" stroke-width=\"3\"/>"
+    "<circle cx=\"150\" cy=\"50\" r=\"35\" fill=\"none\" stroke=\"#c04000\" stroke-width=\"5\"/>"
+    "<text x=\"20\" y=\"90\" font-family=\"Sans\" font-size=\"14\">Vector shape</text>"
+    "</svg>";
+
+/**
+ * Draws @p contents directly on an image scaled by @p zoom, the way
+ * the vector shape rendered before it recorded display lists.
+ */
+static QImage referenceRender(const QByteArray &contents, VectorShape::VectorType type,
+                              const QSizeF &size, const QSize &boundingSize, qreal zoom)
+{
+    QImage image(boundingSize, QImage::Format_ARGB32);
+    image.fill(0);
+    QPainter painter(&image);
+    painter.scale(zoom, zoom);
+
+    QSize shapeSizeInt(size.width(), size.height());
+
+    switch (type) {
+    case VectorShape::VectorTypeWmf: {
+        Libwmf::WmfPainterBackend wmfPainter(&painter, size);
+        if (wmfPainter.load(contents)) {
+            painter.save();
+            wmfPainter.play();
+            painter.restore();
+        }
+        break;
+    }
+    case VectorShape::VectorTypeEmf: {
+        Libemf::Parser emfParser;
+        Libemf::OutputPainterStrategy emfPaintOutput(painter, shapeSizeInt, true);
+        emfParser.setOutput(&emfPaintOutput);
+        emfParser.load(contents);
+        break;
+    }
+    case VectorShape::VectorTypeSvm: {
+        Libsvm::SvmParser svmParser;
+        Libsvm::SvmPainterBackend svmPaintOutput(&painter, shapeSizeInt);
+        svmParser.setBackend(&svmPaintOutput);
+        svmParser.parse(contents);
+        break;
+    }
+    case VectorShape::VectorTypeSvg: {
+        QSvgRenderer renderer(contents);
+        renderer.render(&painter, QRectF(0, 0, size.width(), size.height()));
+        break;
+    }
+    default:
+        break;
+    }
+    painter.end();
+
+    return image;
+}
+
+static QImage render(const QByteArray &contents, VectorShape::VectorType type,
+                     const QSizeF &size, const QSize &boundingSize, qreal zoom, bool useCache)
+{
+    RenderThread thread(qCompress(contents), QByteArray(QTest::currentDataTag()),
+                        type, size, boundingSize, zoom, zoom, useCache);
+    thread.run();
+    return thread.image();
+}
+
+static void compareImages(const QImage &image, const QImage &expected)
+{
+    QCOMPARE(image.size(), expected.size());
+
+    // allow for the rounding of the coordinates, which are transformed in another order
+    for (int y = 0; y < expected.height(); ++y) {
+        for (int x = 0; x < expected.width(); ++x) {
+            const QRgb pixel = image.pixel(x, y);
+            const QRgb expectedPixel = expected.pixel(x, y);
+            const bool equal = qAbs(qRed(pixel) - qRed(expectedPixel)) <= 1
+                && qAbs(qGreen(pixel) - qGreen(expectedPixel)) <= 1
+                && qAbs(qBlue(pixel) - qBlue(expectedPixel)) <= 1
+                && qAbs(qAlpha(pixel) - qAlpha(expectedPixel)) <= 1;
+            QVERIFY2(equal, qPrintable(QString("pixel (%1, %2): %3 != %4")
+                                       .arg(x).arg(y).arg(pixel, 8, 16).arg(expectedPixel, 8, 16)));
+        }
+    }
+}
+
+void TestVectorShape::testTextMetrics()
+{
+    // the backends measure text on the picture, the result is played on an image
+    QPicture picture;
+    QImage image(10, 10, QImage::Format_ARGB32);
+    QCOMPARE(picture.logicalDpiX(), image.logicalDpiX());
+    QCOMPARE(picture.logicalDpiY(), image.logicalDpiY());
+
+    QFont font("Arial");
+    font.setPixelSize(37);
+    QFontMetrics pictureMetrics(font, &picture);
+    QFontMetrics imageMetrics(font, &image);
+    QCOMPARE(pictureMetrics.width("Brad Hards"), imageMetrics.width("Brad Hards"));
+    QCOMPARE(pictureMetrics.ascent(), imageMetrics.ascent());
+    QCOMPARE(pictureMetrics.descent(), imageMetrics.descent());
+    QCOMPARE(pictureMetrics.height(), imageMetrics.height());
+
+    font.setPointSizeF(10.5);
+    pictureMetrics = QFontMetrics(font, &picture);
+    imageMetrics = QFontMetrics(font, &image);
+    QCOMPARE(pictureMetrics.width("Brad Hards"), imageMetrics.width("Brad Hards"));
+    QCOMPARE(pictureMetrics.height(), imageMetrics.height());
+}
+
+void TestVectorShape::testReplay_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<int>("type");
+    QTest::addColumn<qreal>("zoom");
+
+    const QList<qreal> zooms = QList<qreal>() << 1.0 << 0.37 << 2.5;
+    foreach (qreal zoom, zooms) {
+        const QString suffix = QString(" zoom %1").arg(zoom);
+        // contains text laid out by the backend
+        QTest::newRow(qPrintable("wmf text" + suffix)) << "cof.wmf" << int(VectorShape::VectorTypeWmf) << zoom;
+        QTest::newRow(qPrintable("emf text" + suffix)) << "pyemf-fontbackground.emf" << int(VectorShape::VectorTypeEmf) << zoom;
+        QTest::newRow(qPrintable("emf" + suffix)) << "pyemf-drawing1.emf" << int(VectorShape::VectorTypeEmf) << zoom;
+        QTest::newRow(qPrintable("svm text" + suffix)) << "hello_world.svm" << int(VectorShape::VectorTypeSvm) << zoom;
+        QTest::newRow(qPrintable("svm" + suffix)) << "circles.svm" << int(VectorShape::VectorTypeSvm) << zoom;
+        QTest::newRow(qPrintable("svg" + suffix)) << QString() << int(VectorShape::VectorTypeSvg) << zoom;
+    }
+}
+
+void TestVectorShape::testReplay()
+{
+    QFETCH(QString, fileName);
+    QFETCH(int, type);
+    QFETCH(qreal, zoom);
+
+    QByteArray contents(svgContents);
+    if (!fileName.isEmpty()) {
+        QFile file(QString(FILES_DATA_DIR) + fileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        contents = file.readAll();
+    }
+    QCOMPARE(int(VectorShape::vectorType(contents)), type);
+
+    // the default size of a vector shape, which is not a whole number of points
+    const QSizeF size(CM_TO_POINT(8), CM_TO_POINT(5));
+    const QSize boundingSize(ceil(size.width() * zoom), ceil(size.height() * zoom));
+    const VectorShape::VectorType vectorType = VectorShape::VectorType(type);
+
+    const QImage expected = referenceRender(contents, vectorType, size, boundingSize, zoom);
+
+    // recorded and played once
+    compareImages(render(contents, vectorType, size, boundingSize, zoom, false), expected);
+
+    // recorded into the shared cache, then played from a copy of the cached display list
+    compareImages(render(contents, vectorType, size, boundingSize, zoom, true), expected);
+    compareImages(render(contents, vectorType, size, boundingSize, zoom, true), expected);
+}
+
+QTEST_MAIN(TestVectorShape)
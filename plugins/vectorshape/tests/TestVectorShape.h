@@ -0,0 +1,37 @@
+/* This file is part of the KDE project
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef TESTVECTORSHAPE_H
+#define TESTVECTORSHAPE_H
+
+#include <QObject>
+
+/**
+ * Compares the images rendered from the recorded display lists with
+ * drawing the contents directly, as the vector shape did before.
+ */
+class TestVectorShape : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testTextMetrics();
+    void testReplay_data();
+    void testReplay();
+};
+
+#endif // TESTVECTORSHAPE_H
@@ -31,6 +31,7 @@
 #include <KoShapeManager.h>
 #include <KoShapeManagerPaintingStrategy.h>
 #include <KoShapePaintingContext.h>
+#include <KoShapePainter.h>
 #include <KoViewConverter.h>
 #include <KoPAViewMode.h>
 #include <KoPACanvas.h>
@@ -48,6 +49,7 @@
 #include "KPrShapeManagerAnimationStrategy.h"
 #include "KPrShapeManagerDisplayMasterStrategy.h"
 #include "KPrPageSelectStrategyActive.h"
+#include "KPrPageSelectStrategyFixed.h"
 #include "pageeffects/KPrPageEffectRunner.h"
 #include "pageeffects/KPrPageEffect.h"
 #include "KPrShapeAnimations.h"
@@ -55,6 +57,11 @@
 
 #include "animations/KPrAnimationCache.h"
 
+// number of upcoming pages that are rendered in advance
+static const int PrerenderedPages = 2;
+// time in ms to wait before rendering in the background
+static const int PrerenderDelay = 100;
+
 KPrAnimationDirector::KPrAnimationDirector( KoPAView * view, KoPACanvas * canvas, const QList<KoPAPageBase*> & pages, KoPAPageBase* currentPage )
 : m_view( view )
 , m_canvas( canvas )
@@ -67,6 +74,8 @@ KPrAnimationDirector::KPrAnimationDirector( KoPAView * view, KoPACanvas * canvas
 {
     Q_ASSERT( !m_pages.empty() );
     m_animationCache = new KPrAnimationCache();
+    m_prerenderTimer.setSingleShot( true );
+    connect( &m_prerenderTimer, SIGNAL(timeout()), this, SLOT(prerenderPage()) );
     if( !currentPage || !pages.contains(currentPage))
         updateActivePage( m_pages[0] );
     else
@@ -130,6 +139,11 @@ void KPrAnimationDirector::paint(QPainter& painter, const QRectF &paintRect)
             }
         }
     }
+    else if ( !m_firstPaint.isNull() ) {
+        // the page was rendered in advance
+        painter.drawPixmap( paintRect, m_firstPaint, paintRect );
+        m_firstPaint = QPixmap();
+    }
     else {
         QRect clipRect = m_pageRect.intersected( paintRect.toRect() );
         painter.setClipRect( clipRect );
@@ -238,6 +252,7 @@ void KPrAnimationDirector::navigateToPage( int index )
     updateActivePage( page );
     updatePageAnimation();
     updateStepAnimation();
+    m_firstPaint = takePrerenderedPage( m_pageIndex );
     // trigger a repaint
     m_canvas->update();
 
@@ -345,6 +360,7 @@ bool KPrAnimationDirector::changePage( Navigation navigation )
     updateActivePage( m_pages[m_pageIndex] );
     updatePageAnimation();
     updateStepAnimation();
+    m_firstPaint = takePrerenderedPage( m_pageIndex );
 
     // trigger a repaint
     m_canvas->update();
@@ -366,6 +382,8 @@ void KPrAnimationDirector::updateZoom( const QSize & size )
     // reinit page animation, because somi init method contain zoom
     updatePageAnimation();
     updateStepAnimation();
+
+    schedulePrerendering();
 }
 
 void KPrAnimationDirector::paintStep( QPainter & painter )
@@ -422,12 +440,15 @@ bool KPrAnimationDirector::nextStep()
             updateActivePage( m_pages[m_pageIndex] );
             updatePageAnimation();
             updateStepAnimation();
-            QPixmap newPage( m_canvas->size() );
-            newPage.fill( Qt::white ); // TODO
-            QPainter newPainter( &newPage );
-            newPainter.setClipRect( m_pageRect );
-            newPainter.setRenderHint( QPainter::Antialiasing );
-            paintStep( newPainter );
+            QPixmap newPage = takePrerenderedPage( m_pageIndex );
+            if ( newPage.isNull() ) {
+                newPage = QPixmap( m_canvas->size() );
+                newPage.fill( Qt::white ); // TODO
+                QPainter newPainter( &newPage );
+                newPainter.setClipRect( m_pageRect );
+                newPainter.setRenderHint( QPainter::Antialiasing );
+                paintStep( newPainter );
+            }
 
             m_pageEffectRunner = new KPrPageEffectRunner( oldPage, newPage, m_canvas, effect );
             startTimeLine( effect->duration() );
@@ -436,6 +457,7 @@ bool KPrAnimationDirector::nextStep()
             updateActivePage( m_pages[m_pageIndex] );
             updatePageAnimation();
             updateStepAnimation();
+            m_firstPaint = takePrerenderedPage( m_pageIndex );
             m_canvas->update();
             if ( hasAnimation() ) {
                 startTimeLine( m_animations.at(m_stepIndex)->totalDuration() );
@@ -461,6 +483,7 @@ void KPrAnimationDirector::previousStep()
                 m_stepIndex = m_animations.size();
             }
             updatePageAnimation();
+            m_firstPaint = QPixmap();
             // trigger repaint
             m_canvas->update();
             // cancel a running page effect
@@ -487,6 +510,7 @@ void KPrAnimationDirector::animate()
         // set current time, to the current step
         m_animationCache->next();
         m_animations.at(m_stepIndex)->setCurrentTime(m_timeLine.currentTime());
+        m_firstPaint = QPixmap();
         m_canvas->update();
     }
 }
@@ -494,6 +518,7 @@ void KPrAnimationDirector::animate()
 void KPrAnimationDirector::finishAnimations()
 {
     m_animationCache->endStep(m_stepIndex);
+    m_firstPaint = QPixmap();
     m_canvas->update();
 }
 
@@ -515,3 +540,100 @@ void KPrAnimationDirector::deactivate()
         step->deactivate();
     }
 }
+
+void KPrAnimationDirector::schedulePrerendering()
+{
+    m_prerenderTimer.start( PrerenderDelay );
+}
+
+void KPrAnimationDirector::prerenderPage()
+{
+    // drop pages that are no longer upcoming or that were rendered for another size
+    QMap<int, QPixmap>::iterator it( m_prerenderedPages.begin() );
+    while ( it != m_prerenderedPages.end() ) {
+        if ( it.key() <= m_pageIndex || it.key() > m_pageIndex + PrerenderedPages || it.value().size() != m_canvas->size() ) {
+            it = m_prerenderedPages.erase( it );
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // don't disturb running effects and animations
+    if ( m_pageEffectRunner || m_timeLine.state() == QTimeLine::Running ) {
+        m_prerenderTimer.start( PrerenderDelay );
+        return;
+    }
+
+    const int lastPage = qMin( m_pageIndex + PrerenderedPages, m_pages.size() - 1 );
+    for ( int i = m_pageIndex + 1; i <= lastPage; ++i ) {
+        // a page shown twice in a row shares its animations with the active page
+        if ( !m_prerenderedPages.contains( i ) && m_pages[i] != m_view->activePage() ) {
+            m_prerenderedPages.insert( i, renderPage( dynamic_cast<KPrPage *>( m_pages[i] ), m_canvas->size() ) );
+            // render the next page after pending events are handled
+            m_prerenderTimer.start( 0 );
+            return;
+        }
+    }
+}
+
+QPixmap KPrAnimationDirector::renderPage( KPrPage *page, const QSize &size )
+{
+    Q_ASSERT( page );
+
+    KoPageLayout pageLayout = page->pageLayout();
+    KoZoomHandler zoomHandler;
+    KoPAUtil::setZoom( pageLayout, size, zoomHandler );
+    const QRect pageRect( KoPAUtil::pageRect( pageLayout, size, zoomHandler ) );
+
+    // set up the state of the shapes at the start of the first step
+    KPrAnimationCache animationCache;
+    animationCache.setPageSize( page->size() );
+    qreal zoom;
+    zoomHandler.zoom( &zoom, &zoom );
+    animationCache.setZoom( zoom );
+    const QList<KPrAnimationStep *> steps = page->animations().steps();
+    int i = 0;
+    foreach ( KPrAnimationStep *step, steps ) {
+        step->init( &animationCache, i );
+        i++;
+    }
+    animationCache.startStep( 0 );
+
+    QPixmap pixmap( size );
+    pixmap.fill( Qt::white );
+    QPainter painter( &pixmap );
+    if ( pageRect != pixmap.rect() ) {
+        painter.fillRect( pixmap.rect(), Qt::black );
+    }
+    painter.setClipRect( pageRect );
+    painter.setRenderHint( QPainter::Antialiasing );
+    painter.translate( pageRect.topLeft() );
+
+    KoShapePaintingContext context;
+    page->paintBackground( painter, zoomHandler, context );
+
+    KoShapePainter shapePainter( new KPrShapeManagerAnimationStrategy( 0, &animationCache, new KPrPageSelectStrategyFixed( page ) ) );
+    if ( page->displayMasterShapes() ) {
+        shapePainter.setShapes( page->masterPage()->shapes() );
+        shapePainter.paint( painter, zoomHandler );
+    }
+    shapePainter.setShapes( page->shapes() );
+    shapePainter.paint( painter, zoomHandler );
+
+    // init() made the text blocks of the page paint with the local cache
+    foreach ( KPrAnimationStep *step, steps ) {
+        step->deactivate();
+    }
+
+    return pixmap;
+}
+
+QPixmap KPrAnimationDirector::takePrerenderedPage( int pageIndex )
+{
+    QPixmap pixmap = m_prerenderedPages.take( pageIndex );
+    if ( pixmap.size() != m_canvas->size() ) {
+        return QPixmap();
+    }
+    return pixmap;
+}
@@ -22,12 +22,16 @@
 #define KPRANIMATIONDIRECTOR_H
 
 #include <QList>
+#include <QMap>
 #include <QObject>
 #include <QPair>
+#include <QPixmap>
 #include <QTimeLine>
+#include <QTimer>
 #include <QTransform>
 #include <KoZoomHandler.h>
 #include "KPrShapeAnimations.h"
+#include "stage_export.h"
 
 class QPainter;
 class QPaintEvent;
@@ -41,7 +45,7 @@ class KPrPageEffectRunner;
 class KPrPage;
 class KPrShapeAnimation;
 
-class KPrAnimationDirector : public QObject
+class STAGE_EXPORT KPrAnimationDirector : public QObject
 {
     Q_OBJECT
 public:
@@ -58,6 +62,14 @@ public:
     KPrAnimationDirector( KoPAView * view, KoPACanvas * canvas, const QList<KoPAPageBase*> & pages, KoPAPageBase* currentPage );
     virtual ~KPrAnimationDirector();
 
+    /**
+     * Render the page as it is shown before its first step into a pixmap of the given size
+     *
+     * The animations of the page are reset afterwards, so nothing refers to the animation
+     * cache used for rendering when the pixmap is returned.
+     */
+    static QPixmap renderPage( KPrPage *page, const QSize &size );
+
     void paint(QPainter& painter, const QRectF &paintRect);
     void paintEvent( QPaintEvent* event );
 
@@ -142,11 +154,25 @@ protected:
     void updatePageAnimation();
     void updateStepAnimation();
 
+    /**
+     * Start rendering the upcoming pages in the background once the presentation is idle
+     */
+    void schedulePrerendering();
+
+    /**
+     * Take the prerendered pixmap of the page with the given index out of the cache
+     *
+     * @return the pixmap or a null pixmap if the page is not prerendered for the current size
+     */
+    QPixmap takePrerenderedPage( int pageIndex );
+
 protected Q_SLOTS:
     // update the zoom value
     void updateZoom( const QSize & size );
     // acts on the time line event
     void animate();
+    // render the next not yet prerendered upcoming page
+    void prerenderPage();
 
 private:
     KoPAView * m_view;
@@ -166,6 +192,12 @@ private:
     // true when there is an animtion in this step
     bool m_hasAnimation;
     KPrAnimationCache * m_animationCache;
+
+    QTimer m_prerenderTimer;
+    // maps the page index to the page rendered before its first step
+    QMap<int, QPixmap> m_prerenderedPages;
+    // the prerendered current page to be used for the next paint
+    QPixmap m_firstPaint;
 };
 
 #endif /* KPRANIMATIONDIRECTOR_H */
@@ -28,6 +28,7 @@
 //Calligra headers
 #include <KoPADocument.h>
 #include <KoPAPageBase.h>
+#include <KoPAThumbnailService.h>
 #include <KoPAViewBase.h>
 #include <KoPAView.h>
 #include <KoPAOdfPageSaveHelper.h>
@@ -60,6 +61,7 @@ void KPrSlidesSorterDocumentModel::setDocument(KoPADocument *document)
         connect(m_document, SIGNAL(pageAdded(KoPAPageBase*)), this, SLOT(update()));
         connect(m_document, SIGNAL(pageRemoved(KoPAPageBase*)), this, SLOT(update()));
         connect(m_document, SIGNAL(update(KoPAPageBase*)), this, SLOT(update()));
+        connect(m_document->thumbnailService(), SIGNAL(thumbnailReady(KoPAPageBase*)), this, SLOT(thumbnailReady(KoPAPageBase*)));
     }
 
     reset();
@@ -104,7 +106,9 @@ QVariant KPrSlidesSorterDocumentModel::data(const QModelIndex &index, int role)
         }
         case Qt::DecorationRole:
         {
-            return QIcon(page->thumbnail(m_viewModeSlidesSorter->iconSize()));
+            // the thumbnail is painted later if it is not available yet
+            QPixmap thumbnail = m_document->thumbnailService()->thumbnail(page, m_viewModeSlidesSorter->iconSize());
+            return thumbnail.isNull() ? QVariant() : QIcon(thumbnail);
         }
         case Qt::EditRole:
         {
@@ -228,6 +232,15 @@ void KPrSlidesSorterDocumentModel::update()
     emit layoutChanged();
 }
 
+void KPrSlidesSorterDocumentModel::thumbnailReady(KoPAPageBase *page)
+{
+    const int row = m_document->pages(false).indexOf(page);
+    if (row >= 0) {
+        QModelIndex changed = index(row, 0, QModelIndex());
+        emit dataChanged(changed, changed);
+    }
+}
+
 bool KPrSlidesSorterDocumentModel::dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent)
 {
     if (action == Qt::IgnoreAction) {
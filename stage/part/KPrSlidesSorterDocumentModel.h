@@ -126,6 +126,10 @@ public Q_SLOTS:
     /** emit signals indicating a change in the model layout or items */
     void update();
 
+private Q_SLOTS:
+    /** emit a signal indicating the decoration of the page changed */
+    void thumbnailReady(KoPAPageBase *page);
+
 private:
     //A reference to current document
     KoPADocument *m_document;
@@ -0,0 +1,56 @@
+#include "TestPrerenderPage.h"
+
+#include "KPrAnimationDirector.h"
+#include "KPrDocument.h"
+#include "KPrPage.h"
+#include "KoPAMasterPage.h"
+#include "PAMock.h"
+#include "MockShapeAnimation.h"
+#include "../animations/KPrAnimationStep.h"
+#include "../animations/KPrAnimationSubStep.h"
+
+#include <KoTextBlockData.h>
+#include <KoTextBlockPaintStrategyBase.h>
+#include <MockShapes.h>
+
+#include <QImage>
+#include <QPainter>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QTest>
+
+void TestPrerenderPage::paintAfterPrerender()
+{
+    // a page with an animated paragraph as shown by the next slide of a presentation
+    QTextDocument textDocument;
+    textDocument.setPlainText("animated paragraph");
+    QTextBlock block = textDocument.begin();
+    KoTextBlockData blockData(block);
+    MockShape shape;
+
+    MockDocument doc;
+    KoPAMasterPage *master = new KoPAMasterPage();
+    doc.insertPage(master, 0);
+    KPrPage *page = new KPrPage(master, &doc);
+    doc.insertPage(page, 0);
+
+    MockShapeAnimation *animation = new MockShapeAnimation(&shape, block.userData());
+    KPrAnimationSubStep *subStep = new KPrAnimationSubStep();
+    subStep->addAnimation(animation);
+    KPrAnimationStep *step = new KPrAnimationStep();
+    step->addAnimation(subStep);
+    page->animations().init(QList<KPrAnimationStep *>() << step);
+
+    QPixmap pixmap = KPrAnimationDirector::renderPage(page, QSize(160, 120));
+    QCOMPARE(pixmap.size(), QSize(160, 120));
+
+    // the cache used for rendering is gone, painting the paragraph after the show must not use it
+    KoTextBlockPaintStrategyBase *paintStrategy = blockData.paintStrategy();
+    QVERIFY(paintStrategy);
+    QVERIFY(paintStrategy->isVisible());
+    QImage image(10, 10, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    paintStrategy->applyStrategy(&painter);
+}
+
+QTEST_MAIN(TestPrerenderPage)
@@ -0,0 +1,13 @@
+#ifndef TESTPRERENDERPAGE_H
+#define TESTPRERENDERPAGE_H
+
+#include <QObject>
+
+class TestPrerenderPage: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void paintAfterPrerender();
+};
+
+#endif // TESTPRERENDERPAGE_H
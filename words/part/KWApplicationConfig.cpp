@@ -19,6 +19,7 @@
 
 #include "KWApplicationConfig.h"
 #include "KWDocument.h"
+#include "KWPageCacheManager.h"
 
 #include <KoUnit.h>
 #include <KoGlobal.h>
@@ -45,7 +46,8 @@ KWApplicationConfig::KWApplicationConfig()
         m_zoom(100),
         m_zoomMode(KoZoomMode::ZOOM_WIDTH),
         m_autoSaveSeconds(KoDocument::defaultAutoSave()),
-        m_defaultColumnSpacing(MM_TO_POINT(6))
+        m_defaultColumnSpacing(MM_TO_POINT(6)),
+        m_pageCacheSize(64)
 {
 }
 
@@ -84,6 +86,9 @@ void KWApplicationConfig::load(KWDocument *document)
     m_statusBarShowZoom = interface.readEntry("StatusBarShowZoom", m_statusBarShowZoom);
     m_statusBarShowWordCount = interface.readEntry("StatusBarShowWordCount", m_statusBarShowWordCount);
 
+    m_pageCacheSize = qMax(0, interface.readEntry("PageCacheSize", m_pageCacheSize));
+    KWPageCacheManager::setCacheSize(m_pageCacheSize);
+
 //    m_bShowDocStruct = interface.readEntry("showDocStruct", true);
 //    m_viewModeType = interface.readEntry("viewmode", "ModeNormal");
 //    setShowStatusBarShow(interface.readEntry("ShowStatusBarShow" , true));
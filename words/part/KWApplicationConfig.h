@@ -183,6 +183,15 @@ public:
         return m_defaultColumnSpacing;
     }
 
+    /**
+     * Return the memory in MiB the canvases may use to cache rendered pages, read from
+     * the PageCacheSize entry of the Interface group. All canvases share this budget,
+     * 0 disables the page cache.
+     */
+    int pageCacheSize() const {
+        return m_pageCacheSize;
+    }
+
     void setUnit(const KoUnit &unit);
 
 private:
@@ -203,6 +212,7 @@ private:
 
     int m_autoSaveSeconds;
     qreal m_defaultColumnSpacing;
+    int m_pageCacheSize;
 
     Q_DISABLE_COPY(KWApplicationConfig)
 };
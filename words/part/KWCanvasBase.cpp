@@ -46,6 +46,7 @@
 
 // Qt
 #include <QBrush>
+#include <QElapsedTimer>
 #include <QPainter>
 #include <QPainterPath>
 #include <QThread>
@@ -54,6 +55,11 @@
 
 //#define DEBUG_REPAINT
 
+// Time in ms a paint event may spend rendering pages into the cache. What is
+// left is rendered in the following paint events, so input is handled while
+// newly exposed pages are rendered.
+static const int MAX_CACHE_PAINT_TIME = 30;
+
 
 KWCanvasBase::KWCanvasBase(KWDocument *document, QObject *parent)
     : KoCanvasBase(document),
@@ -70,7 +76,7 @@ KWCanvasBase::KWCanvasBase(KWDocument *document, QObject *parent)
 {
     m_shapeManager = new KoShapeManager(this);
     m_toolProxy = new KoToolProxy(this, parent);
-    //setCacheEnabled(true);
+    setCacheEnabled(document->config().pageCacheSize() > 0);
 }
 
 KWCanvasBase::~KWCanvasBase()
@@ -303,6 +309,12 @@ void KWCanvasBase::paint(QPainter &painter, const QRectF &paintRect)
                         m_viewMode->mapExposedRects(paintRect.translated(m_documentOffset),
                                                     viewConverter());
 
+                QElapsedTimer paintTime;
+                paintTime.start();
+                bool paintedCache = false;
+                // the parts of the canvas still showing outdated or blank pages
+                QRegion pendingRegion;
+
                 foreach (KWViewMode::ViewMap vm, map) {
 
                     painter.save();
@@ -322,18 +334,21 @@ void KWCanvasBase::paint(QPainter &painter, const QRectF &paintRect)
                     // Paint the contents of the page.
                     painter.setRenderHint(QPainter::Antialiasing);
 
-                    // clear the cache if the zoom changed
-                    qreal zoom = viewConverter()->zoom();
-                    if (m_currentZoom != zoom) {
-                        m_pageCacheManager->clear();
-                        m_currentZoom = zoom;
-                    }
+                    m_currentZoom = viewConverter()->zoom();
 
                     KWPageCache *pageCache = m_pageCacheManager->take(vm.page);
-
-                    if (!pageCache) {
-                        pageCache = m_pageCacheManager->cache(QSize(viewConverter()->documentToViewX(vm.page.width()),
-                                                                    viewConverter()->documentToViewY(vm.page.height())));
+                    const QSize pageCacheSize(viewConverter()->documentToViewX(vm.page.width()),
+                                              viewConverter()->documentToViewY(vm.page.height()));
+
+                    if (!pageCache || pageCache->m_size != pageCacheSize) {
+                        KWPageCache *staleCache = pageCache;
+                        pageCache = m_pageCacheManager->cache(pageCacheSize);
+                        if (staleCache) {
+                            // the page was cached at another zoom level, show it scaled
+                            // until the page is painted again
+                            pageCache->fillFrom(staleCache);
+                            delete staleCache;
+                        }
                     }
 
                     Q_ASSERT(!pageCache->cache.isEmpty());
@@ -392,7 +407,14 @@ void KWCanvasBase::paint(QPainter &painter, const QRectF &paintRect)
 
                             QRect rc = exposed.at(i);
 
-                            if (rc.intersects(clipRectOnPage.toRect())) {
+                            if (rc.intersects(clipRectOnPage.toRect())
+                                    && paintedCache && paintTime.elapsed() > MAX_CACHE_PAINT_TIME) {
+                                // out of time, paint it in the next paint event
+                                pendingRegion += rc.translated(QPointF(pageRectView.x(), pageTopView).toPoint()
+                                                               + vm.distance.toPoint() - m_documentOffset);
+                                remainingUnExposed << rc;
+                            }
+                            else if (rc.intersects(clipRectOnPage.toRect())) {
                                 paintRegion += rc;
                                 int tilex = 0, tiley = 0;
                                 for (int x = 0, i = 0; x < pageCache->m_tilesx; ++x) {
@@ -430,6 +452,7 @@ void KWCanvasBase::paint(QPainter &painter, const QRectF &paintRect)
                             tilePainter.translate(-r.left(), -pageTopView - r.top());
                             tilePainter.setRenderHint(QPainter::Antialiasing);
                             shapeManager()->paint(tilePainter, *viewConverter(), false);
+                            paintedCache = true;
 
                             int tilex = 0, tiley = 0;
                             for (int x = 0, i = 0; x < pageCache->m_tilesx; ++x) {
@@ -484,6 +507,10 @@ void KWCanvasBase::paint(QPainter &painter, const QRectF &paintRect)
                         pageContentArea = contentArea;
                     }
                 }
+
+                if (!pendingRegion.isEmpty()) {
+                    updateCanvasInternal(pendingRegion.boundingRect());
+                }
 #if 0
             }
             else { // we cache at 100%, but paint at the actual zoom level
@@ -675,13 +702,12 @@ void KWCanvasBase::updateCanvas(const QRectF &rc)
                 if (!m_pageCacheManager) {
                     // no pageCacheManager, so create one for the current view. This happens only once!
                     // so on zoom change, we don't re-pre-generate weight/zoom images.
-                    m_pageCacheManager = new KWPageCacheManager(m_cacheSize);
+                    m_pageCacheManager = new KWPageCacheManager();
                 }
 
-                if (m_currentZoom != viewConverter()->zoom()) {
-                    m_currentZoom = viewConverter()->zoom();
-                    m_pageCacheManager->clear();
-                }
+                // pages cached at another zoom level are kept, paint() shows
+                // them scaled until they are painted again
+                m_currentZoom = viewConverter()->zoom();
 
                 KWPageCache *pageCache = m_pageCacheManager->take(vm.page);
                 if (pageCache) {
@@ -741,7 +767,7 @@ void KWCanvasBase::updateCanvas(const QRectF &rc)
                 if (!m_pageCacheManager) {
                     // no pageCacheManager, so create one for the current view. This happens only once!
                     // so on zoom change, we don't re-pre-generate weight/zoom images.
-                    m_pageCacheManager = new KWPageCacheManager(m_cacheSize);
+                    m_pageCacheManager = new KWPageCacheManager();
                 }
 
                 if (m_currentZoom != 1.0) {
@@ -782,14 +808,12 @@ KoViewConverter *KWCanvasBase::viewConverter() const
     return m_viewConverter;
 }
 
-void KWCanvasBase::setCacheEnabled(bool enabled, int cacheSize, qreal maxZoom)
+void KWCanvasBase::setCacheEnabled(bool enabled, qreal maxZoom)
 {
-    if ((!m_pageCacheManager && enabled) || (m_cacheSize != cacheSize)) {
-        delete m_pageCacheManager;
-        m_pageCacheManager = new KWPageCacheManager(cacheSize);
+    if (!m_pageCacheManager && enabled) {
+        m_pageCacheManager = new KWPageCacheManager();
     }
     m_cacheEnabled = enabled;
-    m_cacheSize = cacheSize;
     m_maxZoom = maxZoom;
 }
 
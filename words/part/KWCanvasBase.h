@@ -91,18 +91,19 @@ public: // KoCanvasBase interface methods.
     virtual void ensureVisible(const QRectF &rect);
 
     /**
-     * Enable or disable the page cache. The cache stores the rendered pages. It is
-     * emptied when the zoomlevel changes.
+     * Enable or disable the page cache. The cache stores the rendered pages. When
+     * the zoomlevel changes the old pages are shown scaled until they are rendered
+     * again. Pages are rendered over several paint events, so newly exposed pages
+     * do not block the user interface.
      *
      * @param enabled: if true, we cache the contents of the document for this canvas,
-     *  for the current zoomlevel
-     * @param cachesize: the maximum size for the cache. The cache will throw away
-     *  pages once this size is reached. Depending on Qt's implementation of QCache, the
-     *  unit is pages.
+     *  for the current zoomlevel. The pages of all canvases share the memory budget
+     *  of KWApplicationConfig::pageCacheSize(), the least recently used pages are
+     *  thrown away once it is reached.
      * @param maxZoom above this zoomlevel we'll paint a scaled version of the cache, instead
      *  of creating a new cache
      */
-    virtual void setCacheEnabled(bool enabled, int cacheSize = 50, qreal maxZoom = 2.0);
+    virtual void setCacheEnabled(bool enabled, qreal maxZoom = 2.0);
 
     /**
      * return whether annotatins are shown in the canvas.
@@ -151,7 +152,6 @@ protected:
     qreal m_currentZoom;
     qreal m_maxZoom; //< above this zoomlevel we scale the cached image, instead of recreating the cache.
     KWPageCacheManager *m_pageCacheManager;
-    int m_cacheSize;
 
 };
 
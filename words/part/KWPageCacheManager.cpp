@@ -20,9 +20,40 @@
 
 #include "KWPageCacheManager.h"
 
+#include <QCache>
 #include <QImage>
+#include <QPainter>
 
 static const int MAX_TILE_SIZE = 1024;
+// the budget in MiB until KWApplicationConfig sets the configured one
+static const int DEFAULT_CACHE_SIZE = 64;
+
+namespace {
+
+struct PageCacheKey
+{
+    PageCacheKey(const KWPageCacheManager *manager, const KWPage &page)
+        : manager(manager), page(page) {}
+
+    bool operator==(const PageCacheKey &other) const
+    {
+        return manager == other.manager && page == other.page;
+    }
+
+    const KWPageCacheManager *manager;
+    KWPage page;
+};
+
+inline uint qHash(const PageCacheKey &key)
+{
+    return ::qHash(key.page) ^ ::qHash(key.manager);
+}
+
+// the pages of all canvases share one budget
+typedef QCache<PageCacheKey, KWPageCache> PageCache;
+Q_GLOBAL_STATIC_WITH_ARGS(PageCache, s_pageCache, (DEFAULT_CACHE_SIZE * 1024 * 1024))
+
+}
 
 /*
 KWPageCache::KWPageCache(KWPageCacheManager *manager, QImage *img)
@@ -50,6 +81,10 @@ KWPageCache::KWPageCache(KWPageCacheManager *manager, int w, int h)
     } else {
         cache.push_back(QImage(w, h, QImage::Format_RGB16));
     }
+    // parts of the page may be shown before they are painted
+    for (int i = 0; i < cache.size(); ++i) {
+        cache[i].fill(0xffff);
+    }
 }
 
 
@@ -57,8 +92,55 @@ KWPageCache::~KWPageCache()
 {
 }
 
-KWPageCacheManager::KWPageCacheManager(int cacheSize)
-    : m_cache(cacheSize)
+void KWPageCache::fillFrom(const KWPageCache *other)
+{
+    if (other->m_size.isEmpty())
+        return;
+
+    const qreal scaleX = qreal(m_size.width()) / other->m_size.width();
+    const qreal scaleY = qreal(m_size.height()) / other->m_size.height();
+
+    int tilex = 0, tiley = 0;
+    for (int x = 0, i = 0; x < m_tilesx; ++x) {
+        int dx = cache[i].width();
+        for (int y = 0; y < m_tilesy; ++y, ++i) {
+            QImage &tileImg = cache[i];
+            QPainter gc(&tileImg);
+            gc.setRenderHint(QPainter::SmoothPixmapTransform);
+            gc.translate(-tilex, -tiley);
+            gc.scale(scaleX, scaleY);
+            const QRectF tile(tilex / scaleX, tiley / scaleY, tileImg.width() / scaleX, tileImg.height() / scaleY);
+
+            int otherx = 0, othery = 0;
+            for (int ox = 0, j = 0; ox < other->m_tilesx; ++ox) {
+                int odx = other->cache[j].width();
+                for (int oy = 0; oy < other->m_tilesy; ++oy, ++j) {
+                    const QImage &otherImg = other->cache[j];
+                    if (tile.intersects(QRectF(otherx, othery, otherImg.width(), otherImg.height()))) {
+                        gc.drawImage(QPointF(otherx, othery), otherImg);
+                    }
+                    othery += otherImg.height();
+                }
+                otherx += odx;
+                othery = 0;
+            }
+            tiley += tileImg.height();
+        }
+        tilex += dx;
+        tiley = 0;
+    }
+}
+
+int KWPageCache::byteCount() const
+{
+    int bytes = 0;
+    foreach (const QImage &tile, cache) {
+        bytes += tile.byteCount();
+    }
+    return bytes;
+}
+
+KWPageCacheManager::KWPageCacheManager()
 {
 }
 
@@ -69,18 +151,13 @@ KWPageCacheManager::~KWPageCacheManager()
 
 KWPageCache *KWPageCacheManager::take(const KWPage &page)
 {
-    KWPageCache *cache = 0;
-    if (m_cache.contains(page)) {
-        cache = m_cache.take(page);
-    }
-    return cache;
+    return s_pageCache->take(PageCacheKey(this, page));
 }
 
 void KWPageCacheManager::insert(const KWPage &page, KWPageCache *cache)
 {
-    QSize size = cache->m_size;
     // make sure always at least two pages can be cached
-    m_cache.insert(page, cache, qMin(m_cache.maxCost() / 2, size.width() * size.height()));
+    s_pageCache->insert(PageCacheKey(this, page), cache, qMin(s_pageCache->maxCost() / 2, cache->byteCount()));
 }
 
 KWPageCache *KWPageCacheManager::cache(const QSize &size)
@@ -92,8 +169,20 @@ KWPageCache *KWPageCacheManager::cache(const QSize &size)
     return cache;
 }
 
+void KWPageCacheManager::setCacheSize(int megabytes)
+{
+    s_pageCache->setMaxCost(megabytes * 1024 * 1024);
+}
+
 void KWPageCacheManager::clear()
 {
-    m_cache.clear();
+    if (s_pageCache.isDestroyed())
+        return;
+
+    foreach (const PageCacheKey &key, s_pageCache->keys()) {
+        if (key.manager == this) {
+            s_pageCache->remove(key);
+        }
+    }
 }
 
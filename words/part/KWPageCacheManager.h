@@ -22,8 +22,8 @@
 
 #include "KWPage.h"
 // Qt
-#include <QCache>
 #include <QImage>
+#include <QVector>
 
 class QSize;
 
@@ -41,6 +41,15 @@ public:
     KWPageCache(KWPageCacheManager *manager, int w, int h);
     ~KWPageCache();
 
+    /**
+     * Paints a scaled copy of @p other, the cache of the same page at another
+     * zoom level, into the tiles. It is shown until the page is painted again.
+     */
+    void fillFrom(const KWPageCache *other);
+
+    /// @return the memory used by the tiles in bytes
+    int byteCount() const;
+
     KWPageCacheManager* m_manager;
     QVector<QImage> cache;
     int m_tilesx, m_tilesy;
@@ -53,11 +62,17 @@ public:
     bool allExposed;
 };
 
+/**
+ * Keeps the rendered pages of a canvas.
+ *
+ * The pages of all managers share one cache, so the memory budget holds for
+ * all open views together.
+ */
 class KWPageCacheManager {
 
 public:
 
-    explicit KWPageCacheManager(int cacheSize);
+    KWPageCacheManager();
 
     ~KWPageCacheManager();
 
@@ -69,8 +84,13 @@ public:
 
     void clear();
 
+    /**
+     * Set the memory budget in MiB of the cache shared by all page cache managers.
+     * This is a user setting, see KWApplicationConfig::pageCacheSize().
+     */
+    static void setCacheSize(int megabytes);
+
 private:
-    QCache<KWPage, KWPageCache> m_cache;
     friend class KWPageCache;
 };
 
@@ -0,0 +1,87 @@
+#include "TestPageCache.h"
+
+#include <KWPageCacheManager.h>
+#include <KWPageManager.h>
+#include <KWPage.h>
+
+#include <QtTest>
+
+void TestPageCache::testTiles()
+{
+    KWPageCacheManager manager;
+    KWPageCache *cache = manager.cache(QSize(1500, 800));
+    QCOMPARE(cache->m_tilesx, 2);
+    QCOMPARE(cache->m_tilesy, 1);
+    QCOMPARE(cache->cache.count(), 2);
+    QCOMPARE(cache->byteCount(), 1500 * 800 * 2);
+    // a page that is not painted yet shows up white
+    QCOMPARE(cache->cache.at(1).pixel(0, 0), qRgb(255, 255, 255));
+    delete cache;
+}
+
+void TestPageCache::testFillFrom()
+{
+    KWPageCacheManager manager;
+    KWPageCache *small = manager.cache(QSize(100, 100));
+    small->cache[0].fill(Qt::red);
+
+    KWPageCache *large = manager.cache(QSize(1500, 1500));
+    QCOMPARE(large->cache.count(), 4);
+    large->fillFrom(small);
+    foreach (const QImage &tile, large->cache) {
+        QCOMPARE(tile.pixel(tile.width() / 2, tile.height() / 2), qRgb(255, 0, 0));
+    }
+    // the scaled copy is only shown until the page is painted again
+    QVERIFY(large->allExposed);
+    delete small;
+    delete large;
+}
+
+void TestPageCache::testSharedBudget()
+{
+    KWPageManager pageManager;
+    KWPage page1 = pageManager.appendPage();
+    KWPage page2 = pageManager.appendPage();
+
+    // 500x500 pages use 500000 bytes each, so two of them fit into 1 MiB
+    KWPageCacheManager::setCacheSize(1);
+    KWPageCacheManager manager1;
+    KWPageCacheManager manager2;
+    manager1.insert(page1, manager1.cache(QSize(500, 500)));
+    manager2.insert(page1, manager2.cache(QSize(500, 500)));
+
+    KWPageCache *cache = manager1.take(page1);
+    QVERIFY(cache);
+    manager1.insert(page1, cache);
+
+    // the page used least recently is dropped, whichever canvas it belongs to
+    manager2.insert(page2, manager2.cache(QSize(500, 500)));
+    cache = manager2.take(page1);
+    QVERIFY(!cache);
+    cache = manager1.take(page1);
+    QVERIFY(cache);
+    delete cache;
+    cache = manager2.take(page2);
+    QVERIFY(cache);
+    delete cache;
+    KWPageCacheManager::setCacheSize(10);
+}
+
+void TestPageCache::testClear()
+{
+    KWPageManager pageManager;
+    KWPage page1 = pageManager.appendPage();
+
+    KWPageCacheManager manager1;
+    KWPageCacheManager manager2;
+    manager1.insert(page1, manager1.cache(QSize(100, 100)));
+    manager2.insert(page1, manager2.cache(QSize(100, 100)));
+
+    manager1.clear();
+    QVERIFY(!manager1.take(page1));
+    KWPageCache *cache = manager2.take(page1);
+    QVERIFY(cache);
+    delete cache;
+}
+
+QTEST_MAIN(TestPageCache)
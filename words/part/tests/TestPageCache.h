@@ -0,0 +1,16 @@
+#ifndef TESTPAGECACHE_H
+#define TESTPAGECACHE_H
+
+#include <QObject>
+
+class TestPageCache : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS: // tests
+    void testTiles();
+    void testFillFrom();
+    void testSharedBudget();
+    void testClear();
+};
+
+#endif